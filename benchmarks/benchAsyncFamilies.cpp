@@ -0,0 +1,93 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html               -/
+ ********************************************************/
+
+/*! \file benchAsyncFamilies.cpp
+ *  \author Joey Dumont <joey.dumont@gmail.com>
+ *  \since 2026-10-18
+ *  \brief Compares synchronous and overlapped computations of large families.
+ *  \copyright LGPL
+ * A service computes large 3j families (l = 5 10^4) while it handles other requests,
+ * here small 6j families. Synchronously, each large family blocks the
+ * requests that follow it. Asynchronously, the large families are
+ * submitted to a pool and the requests are handled while they run. We
+ * report the total time, the large families per second, and the longest
+ * time a request waited.
+ */
+
+#include <wignerSymbols.h>
+
+#include <chrono>
+#include <iomanip>
+#include <thread>
+
+using namespace WignerSymbols;
+
+typedef std::chrono::steady_clock Clock;
+
+static double seconds(Clock::time_point t0)
+{
+  return std::chrono::duration<double>(Clock::now()-t0).count();
+}
+
+int main()
+{
+  const double l = 50000.0;
+  const int families = 16, requestsPerFamily = 200;
+  const std::size_t size = 2*(std::size_t)l+1;
+  std::vector<std::vector<double> > buffers(families,std::vector<double>(size));
+  double checksum = 0.0;
+
+  auto request = [&checksum](int r)
+  {
+    std::vector<double> v = wigner6j(10+r%5,12,11,9+r%3,13,SchultenGordonScaled);
+    checksum += v[0];
+  };
+
+  // Synchronous: each large family blocks the requests behind it.
+  double longestSync = 0.0;
+  Clock::time_point t0 = Clock::now();
+  for (int f=0;f<families;f++)
+  {
+    Clock::time_point t1 = Clock::now();
+    std::vector<double> v = wigner3j(l,l,0.0,(double)f,-(double)f,SchultenGordonScaled);
+    std::copy(v.begin(),v.end(),buffers[f].begin());
+    longestSync = std::max(longestSync,seconds(t1));
+    for (int r=0;r<requestsPerFamily;r++) request(r);
+  }
+  double sync = seconds(t0);
+
+  std::cout << std::setw(10) << "mode" << std::setw(12) << "time (s)" << std::setw(14) << "families/s"
+            << std::setw(18) << "longest wait (ms)" << std::endl;
+  std::cout << std::setprecision(3) << std::setw(10) << "sync" << std::setw(12) << sync
+            << std::setw(14) << families/sync << std::setw(18) << 1.0e3*longestSync << std::endl;
+
+  unsigned int counts[] = {1, 2, std::max(1u,std::thread::hardware_concurrency())};
+  for (unsigned int n : counts)
+  {
+    FamilyJobPool pool(n);
+    double longest = 0.0;
+    t0 = Clock::now();
+    std::vector<FamilyJob> jobs;
+    for (int f=0;f<families;f++)
+      jobs.push_back(pool.wigner3j(l,l,0.0,(double)f,-(double)f,buffers[f].data(),size));
+    for (int f=0;f<families;f++)
+      for (int r=0;r<requestsPerFamily;r++)
+      {
+        Clock::time_point t1 = Clock::now();
+        request(r);
+        longest = std::max(longest,seconds(t1));
+      }
+    for (int f=0;f<families;f++) jobs[f].wait();
+    double async = seconds(t0);
+    std::cout << std::setw(8) << "async " << std::setw(2) << n << std::setw(12) << async
+              << std::setw(14) << families/async << std::setw(18) << 1.0e3*longest << std::endl;
+  }
+
+  for (int f=0;f<families;f++) checksum += buffers[f][size/2];
+  if (checksum != checksum) std::cout << "NaN in the families" << std::endl;
+  return 0;
+}
@@ -0,0 +1,85 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html               -/
+ ********************************************************/
+
+/*! \file benchBispectrum.cpp
+ *  \author Joey Dumont <joey.dumont@gmail.com>
+ *  \since 2026-10-18
+ *  \brief Measures the throughput of the batched bispectrum.
+ *  \copyright LGPL
+ * We report the environments contracted per second with scalar calls to
+ * clebschGordan(), and with bispectrum() on 1 to 8 threads. The time spent
+ * building the plan is reported separately.
+ */
+
+#include <wignerSymbols.h>
+
+#include <chrono>
+#include <iomanip>
+#include <random>
+
+typedef std::chrono::steady_clock Clock;
+
+int main()
+{
+  int lmaxs[] = {4, 6, 8};
+  const std::size_t count = 1 << 14;
+
+  std::cout << WignerSymbols::instructionSetName(WignerSymbols::activeInstructionSet()) << " kernels, environments/s" << std::endl;
+  std::cout << std::setw(6) << "lmax" << std::setw(8) << "desc" << std::setw(12) << "plan (s)" << std::setw(12) << "scalar";
+  for (unsigned int t=1;t<=8;t*=2) std::cout << std::setw(8) << t << " thr";
+  std::cout << std::endl;
+
+  std::mt19937 rng(11);
+  std::uniform_real_distribution<double> uniform(-1.0,1.0);
+
+  for (int s=0;s<3;s++)
+  {
+    int lmax = lmaxs[s];
+    Clock::time_point t0 = Clock::now();
+    WignerSymbols::BispectrumPlan plan = WignerSymbols::bispectrumPlan(lmax);
+    double tplan = std::chrono::duration<double>(Clock::now()-t0).count();
+
+    std::size_t ncoef = plan.coefficients();
+    std::vector<std::complex<double> > c(count*ncoef);
+    for (std::size_t i=0;i<c.size();i++)
+      c[i] = std::complex<double>(uniform(rng),uniform(rng));
+
+    // Scalar Clebsch-Gordan coefficients, on a few environments.
+    const std::size_t few = 8;
+    double checksum = 0.0;
+    Clock::time_point t1 = Clock::now();
+    for (std::size_t e=0;e<few;e++)
+      for (std::size_t t=0;t<plan.size();t++)
+      {
+        int l1 = plan.l1[t], l2 = plan.l2[t], l = plan.l[t];
+        const std::complex<double>* ce = &c[e*ncoef];
+        std::complex<double> sum = 0.0;
+        for (int m1=-l1;m1<=l1;m1++)
+          for (int m2=std::max(-l2,-l-m1);m2<=std::min(l2,l-m1);m2++)
+            sum += WignerSymbols::clebschGordan(l1,l2,l,m1,m2,m1+m2)
+                   *ce[l1*l1+l1+m1]*ce[l2*l2+l2+m2]*std::conj(ce[l*l+l+m1+m2]);
+        checksum += sum.real();
+      }
+    double tscalar = std::chrono::duration<double>(Clock::now()-t1).count();
+
+    std::cout << std::setw(6) << lmax << std::setw(8) << plan.size()
+              << std::setw(12) << std::setprecision(3) << tplan
+              << std::setw(12) << std::setprecision(3) << few/tscalar;
+
+    std::vector<double> descriptors(count*plan.size());
+    for (unsigned int t=1;t<=8;t*=2)
+    {
+      Clock::time_point t2 = Clock::now();
+      WignerSymbols::bispectrum(plan,count,&c[0],&descriptors[0],t);
+      std::cout << std::setw(12) << std::setprecision(3) << count/std::chrono::duration<double>(Clock::now()-t2).count();
+    }
+    std::cout << std::endl;
+    if (checksum != checksum) std::cout << "NaN in the scalar sums" << std::endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,61 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html               -/
+ ********************************************************/
+
+/*! \file benchClosedForms.cpp
+ *  \author Joey Dumont <joey.dumont@gmail.com>
+ *  \since 2026-10-18
+ *  \brief Measures the latency of the closed forms for small l2.
+ *  \copyright LGPL
+ * For each l2 <= 2, we time a single symbol with the default entry point,
+ * which uses the closed form, with the general recursion, and with the
+ * Fortran implementation.
+ */
+
+#include <wignerSymbols.h>
+
+#include <chrono>
+#include <iomanip>
+
+typedef std::chrono::steady_clock Clock;
+
+int main()
+{
+  const int calls = 20000;
+  double l3s[] = {10.0, 1000.0};
+
+  std::cout << std::setw(6) << "l2" << std::setw(8) << "l3"
+            << std::setw(16) << "closed (ns)" << std::setw(16) << "recursion (ns)"
+            << std::setw(16) << "Fortran (ns)" << std::endl;
+
+  double sink = 0.0;
+  for (size_t n=0;n<sizeof(l3s)/sizeof(l3s[0]);n++)
+    for (double l2=0.0;l2<=WignerSymbols::closedFormMaxL2;l2+=0.5)
+    {
+      double l3 = l3s[n], m2 = l2-std::floor(l2), m3 = -std::floor(0.3*l3), m1 = -m2-m3;
+      double l1 = l3+l2-std::floor(l2);
+
+      Clock::time_point t0 = Clock::now();
+      for (int k=0;k<calls;k++)
+        sink += WignerSymbols::wigner3j(l1,l2,l3,m1,m2,m3);
+      Clock::time_point t1 = Clock::now();
+      double l1min = std::max(std::fabs(l2-l3),std::fabs(m1));
+      for (int k=0;k<calls;k++)
+        sink += WignerSymbols::wigner3j(l2,l3,m1,m2,m3,WignerSymbols::SchultenGordonScaled)[(int)(l1-l1min)];
+      Clock::time_point t2 = Clock::now();
+      for (int k=0;k<calls;k++)
+        sink += WignerSymbols::wigner3j_f(l1,l2,l3,m1,m2,m3);
+      Clock::time_point t3 = Clock::now();
+
+      std::cout << std::setw(6) << l2 << std::setw(8) << l3
+                << std::setw(16) << std::setprecision(4) << std::chrono::duration<double>(t1-t0).count()/calls*1.0e9
+                << std::setw(16) << std::setprecision(4) << std::chrono::duration<double>(t2-t1).count()/calls*1.0e9
+                << std::setw(16) << std::setprecision(4) << std::chrono::duration<double>(t3-t2).count()/calls*1.0e9
+                << std::endl;
+    }
+
+  return (sink == 0.123 ? 1 : 0);
+}
@@ -0,0 +1,86 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html               -/
+ ********************************************************/
+
+/*! \file benchFamilyWalker.cpp
+ *  \author Joey Dumont <joey.dumont@gmail.com>
+ *  \since 2026-10-18
+ *  \brief Compares full sweeps over the projections with and without the walker.
+ *  \copyright LGPL
+ * For l2 = l3 = l and a given m1, we compute the families of the whole
+ * diagonal m2+m3 = -m1, first with one wigner3j() per family, then with a
+ * Wigner3jWalker. We report the times, the fraction of steps that
+ * recomputed the families, and the largest error of the walker against
+ * wigner3j() over every tenth family.
+ */
+
+#include <wignerSymbols.h>
+
+#include <chrono>
+#include <iomanip>
+
+using namespace WignerSymbols;
+
+typedef std::chrono::steady_clock Clock;
+
+static double seconds(Clock::time_point t0)
+{
+  return std::chrono::duration<double>(Clock::now()-t0).count();
+}
+
+int main()
+{
+  int ls[] = {50, 200, 1000, 3000};
+  double checksum = 0.0;
+
+  std::cout << std::setw(6) << "l" << std::setw(6) << "m1" << std::setw(14) << "wigner3j (s)"
+            << std::setw(12) << "walker (s)" << std::setw(10) << "speedup" << std::setw(10) << "reseeds"
+            << std::setw(12) << "max error" << std::endl;
+  for (int s=0;s<4;s++)
+  {
+    double l = ls[s];
+    double m1s[] = {0.0, std::floor(l/4)};
+    for (int j=0;j<2;j++)
+    {
+      double m1 = m1s[j];
+      double m2start = l-m1, m3start = -l;
+
+      Clock::time_point t0 = Clock::now();
+      for (double m2=m2start;m2>=-l && -m1-m2<=l;m2--)
+        checksum += wigner3j(l,l,m1,m2,-m1-m2,SchultenGordonScaled)[0];
+      double direct = seconds(t0);
+
+      t0 = Clock::now();
+      Wigner3jWalker w = wigner3jWalker(l,l,m2start,m3start);
+      do checksum += w.values[0]; while (step(w));
+      double walked = seconds(t0);
+
+      // Accuracy, on every tenth family.
+      double worst = 0.0;
+      Wigner3jWalker v = wigner3jWalker(l,l,m2start,m3start);
+      do
+      {
+        if (v.steps%10 != 0) continue;
+        std::vector<double> expected = wigner3j(l,l,v.m1,v.m2,v.m3,SchultenGordonScaled);
+        double scale = 0.0, error = 0.0;
+        for (std::size_t i=0;i<expected.size();i++)
+        {
+          scale = std::max(scale,std::fabs(expected[i]));
+          error = std::max(error,std::fabs(v.values[i]-expected[i]));
+        }
+        worst = std::max(worst,error/scale);
+      } while (step(v));
+
+      std::cout << std::setw(6) << l << std::setw(6) << m1 << std::setprecision(3)
+                << std::setw(14) << direct << std::setw(12) << walked << std::setw(10) << direct/walked
+                << std::setw(10) << (double)w.reseeds/std::max<std::size_t>(1,w.steps)
+                << std::setw(12) << worst << std::endl;
+    }
+  }
+
+  if (checksum != checksum) std::cout << "NaN in the families" << std::endl;
+  return 0;
+}
@@ -0,0 +1,75 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html               -/
+ ********************************************************/
+
+/*! \file benchKernels.cpp
+ *  \author Joey Dumont <joey.dumont@gmail.com>
+ *  \since 2026-10-18
+ *  \brief Measures the throughput of each variant of the vectorized kernels.
+ *  \copyright LGPL
+ * We run the kernels of every instruction set supported by the processor
+ * on a family of 2*10^5 coefficients and report the number of coefficients
+ * processed per nanosecond. We then time a whole family with the variant
+ * selected at load time, which can be changed with WIGNER_SYMBOLS_ISA.
+ */
+
+#include <wignerSymbols.h>
+
+#include <chrono>
+#include <iomanip>
+
+typedef std::chrono::steady_clock Clock;
+
+int main()
+{
+  const int n = 200000, repeat = 50;
+  double l2 = 1.0e5, l3 = 1.0e5, m2 = 9.0e4, m3 = -2.0e4, m1 = -m2-m3;
+  double l1min = std::max(std::fabs(l2-l3),std::fabs(m1));
+  std::vector<double> A(n), B(n), f(n,1.0e-3);
+
+  std::cout << std::setw(10) << "isa" << std::setw(14) << "3j coeffs" << std::setw(14) << "6j coeffs"
+            << std::setw(14) << "norm" << std::setw(14) << "scale" << "   (coefficients/ns)" << std::endl;
+
+  WignerSymbols::InstructionSet all[] = {WignerSymbols::Baseline, WignerSymbols::AVX2, WignerSymbols::AVX512};
+  for (int s=0;s<3;s++)
+  {
+    if (!WignerSymbols::instructionSetSupported(all[s])) continue;
+    const WignerSymbols::Kernels& kernel = WignerSymbols::kernels(all[s]);
+
+    double t[4] = {0.0, 0.0, 0.0, 0.0};
+    for (int r=0;r<repeat;r++)
+    {
+      Clock::time_point t0 = Clock::now();
+      kernel.wigner3jCoefficients(l1min,n,l2,l3,m1,m2,m3,&A[0],&B[0]);
+      Clock::time_point t1 = Clock::now();
+      kernel.wigner6jCoefficients(1.0,n,l2,l3,l2,l3,l2,&A[0],&B[0]);
+      Clock::time_point t2 = Clock::now();
+      kernel.normalizationSum(&f[0],n,l1min);
+      Clock::time_point t3 = Clock::now();
+      kernel.scale(&f[0],n,1.0);
+      Clock::time_point t4 = Clock::now();
+
+      t[0] += std::chrono::duration<double>(t1-t0).count();
+      t[1] += std::chrono::duration<double>(t2-t1).count();
+      t[2] += std::chrono::duration<double>(t3-t2).count();
+      t[3] += std::chrono::duration<double>(t4-t3).count();
+    }
+
+    std::cout << std::setw(10) << WignerSymbols::instructionSetName(all[s]);
+    for (int k=0;k<4;k++)
+      std::cout << std::setw(14) << std::setprecision(3) << n*repeat/(t[k]*1.0e9);
+    std::cout << std::endl;
+  }
+
+  Clock::time_point t0 = Clock::now();
+  std::vector<double> family = WignerSymbols::wigner3j(l2,l3,m1,m2,m3,WignerSymbols::SchultenGordonScaled);
+  Clock::time_point t1 = Clock::now();
+  std::cout << "Family of " << family.size() << " 3j symbols with the "
+            << WignerSymbols::instructionSetName(WignerSymbols::activeInstructionSet()) << " kernels: "
+            << std::chrono::duration<double>(t1-t0).count() << " s" << std::endl;
+
+  return 0;
+}
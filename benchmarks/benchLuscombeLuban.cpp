@@ -0,0 +1,106 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html               -/
+ ********************************************************/
+
+/*! \file benchLuscombeLuban.cpp
+ *  \author Joey Dumont <joey.dumont@gmail.com>
+ *  \since 2026-10-18
+ *  \brief Compares the Luscombe-Luban engine with the Schulten-Gordon ones.
+ *  \copyright LGPL
+ * For l from 10 to 10^5, we time the 3j family (l 1.2l; m1 0.6l -0.3l) and
+ * the 6j family {l1 l 1.1l; 0.9l l 1.05l} with the Rescale, Scaled and
+ * Luscombe-Luban modes and with the Fortran implementation, and report the
+ * largest deviation of each C++ engine from the Fortran one.
+ */
+
+#include <wignerSymbols.h>
+
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+typedef std::chrono::steady_clock Clock;
+
+namespace {
+
+double maxDiff(const std::vector<double>& a, const std::vector<double>& b)
+{
+  double diff = 0.0;
+  for (size_t i=0;i<a.size() && i<b.size();i++)
+    diff = std::max(diff,std::fabs(a[i]-b[i]));
+  return diff;
+}
+
+/*! Times f over enough repetitions to last about 50 ms, and keeps its last
+ * result. */
+template <typename F>
+double timeFamily(F f, std::vector<double>& result)
+{
+  int repeat = 0;
+  Clock::time_point t0 = Clock::now();
+  do
+  {
+    result = f();
+    repeat++;
+  } while (std::chrono::duration<double>(Clock::now()-t0).count() < 0.05);
+  return std::chrono::duration<double>(Clock::now()-t0).count()/repeat;
+}
+
+}
+
+int main()
+{
+  const WignerSymbols::RecursionMode modes[] = {WignerSymbols::SchultenGordonRescale,
+                                                WignerSymbols::SchultenGordonScaled,
+                                                WignerSymbols::LuscombeLuban};
+  double ls[] = {10, 100, 1000, 1.0e4, 1.0e5};
+
+  for (int symbol=3;symbol<=6;symbol+=3)
+  {
+    std::cout << symbol << "j families" << std::endl
+              << std::setw(8) << "l" << std::setw(12) << "Rescale" << std::setw(12) << "Scaled"
+              << std::setw(12) << "LL" << std::setw(12) << "Fortran" << "  (us)"
+              << std::setw(12) << "|R-F|" << std::setw(12) << "|S-F|" << std::setw(12) << "|LL-F|" << std::endl;
+
+    for (int n=0;n<5;n++)
+    {
+      double l = ls[n];
+      double l2 = l, l3 = std::floor(1.2*l), m2 = std::floor(0.6*l), m3 = -std::floor(0.3*l), m1 = -m2-m3;
+      double l4 = std::floor(0.9*l), l5 = l, l6 = std::floor(1.05*l);
+
+      std::vector<double> results[4];
+      double times[4];
+
+      // The Rescale mode reports each rescaling on the standard output.
+      std::stringstream sink;
+      std::streambuf* out = std::cout.rdbuf(sink.rdbuf());
+      for (int k=0;k<3;k++)
+      {
+        WignerSymbols::RecursionMode mode = modes[k];
+        if (symbol == 3)
+          times[k] = timeFamily([&]() { return WignerSymbols::wigner3j(l2,l3,m1,m2,m3,mode); },results[k]);
+        else
+          times[k] = timeFamily([&]() { return WignerSymbols::wigner6j(l2,l3,l4,l5,l6,mode); },results[k]);
+      }
+      std::cout.rdbuf(out);
+
+      if (symbol == 3)
+        times[3] = timeFamily([&]() { return WignerSymbols::wigner3j_f(l2,l3,m1,m2,m3); },results[3]);
+      else
+        times[3] = timeFamily([&]() { return WignerSymbols::wigner6j_f(l2,l3,l4,l5,l6); },results[3]);
+
+      std::cout << std::setw(8) << l;
+      for (int k=0;k<4;k++)
+        std::cout << std::setw(12) << std::setprecision(4) << times[k]*1.0e6;
+      std::cout << "      ";
+      for (int k=0;k<3;k++)
+        std::cout << std::setw(12) << std::setprecision(3) << maxDiff(results[k],results[3]);
+      std::cout << std::endl;
+    }
+  }
+
+  return 0;
+}
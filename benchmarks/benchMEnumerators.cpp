@@ -0,0 +1,64 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html               -/
+ ********************************************************/
+
+/*! \file benchMEnumerators.cpp
+ *  \author Joey Dumont <joey.dumont@gmail.com>
+ *  \since 2026-10-18
+ *  \brief Compares the sums over projections with and without enumerators.
+ *  \copyright LGPL
+ * For l1 = l2 = l3 = l, we evaluate the sum rule over m2 of testWigner for
+ * all m3, first with the double loop over (m1,m2) filtered by m1+m2 = m3
+ * and one scalar wigner3j() per term, then with forEachWigner3jM().
+ */
+
+#include <wignerSymbols.h>
+
+#include <chrono>
+#include <iomanip>
+
+typedef std::chrono::steady_clock Clock;
+
+int main()
+{
+  int ls[] = {5, 10, 20, 40};
+  double checksum = 0.0;
+
+  std::cout << std::setw(6) << "l" << std::setw(14) << "loops (s)" << std::setw(14) << "enum (s)"
+            << std::setw(10) << "speedup" << std::endl;
+  for (int s=0;s<4;s++)
+  {
+    double l = ls[s];
+
+    Clock::time_point t0 = Clock::now();
+    for (double m3=-l;m3<=l;m3++)
+      for (int i=0;i<(2*l+1);i++)
+      {
+        double m1 = -l+i;
+        for (int j=0;j<(2*l+1);j++)
+        {
+          double m2 = -l+j;
+          if (std::fabs(m1+m2-m3)<1.0e-6)
+            checksum += m2*(2.0*l+1.0)*std::pow(WignerSymbols::wigner3j(l,l,l,m1,m2,-m3),2.0);
+        }
+      }
+    double loops = std::chrono::duration<double>(Clock::now()-t0).count();
+
+    t0 = Clock::now();
+    for (double m3=-l;m3<=l;m3++)
+      WignerSymbols::forEachWigner3jM(l,l,l,-m3,[&](double, double m2, double value)
+      {
+        checksum += m2*(2.0*l+1.0)*value*value;
+      });
+    double enumerated = std::chrono::duration<double>(Clock::now()-t0).count();
+
+    std::cout << std::setw(6) << l << std::setprecision(3) << std::setw(14) << loops
+              << std::setw(14) << enumerated << std::setw(10) << loops/enumerated << std::endl;
+  }
+
+  if (checksum != checksum) std::cout << "NaN in the sums" << std::endl;
+  return 0;
+}
@@ -0,0 +1,89 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html               -/
+ ********************************************************/
+
+/*! \file benchPlans.cpp
+ *  \author Joey Dumont <joey.dumont@gmail.com>
+ *  \since 2026-10-18
+ *  \brief Compares the families computed with and without coefficient plans.
+ *  \copyright LGPL
+ * For given l2 = l3 = l, we compute the 3j families of all the (m2,m3),
+ * and for given l2 = l3 = l5 = l6 = l the 6j families of all the l4, in the
+ * SchultenGordonScaled mode. The time of the plan itself is included.
+ */
+
+#include <wignerSymbols.h>
+
+#include <chrono>
+#include <iomanip>
+
+typedef std::chrono::steady_clock Clock;
+
+static double seconds(Clock::time_point t0)
+{
+  return std::chrono::duration<double>(Clock::now()-t0).count();
+}
+
+int main()
+{
+  WignerSymbols::RecursionMode mode = WignerSymbols::SchultenGordonScaled;
+  int ls[] = {10, 40, 100};
+  double checksum = 0.0;
+
+  std::cout << "3j, all (m2,m3)" << std::endl
+            << std::setw(6) << "l" << std::setw(10) << "families" << std::setw(14) << "direct (s)"
+            << std::setw(14) << "plan (s)" << std::setw(10) << "speedup" << std::endl;
+  for (int s=0;s<3;s++)
+  {
+    int l = ls[s];
+    Clock::time_point t0 = Clock::now();
+    for (int m2=-l;m2<=l;m2++)
+      for (int m3=-l;m3<=l;m3++)
+        checksum += WignerSymbols::wigner3j(l,l,-m2-m3,m2,m3,mode)[0];
+    double direct = seconds(t0);
+
+    t0 = Clock::now();
+    WignerSymbols::Wigner3jPlan plan = WignerSymbols::wigner3jPlan(l,l);
+    for (int m2=-l;m2<=l;m2++)
+      for (int m3=-l;m3<=l;m3++)
+        checksum += WignerSymbols::wigner3j(plan,-m2-m3,m2,m3,mode)[0];
+    double planned = seconds(t0);
+
+    std::cout << std::setw(6) << l << std::setw(10) << (2*l+1)*(2*l+1)
+              << std::setw(14) << std::setprecision(3) << direct << std::setw(14) << planned
+              << std::setw(10) << direct/planned << std::endl;
+  }
+
+  int ls6[] = {50, 200, 800};
+  std::cout << "6j, all l4" << std::endl
+            << std::setw(6) << "l" << std::setw(10) << "families" << std::setw(14) << "direct (s)"
+            << std::setw(14) << "plan (s)" << std::setw(10) << "speedup" << std::endl;
+  for (int s=0;s<3;s++)
+  {
+    int l = ls6[s], repeat = 20;
+    Clock::time_point t0 = Clock::now();
+    for (int r=0;r<repeat;r++)
+      for (int l4=0;l4<=2*l;l4++)
+        checksum += WignerSymbols::wigner6j(l,l,l4,l,l,mode)[0];
+    double direct = seconds(t0);
+
+    t0 = Clock::now();
+    for (int r=0;r<repeat;r++)
+    {
+      WignerSymbols::Wigner6jPlan plan = WignerSymbols::wigner6jPlan(l,l,l,l);
+      for (int l4=0;l4<=2*l;l4++)
+        checksum += WignerSymbols::wigner6j(plan,l4,mode)[0];
+    }
+    double planned = seconds(t0);
+
+    std::cout << std::setw(6) << l << std::setw(10) << repeat*(2*l+1)
+              << std::setw(14) << std::setprecision(3) << direct << std::setw(14) << planned
+              << std::setw(10) << direct/planned << std::endl;
+  }
+
+  if (checksum != checksum) std::cout << "NaN in the families" << std::endl;
+  return 0;
+}
@@ -0,0 +1,83 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html               -/
+ ********************************************************/
+
+/*! \file benchQuantizedTable.cpp
+ *  \author Joey Dumont <joey.dumont@gmail.com>
+ *  \since 2026-10-18
+ *  \brief Compares the storage modes of a 3j table.
+ *  \copyright LGPL
+ * For each storage mode, we report the memory taken by the table of
+ * wigner3jFamilies(lmax), the memory saved with respect to double
+ * precision, the bound and the measured error, and the throughput of random
+ * gathers and of the dequantization of whole families.
+ */
+
+#include <wignerSymbols.h>
+
+#include <chrono>
+#include <iomanip>
+#include <random>
+
+typedef std::chrono::steady_clock Clock;
+
+int main(int argc, char* argv[])
+{
+  int lmax = (argc > 1 ? std::atoi(argv[1]) : 24);
+  const char* names[] = {"double", "float32", "fixed16"};
+  WignerSymbols::TableStorage modes[] = {
+    WignerSymbols::DoubleStorage, WignerSymbols::Float32Storage, WignerSymbols::Fixed16Storage,
+  };
+
+  std::vector<WignerSymbols::Wigner3jFamily> families = WignerSymbols::wigner3jFamilies(lmax);
+
+  // Random lookups, the same for every mode.
+  std::mt19937 rng(5);
+  const std::size_t count = 1 << 22;
+  std::vector<std::size_t> family(count);
+  std::vector<int> index(count);
+  std::vector<double> out(count);
+  for (std::size_t j=0;j<count;j++)
+  {
+    family[j] = rng() % families.size();
+    index[j]  = rng() % WignerSymbols::familySize(families[family[j]]);
+  }
+
+  std::cout << "lmax " << lmax << ", " << families.size() << " families, "
+            << WignerSymbols::instructionSetName(WignerSymbols::activeInstructionSet()) << " kernels" << std::endl
+            << std::setw(8) << "storage" << std::setw(12) << "MB" << std::setw(10) << "saved"
+            << std::setw(12) << "bound" << std::setw(12) << "error"
+            << std::setw(14) << "gather/s" << std::setw(14) << "decode/s" << std::endl;
+
+  double mb = 1.0/(1 << 20), doubleBytes = 0.0, checksum = 0.0;
+  for (int s=0;s<3;s++)
+  {
+    WignerSymbols::QuantizedTable table = WignerSymbols::wigner3jQuantizedTable(families,modes[s]);
+    if (s == 0) doubleBytes = table.bytes();
+
+    Clock::time_point t0 = Clock::now();
+    table.gather(family.data(),index.data(),count,out.data());
+    double gather = count/std::chrono::duration<double>(Clock::now()-t0).count();
+    checksum += out[count-1];
+
+    std::vector<double> f(2*lmax+1);
+    t0 = Clock::now();
+    for (std::size_t k=0;k<table.families();k++)
+      table.family(k,f.data());
+    double decode = table.offsets.back()/std::chrono::duration<double>(Clock::now()-t0).count();
+    checksum += f[0];
+
+    std::cout << std::setw(8) << names[s] << std::setprecision(4)
+              << std::setw(12) << table.bytes()*mb
+              << std::setw(9) << 100.0*(1.0-table.bytes()/doubleBytes) << "%"
+              << std::setw(12) << WignerSymbols::storageErrorBound(modes[s])
+              << std::setw(12) << table.maxError
+              << std::setw(14) << gather << std::setw(14) << decode << std::endl;
+  }
+
+  if (checksum != checksum) std::cout << "NaN in the table" << std::endl;
+  return 0;
+}
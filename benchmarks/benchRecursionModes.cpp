@@ -0,0 +1,77 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html               -/
+ ********************************************************/
+
+/*! \file benchRecursionModes.cpp
+ *  \author Joey Dumont <joey.dumont@gmail.com>
+ *  \since 2026-10-18
+ *  \brief Compares the overflow strategies of the family functions.
+ *  \copyright LGPL
+ * We time the Rescale and Scaled recursion modes on 3j families with
+ * l ~ 10^4-10^5 and large projections, for which the coefficients span
+ * thousands of orders of magnitude, and we compare both with the Fortran
+ * implementation.
+ */
+
+#include <wignerSymbols.h>
+
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+typedef std::chrono::steady_clock Clock;
+
+int main()
+{
+  // l2, l3 and the fractions of l2 and l3 carried by m2 and m3.
+  double families[][4] = {
+    { 1.0e4, 1.2e4, 0.9, -0.8},
+    { 3.0e4, 2.0e4, 0.7,  0.9},
+    { 5.0e4, 5.0e4, 0.95, 0.1},
+    { 1.0e5, 0.8e5, 0.9, -0.9},
+  };
+
+  std::cout << std::setw(10) << "l2" << std::setw(10) << "l3" << std::setw(10) << "size"
+            << std::setw(10) << "rescales" << std::setw(14) << "Rescale (s)" << std::setw(14) << "Scaled (s)"
+            << std::setw(14) << "|R-F|" << std::setw(14) << "|S-F|" << std::endl;
+
+  for (size_t n=0;n<sizeof(families)/sizeof(families[0]);n++)
+  {
+    double l2 = families[n][0], l3 = families[n][1];
+    double m2 = std::floor(families[n][2]*l2), m3 = std::floor(families[n][3]*l3);
+    double m1 = -m2-m3;
+
+    // The Rescale mode reports each rescaling on the standard output.
+    std::stringstream sink;
+    std::streambuf* out = std::cout.rdbuf(sink.rdbuf());
+    Clock::time_point t0 = Clock::now();
+    std::vector<double> rescale = WignerSymbols::wigner3j(l2,l3,m1,m2,m3,WignerSymbols::SchultenGordonRescale);
+    Clock::time_point t1 = Clock::now();
+    std::cout.rdbuf(out);
+
+    std::vector<double> scaled = WignerSymbols::wigner3j(l2,l3,m1,m2,m3,WignerSymbols::SchultenGordonScaled);
+    Clock::time_point t2 = Clock::now();
+
+    std::vector<double> fortran = WignerSymbols::wigner3j_f(l2,l3,m1,m2,m3);
+
+    double errR = 0.0, errS = 0.0;
+    for (size_t i=0;i<fortran.size() && i<scaled.size();i++)
+    {
+      errR = std::max(errR, std::fabs(rescale[i]-fortran[i]));
+      errS = std::max(errS, std::fabs(scaled[i]-fortran[i]));
+    }
+
+    std::string log = sink.str();
+    std::cout << std::setw(10) << l2 << std::setw(10) << l3 << std::setw(10) << scaled.size()
+              << std::setw(10) << std::count(log.begin(), log.end(), '\n')
+              << std::setw(14) << std::setprecision(4) << std::chrono::duration<double>(t1-t0).count()
+              << std::setw(14) << std::setprecision(4) << std::chrono::duration<double>(t2-t1).count()
+              << std::setw(14) << std::setprecision(3) << errR
+              << std::setw(14) << std::setprecision(3) << errS << std::endl;
+  }
+
+  return 0;
+}
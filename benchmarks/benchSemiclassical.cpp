@@ -0,0 +1,91 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html               -/
+ ********************************************************/
+
+/*! \file benchSemiclassical.cpp
+ *  \author Joey Dumont <joey.dumont@gmail.com>
+ *  \since 2026-10-18
+ *  \brief Maps the accuracy and speed of the semiclassical approximation.
+ *  \copyright LGPL
+ * For l from 10^2 to 10^5 and a few geometries, we sample symbols across a
+ * family and compare the semiclassical value with the exact recursion. We
+ * report the largest actual and estimated errors, the share of symbols that
+ * fell back to the recursion, and the time per symbol of both methods.
+ */
+
+#include <wignerSymbols.h>
+
+#include <chrono>
+#include <iomanip>
+
+typedef std::chrono::steady_clock Clock;
+
+int main()
+{
+  double scales[] = {1.0e2, 3.0e2, 1.0e3, 3.0e3, 1.0e4, 3.0e4, 1.0e5};
+
+  // Fractions of l of l2, l3, m2, m3 for the 3j symbols and of l2..l6 for the 6j symbols.
+  double geometries3j[][4] = {
+    {1.0, 1.0, 0.5, -0.4},
+    {1.0, 1.0, 0.0, -0.4},
+    {1.0, 0.8, 0.2, -0.4},
+  };
+  double geometries6j[][5] = {
+    {1.0, 1.2, 0.9, 0.8, 1.1},
+    {0.5, 1.0, 0.7, 0.6, 0.9},
+  };
+  const int samples = 200;
+
+  std::cout << std::setw(4) << "" << std::setw(10) << "l" << std::setw(6) << "geom"
+            << std::setw(12) << "max|f|" << std::setw(12) << "error" << std::setw(12) << "estimate"
+            << std::setw(10) << "fallback" << std::setw(14) << "exact (us)" << std::setw(14) << "semicl. (us)" << std::endl;
+
+  for (size_t s=0;s<sizeof(scales)/sizeof(scales[0]);s++)
+  {
+    double L = scales[s];
+    for (size_t g=0;g<sizeof(geometries3j)/sizeof(geometries3j[0])+sizeof(geometries6j)/sizeof(geometries6j[0]);g++)
+    {
+      bool is3j = (g < sizeof(geometries3j)/sizeof(geometries3j[0]));
+      double p[5];
+      for (int k=0;k<5;k++)
+        p[k] = (is3j ? (k<4 ? std::floor(geometries3j[g][k]*L) : 0.0) : std::floor(geometries6j[g-3][k]*L));
+
+      // The recursion computes the whole family to return a single symbol.
+      Clock::time_point t0 = Clock::now();
+      std::vector<double> exact = (is3j ? WignerSymbols::wigner3j(p[0],p[1],-p[2]-p[3],p[2],p[3],WignerSymbols::SchultenGordonScaled)
+                                        : WignerSymbols::wigner6j(p[0],p[1],p[2],p[3],p[4],WignerSymbols::SchultenGordonScaled));
+      double tExact = std::chrono::duration<double>(Clock::now()-t0).count();
+
+      double l1min = (is3j ? std::max(std::fabs(p[0]-p[1]),std::fabs(p[2]+p[3]))
+                           : std::max(std::fabs(p[0]-p[1]),std::fabs(p[3]-p[4])));
+
+      double maxValue = 0.0, maxError = 0.0, maxEstimate = 0.0;
+      int fallbacks = 0, n = 0;
+      Clock::time_point t1 = Clock::now();
+      for (size_t i=0;i<exact.size();i+=std::max<size_t>(1,exact.size()/samples),n++)
+      {
+        double error, l1 = l1min+i;
+        double value = (is3j ? WignerSymbols::wigner3j_semiclassical(l1,p[0],p[1],-p[2]-p[3],p[2],p[3],1.0e-6,&error)
+                             : WignerSymbols::wigner6j_semiclassical(l1,p[0],p[1],p[2],p[3],p[4],1.0e-6,&error));
+        if (error == 0.0 && value == exact[i] && value != 0.0) fallbacks++;
+        maxValue    = std::max(maxValue,std::fabs(exact[i]));
+        maxError    = std::max(maxError,std::fabs(value-exact[i]));
+        maxEstimate = std::max(maxEstimate,error);
+      }
+      double tSemiclassical = std::chrono::duration<double>(Clock::now()-t1).count()/n;
+
+      std::cout << std::setw(4) << (is3j ? "3j" : "6j") << std::setw(10) << L << std::setw(6) << g
+                << std::setw(12) << std::setprecision(3) << maxValue
+                << std::setw(12) << std::setprecision(3) << maxError
+                << std::setw(12) << std::setprecision(3) << maxEstimate
+                << std::setw(10) << fallbacks
+                << std::setw(14) << std::setprecision(4) << tExact*1.0e6
+                << std::setw(14) << std::setprecision(4) << tSemiclassical*1.0e6 << std::endl;
+    }
+  }
+
+  return 0;
+}
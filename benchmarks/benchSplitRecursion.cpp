@@ -0,0 +1,79 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html               -/
+ ********************************************************/
+
+/*! \file benchSplitRecursion.cpp
+ *  \author Joey Dumont <joey.dumont@gmail.com>
+ *  \since 2026-10-18
+ *  \brief Measures the latency of the two-thread split of the recursion.
+ *  \copyright LGPL
+ * We time single 3j and 6j families of increasing length in the Scaled mode,
+ * with the serial recursion and with the sweeps split between two threads.
+ * The length at which the split starts to pay off is the natural value of
+ * setSplitRecursionThreshold() on this machine.
+ */
+
+#include <wignerSymbols.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <thread>
+
+typedef std::chrono::steady_clock Clock;
+
+namespace {
+
+/*! Median latency of f over 51 calls. */
+template <typename F>
+double latency(F f)
+{
+  std::vector<double> times;
+  for (int r=0;r<51;r++)
+  {
+    Clock::time_point t0 = Clock::now();
+    f();
+    times.push_back(std::chrono::duration<double>(Clock::now()-t0).count());
+  }
+  std::nth_element(times.begin(),times.begin()+25,times.end());
+  return times[25];
+}
+
+}
+
+int main()
+{
+  const WignerSymbols::RecursionMode scaled = WignerSymbols::SchultenGordonScaled;
+  double ls[] = {500, 1000, 2000, 4000, 8000, 16000, 32000, 64000, 128000};
+
+  std::cout << "Hardware threads: " << std::thread::hardware_concurrency()
+            << ", default threshold: " << WignerSymbols::splitRecursionThreshold() << std::endl;
+  std::cout << std::setw(8) << "size" << std::setw(14) << "3j serial" << std::setw(14) << "3j split"
+            << std::setw(14) << "6j serial" << std::setw(14) << "6j split" << "   (us)" << std::endl;
+
+  for (int n=0;n<9;n++)
+  {
+    // Families of about 2l symbols, with allowed regions of various widths.
+    double l = ls[n]/2.0;
+    double l2 = l, l3 = l, m2 = std::floor(0.5*l), m3 = -std::floor(0.2*l), m1 = -m2-m3;
+    double l4 = std::floor(0.6*l), l5 = l, l6 = l;
+
+    double t[4];
+    for (int split=0;split<2;split++)
+    {
+      WignerSymbols::setSplitRecursionThreshold(split ? 16 : 1 << 30);
+      t[split]   = latency([&]() { WignerSymbols::wigner3j(l2,l3,m1,m2,m3,scaled); });
+      t[2+split] = latency([&]() { WignerSymbols::wigner6j(l2,l3,l4,l5,l6,scaled); });
+    }
+
+    std::cout << std::setw(8) << WignerSymbols::wigner3j(l2,l3,m1,m2,m3,scaled).size();
+    for (int k=0;k<4;k++)
+      std::cout << std::setw(14) << std::setprecision(4) << t[k]*1.0e6;
+    std::cout << std::endl;
+  }
+
+  return 0;
+}
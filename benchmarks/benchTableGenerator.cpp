@@ -0,0 +1,64 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html               -/
+ ********************************************************/
+
+/*! \file benchTableGenerator.cpp
+ *  \author Joey Dumont <joey.dumont@gmail.com>
+ *  \since 2026-10-18
+ *  \brief Measures the scaling of the parallel table generator.
+ *  \copyright LGPL
+ * We generate the canonical 3j table up to lmax with 1, 2, 4, ..., 64
+ * threads and print the wall time, the speedup and the utilization of
+ * the threads. Usage: benchTableGenerator [lmax] [maxThreads]
+ */
+
+#include <wignerSymbols.h>
+
+#include <cstdlib>
+#include <iomanip>
+#include <thread>
+
+int main(int argc, char* argv[])
+{
+  int lmax                = (argc > 1 ? std::atoi(argv[1]) : 24);
+  unsigned int maxThreads = (argc > 2 ? std::atoi(argv[2]) : 64);
+
+  std::vector<WignerSymbols::Wigner3jFamily> families = WignerSymbols::wigner3jFamilies(lmax);
+  std::cout << "lmax = " << lmax << ", " << families.size() << " families, "
+            << std::thread::hardware_concurrency() << " hardware threads" << std::endl;
+  std::cout << std::setw(8) << "threads" << std::setw(12) << "wall (s)" << std::setw(10) << "speedup"
+            << std::setw(14) << "utilization" << std::setw(10) << "steals"
+            << std::setw(16) << "min/max busy" << std::endl;
+
+  double reference = 0.0;
+  for (unsigned int nthreads=1;nthreads<=maxThreads;nthreads*=2)
+  {
+    std::vector<std::size_t> offsets;
+    WignerSymbols::SchedulerStats stats;
+    WignerSymbols::wigner3jTable(families, offsets, nthreads, &stats);
+
+    if (nthreads == 1) reference = stats.wallSeconds;
+
+    std::size_t steals = 0;
+    double minBusy = stats.workers[0].busySeconds, maxBusy = minBusy;
+    for (std::size_t i=0;i<stats.workers.size();i++)
+    {
+      steals += stats.workers[i].steals;
+      minBusy = std::min(minBusy, stats.workers[i].busySeconds);
+      maxBusy = std::max(maxBusy, stats.workers[i].busySeconds);
+    }
+
+    std::cout << std::setw(8) << nthreads
+              << std::setw(12) << std::setprecision(4) << stats.wallSeconds
+              << std::setw(10) << std::setprecision(3) << reference/stats.wallSeconds
+              << std::setw(14) << std::setprecision(3) << stats.utilization()
+              << std::setw(10) << steals
+              << std::setw(16) << std::setprecision(3) << (maxBusy > 0.0 ? minBusy/maxBusy : 1.0)
+              << std::endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,75 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html               -/
+ ********************************************************/
+
+/*! \file benchTensorOperators.cpp
+ *  \author Joey Dumont <joey.dumont@gmail.com>
+ *  \since 2026-10-18
+ *  \brief Compares the application of a tensor operator with a dense matrix.
+ *  \copyright LGPL
+ * The basis holds the blocks j = 0, ..., jmax, and the operator of rank 2
+ * couples every pair of blocks allowed by the triangle relation. We time the
+ * construction of the dense matrix from scalar 3j symbols followed by the
+ * product, and applyTensorOperator() with 1 to 8 threads.
+ */
+
+#include <wignerSymbols.h>
+
+#include <chrono>
+#include <iomanip>
+
+typedef std::chrono::steady_clock Clock;
+
+int main()
+{
+  const double k = 2.0, q = 1.0;
+  int jmaxs[] = {20, 40, 80};
+
+  std::cout << std::setw(6) << "jmax" << std::setw(8) << "dim" << std::setw(14) << "dense (s)";
+  for (unsigned int t=1;t<=8;t*=2) std::cout << std::setw(10) << t << " thr";
+  std::cout << std::endl;
+
+  for (int s=0;s<3;s++)
+  {
+    std::vector<double> j;
+    for (int b=0;b<=jmaxs[s];b++) j.push_back(b);
+    std::size_t n = j.size();
+    std::vector<std::size_t> offsets = WignerSymbols::tensorBasisOffsets(j);
+    std::size_t dim = offsets[n];
+
+    std::vector<double> reduced(n*n,1.0), state(dim,1.0);
+
+    // Dense matrix, then product.
+    Clock::time_point t0 = Clock::now();
+    std::vector<double> matrix(dim*dim,0.0), dense(dim,0.0);
+    for (std::size_t r=0;r<n;r++)
+      for (std::size_t c=0;c<n;c++)
+        for (std::size_t a=0;a<offsets[r+1]-offsets[r];a++)
+          for (std::size_t b=0;b<offsets[c+1]-offsets[c];b++)
+          {
+            double mp = a-j[r], m = b-j[c];
+            double phase = ((long)(j[r]-mp+0.5)%2 ? -1.0 : 1.0);
+            matrix[(offsets[r]+a)*dim+offsets[c]+b] = phase*reduced[r*n+c]*WignerSymbols::wigner3j(j[r],k,j[c],-mp,q,m);
+          }
+    for (std::size_t i=0;i<dim;i++)
+      for (std::size_t l=0;l<dim;l++)
+        dense[i] += matrix[i*dim+l]*state[l];
+    double tdense = std::chrono::duration<double>(Clock::now()-t0).count();
+
+    std::cout << std::setw(6) << jmaxs[s] << std::setw(8) << dim << std::setw(14) << std::setprecision(3) << tdense;
+    for (unsigned int t=1;t<=8;t*=2)
+    {
+      const int repeat = 20;
+      Clock::time_point t1 = Clock::now();
+      for (int r=0;r<repeat;r++)
+        WignerSymbols::applyTensorOperator(k,q,j,reduced,state,t);
+      std::cout << std::setw(14) << std::setprecision(3) << std::chrono::duration<double>(Clock::now()-t1).count()/repeat;
+    }
+    std::cout << std::endl;
+  }
+
+  return 0;
+}
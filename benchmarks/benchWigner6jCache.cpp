@@ -0,0 +1,102 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html               -/
+ ********************************************************/
+
+/*! \file benchWigner6jCache.cpp
+ *  \author Joey Dumont <joey.dumont@gmail.com>
+ *  \since 2026-10-18
+ *  \brief Measures the cache of 6j families with 1 to 32 threads.
+ *  \copyright LGPL
+ * The threads draw symbols from a working set of 6j symbols with l <= 20,
+ * each in a random orientation, as recoupling calculations do. We report
+ * the lookups per second, the hit rate and the lookups that waited for a
+ * lock, against the scalar wigner6j() on one thread.
+ */
+
+#include <wignerSymbols.h>
+
+#include <chrono>
+#include <iomanip>
+#include <random>
+#include <thread>
+
+using namespace WignerSymbols;
+
+typedef std::chrono::steady_clock Clock;
+
+int main()
+{
+  const int lmax = 20, workingSet = 4000, lookups = 200000;
+
+  // Symbols that satisfy the selection rules.
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> momentum(0,lmax);
+  std::vector<std::vector<int> > set;
+  while ((int)set.size() < workingSet)
+  {
+    int l[6] = {momentum(rng),momentum(rng),momentum(rng),momentum(rng),momentum(rng),momentum(rng)};
+    if (wigner6j(l[0],l[1],l[2],l[3],l[4],l[5]) != 0.0) set.push_back(std::vector<int>(l,l+6));
+  }
+
+  // The requests: a symbol of the set in one of its orientations.
+  static const int permutations[6][3] = {{0,1,2},{0,2,1},{1,0,2},{1,2,0},{2,0,1},{2,1,0}};
+  static const bool flips[4][3] = {{false,false,false},{true,true,false},{true,false,true},{false,true,true}};
+  std::vector<int> requests(6*lookups);
+  std::uniform_int_distribution<int> pick(0,workingSet-1), orientation(0,23);
+  for (int i=0;i<lookups;i++)
+  {
+    const std::vector<int>& l = set[pick(rng)];
+    int o = orientation(rng), p = o/4, f = o%4;
+    for (int k=0;k<3;k++)
+    {
+      int column = permutations[p][k];
+      requests[6*i+k]   = flips[f][k] ? l[column+3] : l[column];
+      requests[6*i+k+3] = flips[f][k] ? l[column]   : l[column+3];
+    }
+  }
+
+  double checksum = 0.0;
+  const int direct = lookups/20;
+  Clock::time_point t0 = Clock::now();
+  for (int i=0;i<direct;i++)
+  {
+    const int* r = &requests[6*i];
+    checksum += wigner6j(r[0],r[1],r[2],r[3],r[4],r[5]);
+  }
+  double scalarRate = direct/std::chrono::duration<double>(Clock::now()-t0).count();
+  std::cout << "scalar wigner6j: " << std::setprecision(3) << scalarRate << " symbols/s" << std::endl << std::endl;
+
+  std::cout << std::setw(8) << "threads" << std::setw(14) << "lookups/s" << std::setw(10) << "speedup"
+            << std::setw(10) << "hit rate" << std::setw(12) << "contended" << std::endl;
+  int threadCounts[] = {1, 2, 4, 8, 16, 32};
+  for (int n : threadCounts)
+  {
+    Wigner6jCache cache;
+    std::vector<double> sums(n,0.0);
+    t0 = Clock::now();
+    std::vector<std::thread> threads;
+    for (int t=0;t<n;t++)
+      threads.push_back(std::thread([&,t]()
+      {
+        // Each thread goes through all the requests from its own start.
+        for (int k=0;k<lookups;k++)
+        {
+          const int* r = &requests[6*((k+(long)t*lookups/n)%lookups)];
+          sums[t] += cache(r[0],r[1],r[2],r[3],r[4],r[5]);
+        }
+      }));
+    for (auto& thread : threads) thread.join();
+    double rate = (double)n*lookups/std::chrono::duration<double>(Clock::now()-t0).count();
+    for (int t=0;t<n;t++) checksum += sums[t];
+
+    Wigner6jCacheStats stats = cache.stats();
+    std::cout << std::setw(8) << n << std::setw(14) << rate << std::setw(10) << rate/scalarRate
+              << std::setw(10) << stats.hitRate() << std::setw(12) << stats.contended << std::endl;
+  }
+
+  if (checksum != checksum) std::cout << "NaN in the symbols" << std::endl;
+  return 0;
+}
@@ -11,5 +11,23 @@
 #include "wignerSymbols/wignerSymbols-cpp.h"
 #include "wignerSymbols/wignerSymbols-fortran.h"
 #include "wignerSymbols/commonFunctions.h"
+#include "wignerSymbols/scratchArena.h"
+#include "wignerSymbols/workStealing.h"
+#include "wignerSymbols/tableGenerator.h"
+#include "wignerSymbols/semiclassical.h"
+#include "wignerSymbols/kernels.h"
+#include "wignerSymbols/closedForms.h"
+#include "wignerSymbols/recoupling.h"
+#include "wignerSymbols/tableWriter.h"
+#include "wignerSymbols/tableShards.h"
+#include "wignerSymbols/quantizedTable.h"
+#include "wignerSymbols/mEnumerators.h"
+#include "wignerSymbols/tensorOperators.h"
+#include "wignerSymbols/bispectrum.h"
+#include "wignerSymbols/familyCache.h"
+#include "wignerSymbols/wigner6jCache.h"
+#include "wignerSymbols/familyWalker.h"
+#include "wignerSymbols/asyncFamilies.h"
+#include "wignerSymbols/coefficientServer.h"
 
 #endif  // WIGNER_SYMBOLS_H
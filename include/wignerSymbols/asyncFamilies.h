@@ -0,0 +1,142 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html.              -/
+ ********************************************************/
+
+#ifndef WIGNER_SYMBOLS_ASYNC_FAMILIES_H
+#define WIGNER_SYMBOLS_ASYNC_FAMILIES_H
+
+/** \file asyncFamilies.h
+ *
+ * \author Joey Dumont <joey.dumont@gmail.com>
+ *
+ * \since 2026-10-18
+ *
+ * \brief Defines the asynchronous computation of families of 3j and 6j symbols.
+ *
+ * A family with l of order 10^4 takes milliseconds to compute. A program
+ * that has other work to do submits it to a pool of worker threads and
+ * gets a FamilyJob, which it can wait for, poll or cancel. The pool has a
+ * fixed number of threads and a bounded queue: a submission waits while
+ * the queue is full. The symbols are written to a buffer provided by the
+ * caller, which must hold familySize() values and stay valid until the
+ * job has finished. A callback, if given, is called once the job has
+ * finished: on the worker thread if it ran, on the cancelling thread if it
+ * was cancelled before it started, and on the submitting thread if the
+ * buffer is too small.
+ *
+ */
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+#include "wignerSymbols-cpp.h"
+
+namespace WignerSymbols {
+
+enum FamilyJobStatus
+{
+  FamilyJobPending,    //!< Waiting in the queue.
+  FamilyJobRunning,
+  FamilyJobDone,       //!< The symbols are in the buffer.
+  FamilyJobCancelled,  //!< The buffer was not written.
+  FamilyJobTooSmall,   //!< The buffer cannot hold the family; it was not written.
+  FamilyJobFailed      //!< The recursion threw, and the buffer was not written, or the callback threw.
+};
+
+/*! Called with the final status of the job and the number of symbols
+ * written to the buffer. */
+typedef std::function<void(FamilyJobStatus, std::size_t)> FamilyJobCallback;
+
+/*! Handle to a submitted family. Copies refer to the same job. */
+class FamilyJob
+{
+public:
+  FamilyJob();
+
+  FamilyJobStatus status() const;
+
+  /*! Number of symbols in the family, at least one: the families that
+   * violate a selection rule are a single zero. */
+  std::size_t size() const;
+
+  /*! Waits for the job to finish, its callback included, and returns its
+   * final status. */
+  FamilyJobStatus wait() const;
+
+  /*! Waits at most the given time. Returns true if the job has finished. */
+  bool waitFor(double seconds) const;
+
+  /*! Cancels the job. A pending job never runs; a running job finishes its
+   * recursion but does not write to the buffer. Returns false if the job
+   * had already finished. */
+  bool cancel();
+
+  struct State;
+
+private:
+  explicit FamilyJob(const std::shared_ptr<State>& state);
+  friend class FamilyJobPool;
+
+  std::shared_ptr<State> state;
+};
+
+/*! Pool of worker threads computing families. */
+class FamilyJobPool
+{
+public:
+  /*! Pool of nthreads threads (0 for all the hardware threads) and a queue
+   * of at most maxQueued jobs. */
+  explicit FamilyJobPool(unsigned int nthreads = 0, std::size_t maxQueued = 256);
+
+  /*! Cancels the pending jobs and waits for the running ones. */
+  ~FamilyJobPool();
+
+  /*! Submits the family wigner3j(l2,l3,m1,m2,m3,mode), to be written to
+   * out[0..capacity). */
+  FamilyJob wigner3j(double l2, double l3, double m1, double m2, double m3,
+                     double* out, std::size_t capacity,
+                     RecursionMode mode = SchultenGordonScaled,
+                     const FamilyJobCallback& callback = FamilyJobCallback());
+
+  /*! Submits the family wigner6j(l2,l3,l4,l5,l6,mode). */
+  FamilyJob wigner6j(double l2, double l3, double l4, double l5, double l6,
+                     double* out, std::size_t capacity,
+                     RecursionMode mode = SchultenGordonScaled,
+                     const FamilyJobCallback& callback = FamilyJobCallback());
+
+  unsigned int threads() const;
+
+  /*! Number of jobs waiting in the queue. */
+  std::size_t pending() const;
+
+private:
+  FamilyJobPool(const FamilyJobPool&);
+  FamilyJobPool& operator=(const FamilyJobPool&);
+
+  FamilyJob submit(const std::shared_ptr<FamilyJob::State>& job);
+
+  struct Queue;
+  std::unique_ptr<Queue> queue;
+};
+
+/*! The pool used by wigner3j_async() and wigner6j_async(), with all the
+ * hardware threads. It is created on first use. */
+FamilyJobPool& sharedFamilyJobPool();
+
+/*! Asynchronous variants of wigner3j(l2,l3,m1,m2,m3) and
+ * wigner6j(l2,l3,l4,l5,l6), on the shared pool. */
+FamilyJob wigner3j_async(double l2, double l3, double m1, double m2, double m3,
+                         double* out, std::size_t capacity,
+                         const FamilyJobCallback& callback = FamilyJobCallback());
+
+FamilyJob wigner6j_async(double l2, double l3, double l4, double l5, double l6,
+                         double* out, std::size_t capacity,
+                         const FamilyJobCallback& callback = FamilyJobCallback());
+
+} // namespace WignerSymbols
+
+#endif // WIGNER_SYMBOLS_ASYNC_FAMILIES_H
@@ -0,0 +1,87 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html.              -/
+ ********************************************************/
+
+#ifndef WIGNER_SYMBOLS_BISPECTRUM_H
+#define WIGNER_SYMBOLS_BISPECTRUM_H
+
+/** \file bispectrum.h
+ *
+ * \author Joey Dumont <joey.dumont@gmail.com>
+ *
+ * \since 2026-10-18
+ *
+ * \brief Defines the batched computation of SO(3)-invariant bispectra.
+ *
+ * A local environment is described by the coefficients c_lm of the expansion
+ * of its density in spherical harmonics, for l = 0, ..., lmax. Its bispectrum
+ * is the set of rotation invariants
+ *
+ *   B(l1,l2,l) = sum_{m1,m2} <l1 m1 l2 m2|l m> c_{l1 m1} c_{l2 m2} conj(c_{l m}),
+ *
+ * with m = m1+m2, for l1 <= l2 <= lmax and |l1-l2| <= l <= min(l1+l2,lmax).
+ * For fixed l1, l2, l and m1, the terms of the sum are contiguous in m2, both
+ * in the Clebsch-Gordan coefficients and in the coefficients of the
+ * environment. We compute the Clebsch-Gordan coefficients once per lmax,
+ * one family in l per (l1,l2,m1,m2), and store them as such rows.
+ *
+ * The environments are then contracted bispectrumWidth at a time, with the
+ * coefficients of the group interleaved, so that the inner loops of the
+ * vectorized kernel run across environments. The groups are distributed
+ * among threads.
+ *
+ */
+
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+#include "workStealing.h"
+
+namespace WignerSymbols {
+
+/*! Clebsch-Gordan coefficients needed by the bispectra up to lmax. The
+ * descriptor t couples l1[t], l2[t] and l[t]. Its rows, described in
+ * Kernels::bispectrum, are [rowBegin[t], rowBegin[t+1]). */
+struct BispectrumPlan
+{
+  int lmax;
+  std::vector<int>    l1, l2, l;
+  std::vector<int>    rowBegin;
+  std::vector<int>    rows;
+  std::vector<double> cg;
+
+  /*! Number of descriptors of an environment. */
+  std::size_t size() const { return l.size(); }
+
+  /*! Number of coefficients of an environment, (lmax+1)^2. */
+  std::size_t coefficients() const { return (std::size_t)(lmax+1)*(lmax+1); }
+};
+
+/*! Computes the plan of the bispectra up to lmax. */
+BispectrumPlan bispectrumPlan(int lmax);
+
+/*! Computes the bispectra of count environments. The coefficients of
+ * environment e start at coefficients[e*plan.coefficients()], with c_lm at
+ * index l*l+l+m. descriptors[e*plan.size()+t] receives the real part of its
+ * descriptor t, which is the bispectrum itself for real densities. The
+ * groups of environments are distributed among nthreads threads (0 for all
+ * the hardware threads). If stats is not null, it is filled with the activity
+ * of each thread. */
+void bispectrum(const BispectrumPlan& plan, std::size_t count,
+                const std::complex<double>* coefficients, double* descriptors,
+                unsigned int nthreads = 0, SchedulerStats* stats = 0);
+
+/*! Same as above, for the environments stored one after the other in
+ * coefficients. Returns an empty vector if its size is not a multiple of
+ * plan.coefficients(). */
+std::vector<double> bispectrum(const BispectrumPlan& plan,
+                               const std::vector<std::complex<double> >& coefficients,
+                               unsigned int nthreads = 0, SchedulerStats* stats = 0);
+
+} // namespace WignerSymbols
+
+#endif // WIGNER_SYMBOLS_BISPECTRUM_H
@@ -0,0 +1,53 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html.              -/
+ ********************************************************/
+
+#ifndef WIGNER_SYMBOLS_CLOSED_FORMS_H
+#define WIGNER_SYMBOLS_CLOSED_FORMS_H
+
+/** \file closedForms.h
+ *
+ * \author Joey Dumont <joey.dumont@gmail.com>
+ *
+ * \since 2026-10-18
+ *
+ * \brief Defines closed-form Wigner-3j symbols for small l2.
+ *
+ * Most couplings in practice involve a dipole or quadrupole operator, i.e.
+ * l2 <= 2. The families then hold at most five symbols, and running the
+ * recursion, with its allocation and normalization, costs much more than
+ * evaluating the Racah formula directly. When l2 is small, the Racah sum has
+ * at most 2*l2+1 terms, and the large factorials pair up into ratios of
+ * factorials whose arguments differ by at most a few units. We compute these
+ * ratios as short products, which keeps the formula accurate for large l1
+ * and l3.
+ *
+ * The default entry points wigner3j() and clebschGordan() use these
+ * functions automatically when l2 <= 2.
+ *
+ */
+
+#include <vector>
+
+namespace WignerSymbols {
+
+/*! Largest l2 for which we use the closed forms. */
+const double closedFormMaxL2 = 2.0;
+
+/*! Computes the Wigner-3j symbol for given l1,l2,l3,m1,m2,m3 with the
+ * Racah formula. The selection rules must hold, and l2 must not exceed
+ * closedFormMaxL2. */
+double wigner3j_closedForm(double l1, double l2, double l3,
+						double m1, double m2, double m3);
+
+/*! Computes the Wigner-3j symbols with all possible values of l1 with the
+ * Racah formula, under the same conditions. */
+std::vector<double> wigner3j_closedForm(double l2, double l3,
+						double m1, double m2, double m3);
+
+} // namespace WignerSymbols
+
+#endif // WIGNER_SYMBOLS_CLOSED_FORMS_H
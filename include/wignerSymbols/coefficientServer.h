@@ -0,0 +1,174 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html.              -/
+ ********************************************************/
+
+#ifndef WIGNER_SYMBOLS_COEFFICIENT_SERVER_H
+#define WIGNER_SYMBOLS_COEFFICIENT_SERVER_H
+
+/** \file coefficientServer.h
+ *
+ * \author Joey Dumont <joey.dumont@gmail.com>
+ *
+ * \since 2026-10-18
+ *
+ * \brief Defines a local server of Wigner symbols over a Unix domain socket.
+ *
+ * Several programs running on the same node often need the same symbols. A
+ * single server holds a cache of families shared by all of them, and
+ * answers batches of 3j, 6j and Clebsch-Gordan requests.
+ *
+ * The cache is reduced by symmetry. A 3j symbol is served from the family
+ * in l1 of (l2 l3; m1 m2 m3), which we bring to l2 >= l3 by the exchange of
+ * the last two columns and to m1 >= 0 by the reversal of the projections,
+ * with the phase (-1)^(l1+l2+l3) for each. A 6j symbol is brought to the
+ * orientation of the tetrahedral group whose family (l2,...,l6) is the
+ * smallest, as in Wigner6jCache, and served from that family. The families
+ * of the tables up to a given lmax may be computed when the server starts;
+ * they are never evicted. The other families are kept in a FamilyCache,
+ * which evicts the least recently used ones.
+ *
+ * Protocol. All the integers are 32-bit, in the byte order of the machine,
+ * since the server only accepts local connections. The angular momenta are
+ * sent as twice their value, so that half-integers are exact. A request is
+ * the header {magic, kind, count} followed by count groups of six integers:
+ *   - 3j: 2l1, 2l2, 2l3, 2m1, 2m2, 2m3;
+ *   - 6j: 2l1, ..., 2l6;
+ *   - Clebsch-Gordan <l1 m1 l2 m2|L M>: 2l1, 2l2, 2L, 2m1, 2m2, 2M.
+ * The reply is the header {magic, status, count} followed by count doubles.
+ * A connection may carry any number of requests. On a malformed request,
+ * one with an argument above the lmax of the server in absolute value, or
+ * one that the server fails to answer, the server replies with an error
+ * status and closes the connection.
+ *
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <stdint.h>
+
+namespace WignerSymbols {
+
+const uint32_t coefficientRequestMagic = 0x51525357; // "WSRQ"
+const uint32_t coefficientReplyMagic   = 0x53525357; // "WSRS"
+
+/*! Largest number of symbols in a request. */
+const uint32_t coefficientMaxBatch = 1u << 20;
+
+enum CoefficientKind
+{
+  Wigner3jKind      = 1,
+  Wigner6jKind      = 2,
+  ClebschGordanKind = 3
+};
+
+enum CoefficientStatus
+{
+  CoefficientOk          = 0,
+  CoefficientBadRequest  = 1,
+  CoefficientServerError = 2
+};
+
+struct CoefficientRequestHeader
+{
+  uint32_t magic;
+  uint32_t kind;
+  uint32_t count;
+};
+
+struct CoefficientReplyHeader
+{
+  uint32_t magic;
+  uint32_t status;
+  uint32_t count;
+};
+
+struct CoefficientServerOptions
+{
+  CoefficientServerOptions();
+
+  std::string socketPath;
+  int         lmax;           //!< Largest angular momentum served, at most 2^28.
+  std::size_t cacheFamilies;  //!< Families kept besides the precomputed ones.
+  int         precompute3j;   //!< Precompute the 3j families up to this lmax (-1: none).
+  int         precompute6j;   //!< Precompute the 6j families up to this lmax (-1: none).
+};
+
+struct CoefficientServerStats
+{
+  unsigned long long connections;
+  unsigned long long requests;
+  unsigned long long symbols;
+  unsigned long long hits;        //!< Symbols served from a cached family.
+  unsigned long long misses;      //!< Families computed on request.
+  std::size_t        families;    //!< Families in the cache.
+  std::size_t        pinned;      //!< Precomputed families in the cache.
+};
+
+/*! Server of Wigner symbols. Each connection is served by its own thread. */
+class CoefficientServer
+{
+public:
+  explicit CoefficientServer(const CoefficientServerOptions& options);
+  ~CoefficientServer();
+
+  /*! Precomputes the requested tables, binds the socket and starts serving.
+   * Returns false and sets error if the socket cannot be bound. */
+  bool start(std::string* error = 0);
+
+  /*! Closes the socket and all the connections, and waits for their
+   * threads. The socket file is removed. */
+  void stop();
+
+  /*! Evaluates count symbols of the given kind, from their doubled
+   * arguments, with the cache of the server. Returns false, with the
+   * values unspecified, if an argument exceeds lmax in absolute value. */
+  bool evaluate(uint32_t kind, const int32_t* args, std::size_t count, double* values);
+
+  CoefficientServerStats stats() const;
+
+private:
+  CoefficientServer(const CoefficientServer&);
+  CoefficientServer& operator=(const CoefficientServer&);
+
+  struct State;
+  std::unique_ptr<State> state;
+};
+
+/*! Connection to a CoefficientServer. The requests of a client are sent one
+ * at a time; use one client per thread. */
+class CoefficientClient
+{
+public:
+  CoefficientClient();
+  ~CoefficientClient();
+
+  /*! Connects to the server at socketPath. */
+  bool connect(const std::string& socketPath, std::string* error = 0);
+  void close();
+
+  /*! Sends count symbols of the given kind, with six doubled arguments
+   * each, and waits for their values. Returns false if the connection
+   * failed or the request was rejected. */
+  bool evaluate(uint32_t kind, const int32_t* args, std::size_t count, double* values);
+
+  /*! Same as above, with the arguments as given to wigner3j(l1,...,m3),
+   * wigner6j(l1,...,l6) or clebschGordan(l1,l2,L,m1,m2,M). */
+  bool evaluate(uint32_t kind, const std::vector<double>& args, std::vector<double>& values);
+
+private:
+  CoefficientClient(const CoefficientClient&);
+  CoefficientClient& operator=(const CoefficientClient&);
+
+  int fd;
+};
+
+} // namespace WignerSymbols
+
+#endif // WIGNER_SYMBOLS_COEFFICIENT_SERVER_H
@@ -0,0 +1,117 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html.              -/
+ ********************************************************/
+
+#ifndef WIGNER_SYMBOLS_FAMILY_CACHE_H
+#define WIGNER_SYMBOLS_FAMILY_CACHE_H
+
+/** \file familyCache.h
+ *
+ * \author Joey Dumont <joey.dumont@gmail.com>
+ *
+ * \since 2026-10-18
+ *
+ * \brief Defines the cache of families shared by several threads.
+ *
+ * Wigner6jCache and CoefficientServer both keep families in l1, keyed by
+ * their doubled arguments, so that half-integers are exact. The cache is
+ * split in shards, each with its own lock and its own share of the limits,
+ * so that threads rarely wait for each other. The families are computed
+ * outside of the locks. Each shard evicts its least recently used families
+ * when it exceeds its share of the byte budget or of the number of
+ * families. Pinned families are never evicted, and count against neither.
+ *
+ */
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <stdint.h>
+
+namespace WignerSymbols {
+
+typedef std::shared_ptr<const std::vector<double> > SharedFamily;
+
+/*! Largest angular momentum of a cached family, so that the doubled
+ * arguments and their sums fit in 32 bits. */
+const int familyLmaxLimit = 1 << 28;
+
+/*! Doubled parameters of a family in l1: (2l2,2l3,2m1,2m2,2m3) for the 3j
+ * symbols and (2l2,...,2l6) for the 6j symbols. */
+struct FamilyKey
+{
+  int32_t symbol;   //!< 3 or 6.
+  int32_t p[5];
+
+  bool operator==(const FamilyKey& other) const;
+};
+
+struct FamilyKeyHash
+{
+  std::size_t operator()(const FamilyKey& key) const;
+};
+
+/*! Triangle rule on doubled momenta, with an integer sum. The sums are
+ * formed in 64 bits, since the arguments may come from other processes. */
+bool doubledTriad(int64_t ja, int64_t jb, int64_t jc);
+
+/*! Brings the doubled 6j symbol {j1 j2 j3; j4 j5 j6} to the orientation of
+ * the tetrahedral group whose family (j2,...,j6) is the smallest, ties
+ * being broken by j1. Writes the family to key.p and j1 to first. */
+void canonicalWigner6j(const int32_t* j, int32_t& first, FamilyKey& key);
+
+/*! Computes the family of key with the Scaled recursion. */
+SharedFamily computeFamily(const FamilyKey& key);
+
+struct FamilyCacheStats
+{
+  unsigned long long hits;
+  unsigned long long misses;
+  unsigned long long evictions;
+  unsigned long long contended;   //!< Lookups that waited for the lock of their shard.
+  std::size_t        families;
+  std::size_t        pinned;
+  std::size_t        bytes;       //!< Memory held by the evictable families, with their bookkeeping.
+};
+
+class FamilyCache
+{
+public:
+  static const int shards = 64;
+
+  /*! Cache holding at most about byteBudget bytes and maxFamilies families,
+   * besides the pinned ones. A family larger than the share of a shard,
+   * byteBudget/64, is computed but not kept. */
+  FamilyCache(std::size_t byteBudget, std::size_t maxFamilies);
+  ~FamilyCache();
+
+  /*! Inserts a family that is never evicted. */
+  void pin(const FamilyKey& key, const SharedFamily& family);
+
+  /*! Returns the family of key, computing it on a miss. */
+  SharedFamily get(const FamilyKey& key, bool* miss = 0);
+
+  /*! Returns the symbol at index in the family of key. A hit reads it under
+   * the lock of the shard, without sharing the ownership of the family. */
+  double value(const FamilyKey& key, std::size_t index, bool* miss = 0);
+
+  FamilyCacheStats stats() const;
+
+  /*! Removes all the families, pinned ones included, and resets the counters. */
+  void clear();
+
+private:
+  FamilyCache(const FamilyCache&);
+  FamilyCache& operator=(const FamilyCache&);
+
+  struct State;
+  std::unique_ptr<State> state;
+};
+
+} // namespace WignerSymbols
+
+#endif // WIGNER_SYMBOLS_FAMILY_CACHE_H
@@ -0,0 +1,78 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html.              -/
+ ********************************************************/
+
+#ifndef WIGNER_SYMBOLS_FAMILY_WALKER_H
+#define WIGNER_SYMBOLS_FAMILY_WALKER_H
+
+/** \file familyWalker.h
+ *
+ * \author Joey Dumont <joey.dumont@gmail.com>
+ *
+ * \since 2026-10-18
+ *
+ * \brief Defines the update of 3j families along a diagonal of projections.
+ *
+ * Sweeps over the projections need the families in l1 of (l2 l3; m1 m2 m3),
+ * then of (l2 l3; m1 m2-1 m3+1), and so on, with m1 fixed. Each call to
+ * wigner3j() runs a full recursion from new seeds. We instead step from one
+ * family to the next with the ladder relations
+ *
+ *   sum_i sqrt((li-mi)(li+mi+1)) (l1 l2 l3; m + e_i) = 0,  m1+m2+m3 = -1,
+ *   sum_i sqrt((li+mi)(li-mi+1)) (l1 l2 l3; m - e_i) = 0,  m1+m2+m3 = +1,
+ *
+ * which hold for every l1. They relate F = (m1, m2, m3) to its neighbour
+ * on the diagonal through the partner family H = (m1+1, m2-1, m3):
+ *
+ *   F' = -(a1 H + a2 F)/a3,   H' = -(a1 F' + a3 H)/b2,
+ *
+ * with a1 = sqrt((l1-m1)(l1+m1+1)), a2 = sqrt((l2-m2+1)(l2+m2)),
+ * a3 = sqrt((l3-m3)(l3+m3+1)) and b2 = sqrt((l2+m2-1)(l2-m2+2)). A step is
+ * thus two scaled sums of vectors. Only a1 depends on l1; it is computed
+ * once. Where a symbol decays along the diagonal, as in the classically
+ * forbidden region of small l1, the steps amplify its rounding errors.
+ * The normalization sum barely sees them, since the symbols there are
+ * small. We instead carry a bound on the error of each symbol, propagated
+ * with the absolute values of the step coefficients. When the largest
+ * bound exceeds the tolerance, relative to the largest symbol, both
+ * families are recomputed with the full recursion.
+ *
+ */
+
+#include <cstddef>
+#include <vector>
+
+namespace WignerSymbols {
+
+struct Wigner3jWalker
+{
+  double l2, l3, m1, m2, m3;
+  double l1min;                 //!< max(|l2-l3|,|m1|).
+  double tolerance;
+  std::vector<double> values;   //!< wigner3j(l2,l3,m1,m2,m3), for l1 from l1min.
+  std::vector<double> partner;  //!< (l1 l2 l3; m1+1 m2-1 m3), on the same l1.
+  std::vector<double> a1;       //!< sqrt((l1-m1)(l1+m1+1)), on the same l1.
+  std::vector<double> errorF;   //!< Bounds on the errors of values.
+  std::vector<double> errorH;   //!< Bounds on the errors of partner.
+
+  double      errorBound;       //!< Largest of errorF, relative to the largest value.
+  std::size_t steps;
+  std::size_t reseeds;          //!< Steps that recomputed the families.
+};
+
+/*! Starts a walk at the family wigner3j(l2,l3,-m2-m3,m2,m3). The families
+ * are recomputed whenever the error bound exceeds tolerance.
+ * The walker has no values if the projections are not allowed. */
+Wigner3jWalker wigner3jWalker(double l2, double l3, double m2, double m3,
+                              double tolerance = 1.0e-10);
+
+/*! Moves the walker to the family of (m2-1, m3+1). Returns false, without
+ * moving, at the end of the diagonal. */
+bool step(Wigner3jWalker& walker);
+
+} // namespace WignerSymbols
+
+#endif // WIGNER_SYMBOLS_FAMILY_WALKER_H
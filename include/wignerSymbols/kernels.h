@@ -0,0 +1,125 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html.              -/
+ ********************************************************/
+
+#ifndef WIGNER_SYMBOLS_KERNELS_H
+#define WIGNER_SYMBOLS_KERNELS_H
+
+/** \file kernels.h
+ *
+ * \author Joey Dumont <joey.dumont@gmail.com>
+ *
+ * \since 2026-10-18
+ *
+ * \brief Defines the vectorized kernels of the recursion, selected at run time.
+ *
+ * The library is built for the baseline instruction set of the target, so
+ * that it runs on any machine of the architecture. The loops that vectorize,
+ * namely the tabulation of the recursion coefficients and the normalization
+ * of the families, are compiled once per instruction set. We pick the best
+ * variant supported by the processor when the library is loaded. The
+ * environment variable WIGNER_SYMBOLS_ISA (baseline, avx2 or avx512) forces
+ * a given variant; an unsupported choice falls back to the best supported one.
+ *
+ */
+
+#include <cstddef>
+#include <stdint.h>
+
+namespace WignerSymbols {
+
+/*! Number of environments contracted at once by the bispectrum kernel. */
+const int bispectrumWidth = 8;
+
+enum InstructionSet
+{
+  Baseline,
+  AVX2,
+  AVX512
+};
+
+/*! Table of the kernels compiled for one instruction set. */
+struct Kernels
+{
+  /*! Fills A[k] and B[k] with wigner3j_auxA and wigner3j_auxB at
+   * l1 = l1min+k, for k in [0,n). */
+  void   (*wigner3jCoefficients)(double l1min, int n,
+                                 double l2, double l3, double m1, double m2, double m3,
+                                 double* A, double* B);
+
+  /*! Same as above with wigner6j_auxA and wigner6j_auxB. */
+  void   (*wigner6jCoefficients)(double l1min, int n,
+                                 double l2, double l3, double l4, double l5, double l6,
+                                 double* A, double* B);
+
+  /*! Same as wigner3jCoefficients, given the m-independent part of A,
+   * S[k] = sqrt((l1^2-(l2-l3)^2)((l2+l3+1)^2-l1^2)) at l1 = l1min+k. */
+  void   (*wigner3jPlanCoefficients)(double l1min, int n, const double* S,
+                                     double l2, double l3, double m1, double m2, double m3,
+                                     double* A, double* B);
+
+  /*! Fills B[k] = C[k]-2(2l1+1)l1(l1+1)l4(l4+1) at l1 = l1min+k, where C
+   * holds the l4-independent part of wigner6j_auxB. */
+  void   (*wigner6jPlanCoefficients)(double l1min, int n, const double* C, double l4, double* B);
+
+  /*! Returns the sum of (2l1+1)f[k]^2 with l1 = l1min+k, for k in [0,n). */
+  double (*normalizationSum)(const double* f, int n, double l1min);
+
+  /*! Multiplies f[k] by c, for k in [0,n). */
+  void   (*scale)(double* f, int n, double c);
+
+  /*! Converts the n stored symbols to double precision. The 16-bit values
+   * are multiplied by scale. */
+  void   (*dequantizeFloat)(const float* in, int n, double* out);
+  void   (*dequantizeFixed16)(const int16_t* in, int n, double scale, double* out);
+
+  /*! Sets out[i] to the symbol index[i] of the family family[i], where the
+   * family k starts at offsets[k] in values. The 16-bit values of the
+   * family k are multiplied by scales[k]. */
+  void   (*gatherDouble)(const double* values, const std::size_t* offsets,
+                         const std::size_t* family, const int* index, int n, double* out);
+  void   (*gatherFloat)(const float* values, const std::size_t* offsets,
+                        const std::size_t* family, const int* index, int n, double* out);
+  void   (*gatherFixed16)(const int16_t* values, const float* scales, const std::size_t* offsets,
+                          const std::size_t* family, const int* index, int n, double* out);
+
+  /*! Contracts the coefficients of bispectrumWidth environments. The rows
+   * [rowBegin[t], rowBegin[t+1]) of descriptor t each hold four indices
+   * (i1, i2, il, n), and consume the next n entries of cg. A row adds
+   * c[i1]*sum_k cg[k]*c[i2+k]*conj(c[il+k]) to the descriptor. re[i*W+e]
+   * and im[i*W+e] hold coefficient i of environment e, and out[t*W+e]
+   * receives the real part of descriptor t, where W = bispectrumWidth. */
+  void   (*bispectrum)(int ntriples, const int* rowBegin, const int* rows, const double* cg,
+                       const double* re, const double* im, double* out);
+
+  /*! Moves a Wigner3jWalker one step down its diagonal. F and H hold the
+   * family and its partner, eF and eH bounds on their errors, and a1 the
+   * ladder coefficients in l1. f, h, g and k are the coefficients of the
+   * step. Writes the largest |F| and the largest error bound after it. */
+  void   (*walkerStep)(int n, const double* a1, double f, double h, double g, double k,
+                       double* F, double* H, double* eF, double* eH,
+                       double* largest, double* error);
+};
+
+/*! Returns the kernels selected when the library was loaded. */
+const Kernels& kernels();
+
+/*! Returns the kernels compiled for the given instruction set. They must
+ * only be called if instructionSetSupported(isa) is true. */
+const Kernels& kernels(InstructionSet isa);
+
+/*! Instruction set of the kernels returned by kernels(). */
+InstructionSet activeInstructionSet();
+
+/*! Whether the processor and the build support the instruction set. */
+bool instructionSetSupported(InstructionSet isa);
+
+/*! Name of the instruction set, as accepted by WIGNER_SYMBOLS_ISA. */
+const char* instructionSetName(InstructionSet isa);
+
+} // namespace WignerSymbols
+
+#endif // WIGNER_SYMBOLS_KERNELS_H
@@ -0,0 +1,70 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html.              -/
+ ********************************************************/
+
+#ifndef WIGNER_SYMBOLS_M_ENUMERATORS_H
+#define WIGNER_SYMBOLS_M_ENUMERATORS_H
+
+/** \file mEnumerators.h
+ *
+ * \author Joey Dumont <joey.dumont@gmail.com>
+ *
+ * \since 2026-10-18
+ *
+ * \brief Defines the enumeration of the nonzero terms of sums over projections.
+ *
+ * Sums such as sum_{m1,m2} (l1 l2 l3; m1 m2 m3)^2 are often written as two
+ * loops over m1 and m2, filtered by m1+m2+m3 = 0, with one scalar evaluation
+ * per term. For given l1, l2, l3 and m3, the allowed m1 form a single range,
+ * and the symbols (l1 l2 l3; m1 -m1-m3 m3) = (l3 l1 l2; m3 m1 -m1-m3) are a
+ * family of the recursion in the projection computed by wigner3j_m(). We
+ * visit the allowed terms with the symbols of that family.
+ *
+ */
+
+#include <cstddef>
+#include <vector>
+
+namespace WignerSymbols {
+
+/*! Symbols (l1 l2 l3; m1 m2 m3) with m1+m2+m3 = 0, for given l1, l2, l3 and
+ * m3. The term i has m1 = m1min+i and m2 = -m3-m1. */
+struct Wigner3jMTerms
+{
+  double l1, l2, l3, m3;
+  double m1min;
+  std::vector<double> values;
+
+  std::size_t size() const { return values.size(); }
+  double m1(std::size_t i) const { return m1min+i; }
+  double m2(std::size_t i) const { return -m3-m1min-i; }
+};
+
+/*! Computes the symbols of all the allowed (m1,m2) in a single sweep. There
+ * are none if the selection rules are not satisfied. */
+Wigner3jMTerms wigner3jMTerms(double l1, double l2, double l3, double m3);
+
+/*! Calls visit(m1,m2,value) for the allowed (m1,m2), in increasing m1. */
+template <typename Visit>
+void forEachWigner3jM(double l1, double l2, double l3, double m3, Visit visit)
+{
+  Wigner3jMTerms terms = wigner3jMTerms(l1,l2,l3,m3);
+  for (std::size_t i=0;i<terms.size();i++)
+    visit(terms.m1(i),terms.m2(i),terms.values[i]);
+}
+
+/*! Calls visit(m1,m2,m3,value) for all the allowed projections of l1, l2
+ * and l3, in increasing m3 then m1. One sweep is done per m3. */
+template <typename Visit>
+void forEachWigner3jM(double l1, double l2, double l3, Visit visit)
+{
+  for (double m3=-l3;m3<=l3;m3+=1.0)
+    forEachWigner3jM(l1,l2,l3,m3,[&](double m1, double m2, double value) { visit(m1,m2,m3,value); });
+}
+
+} // namespace WignerSymbols
+
+#endif // WIGNER_SYMBOLS_M_ENUMERATORS_H
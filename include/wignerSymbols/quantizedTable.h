@@ -0,0 +1,103 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html.              -/
+ ********************************************************/
+
+#ifndef WIGNER_SYMBOLS_QUANTIZED_TABLE_H
+#define WIGNER_SYMBOLS_QUANTIZED_TABLE_H
+
+/** \file quantizedTable.h
+ *
+ * \author Joey Dumont <joey.dumont@gmail.com>
+ *
+ * \since 2026-10-18
+ *
+ * \brief Defines tables of Wigner symbols stored in reduced precision.
+ *
+ * We store the families of a table either in double precision, in single
+ * precision, or in 16-bit fixed point. In the last case, each family has
+ * its own scale 2^(e-15), where 2^e is the smallest power of two larger
+ * than the magnitude of its symbols, so that the symbols are stored as
+ * integers between -32768 and 32767.
+ *
+ * The errors are bounded relative to the largest symbol of the family,
+ * M = max |f(l1)|:
+ *   - single precision: rounding to nearest gives |err| <= 2^-24 |f| for
+ *     normal numbers, and at most 2^-150 for the subnormal ones, hence
+ *     |err| <= 2^-24 M, since M is far above the subnormal range;
+ *   - 16-bit fixed point: rounding to nearest gives |err| <= 2^(e-16), and
+ *     at most 2^(e-15) for the symbols clamped to 32767. Since
+ *     M >= 2^(e-1), |err| <= 2^-14 M.
+ * The tables also record the largest error actually made.
+ *
+ * The symbols are converted back to double precision by vectorized
+ * kernels, either a whole family at a time or by gathering arbitrary
+ * symbols of the table.
+ *
+ */
+
+#include <cstddef>
+#include <vector>
+
+#include <stdint.h>
+
+#include "tableGenerator.h"
+
+namespace WignerSymbols {
+
+enum TableStorage
+{
+  DoubleStorage,   //!< 8 bytes per symbol, exact.
+  Float32Storage,  //!< 4 bytes per symbol, |err| <= 2^-24 M.
+  Fixed16Storage   //!< 2 bytes per symbol and 4 per family, |err| <= 2^-14 M.
+};
+
+/*! Bound on the error of a storage mode, relative to the largest symbol of
+ * the family. */
+double storageErrorBound(TableStorage storage);
+
+/*! Families of Wigner symbols stored in one of the storage modes. The family
+ * k spans [offsets[k], offsets[k+1]) of the array of its storage mode. */
+struct QuantizedTable
+{
+  TableStorage             storage;
+  std::vector<std::size_t> offsets;
+  std::vector<double>      doubles;
+  std::vector<float>       floats;
+  std::vector<int16_t>     fixed;
+  std::vector<float>       scales;    //!< Scale of each family, in Fixed16Storage.
+  double                   maxError;  //!< Largest error made, relative to the largest symbol of its family.
+
+  std::size_t families() const { return (offsets.empty() ? 0 : offsets.size()-1); }
+
+  /*! Number of bytes taken by the symbols and the scales. */
+  std::size_t bytes() const;
+
+  /*! Symbol i of family k. */
+  double operator()(std::size_t k, int i) const;
+
+  /*! Writes the symbols of family k to out. */
+  void family(std::size_t k, double* out) const;
+
+  /*! Sets out[j] to the symbol index[j] of the family family[j], for j in
+   * [0,n). */
+  void gather(const std::size_t* family, const int* index, std::size_t n, double* out) const;
+};
+
+/*! Stores a table computed by wigner3jTable() or wigner6jTable(). */
+QuantizedTable quantizeTable(const std::vector<double>& table, const std::vector<std::size_t>& offsets,
+                             TableStorage storage);
+
+/*! Computes the families using nthreads threads (0 for all the hardware
+ * threads), and stores each of them as soon as it is computed, so that the
+ * table is never held in double precision. */
+QuantizedTable wigner3jQuantizedTable(const std::vector<Wigner3jFamily>& families, TableStorage storage,
+                                      unsigned int nthreads = 0, SchedulerStats* stats = 0);
+QuantizedTable wigner6jQuantizedTable(const std::vector<Wigner6jFamily>& families, TableStorage storage,
+                                      unsigned int nthreads = 0, SchedulerStats* stats = 0);
+
+} // namespace WignerSymbols
+
+#endif // WIGNER_SYMBOLS_QUANTIZED_TABLE_H
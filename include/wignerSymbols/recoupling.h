@@ -0,0 +1,65 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html.              -/
+ ********************************************************/
+
+#ifndef WIGNER_SYMBOLS_RECOUPLING_H
+#define WIGNER_SYMBOLS_RECOUPLING_H
+
+/** \file recoupling.h
+ *
+ * \author Joey Dumont <joey.dumont@gmail.com>
+ *
+ * \since 2026-10-18
+ *
+ * \brief Defines the recoupling matrices of three angular momenta.
+ *
+ * The matrix element between the coupling schemes ((j1 j2)j12 j3)J and
+ * (j1 (j2 j3)j23)J reads
+ *
+ *   (-1)^(j1+j2+j3+J) sqrt((2j12+1)(2j23+1)) {j1 j2 j12; j3 J j23}.
+ *
+ * By the symmetries of the 6j symbol, {j1 j2 j12; j3 J j23} is the element
+ * j23 of the family wigner6j(j3,j2,j12,j1,J). We thus fill each row of the
+ * matrix with a single call to the family function.
+ *
+ */
+
+#include <cstddef>
+#include <vector>
+
+#include "workStealing.h"
+
+namespace WignerSymbols {
+
+/*! Recoupling matrix for given j1, j2, j3 and J. The rows are indexed by
+ * j12 = j12min+r, the columns by j23 = j23min+c. The elements are stored in
+ * column-major order with leading dimension rows, as expected by BLAS and
+ * LAPACK. The matrix is orthogonal. */
+struct RecouplingMatrix
+{
+  double j1, j2, j3, J;
+  double j12min, j23min;
+  int    rows, cols;
+  std::vector<double> data;
+
+  double operator()(int r, int c) const { return data[r+(std::size_t)c*rows]; }
+};
+
+/*! Computes the recoupling matrix for given j1, j2, j3 and J. The matrix is
+ * empty if J cannot be reached. */
+RecouplingMatrix recouplingMatrix(double j1, double j2, double j3, double J);
+
+/*! Computes the recoupling matrices of all the total angular momenta J that
+ * j1, j2 and j3 can couple to, by increasing J. The blocks are distributed
+ * among nthreads threads (0 for all the hardware threads). If stats is not
+ * null, it is filled with the activity of each thread. */
+std::vector<RecouplingMatrix> recouplingMatrices(double j1, double j2, double j3,
+                                                 unsigned int nthreads = 0,
+                                                 SchedulerStats* stats = 0);
+
+} // namespace WignerSymbols
+
+#endif // WIGNER_SYMBOLS_RECOUPLING_H
@@ -0,0 +1,69 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html.              -/
+ ********************************************************/
+
+#ifndef WIGNER_SYMBOLS_SCRATCH_ARENA_H
+#define WIGNER_SYMBOLS_SCRATCH_ARENA_H
+
+/** \file scratchArena.h
+ *
+ * \author Joey Dumont <joey.dumont@gmail.com>
+ *
+ * \since 2026-10-18
+ *
+ * \brief Defines a growable scratch buffer reused by the scalar functions.
+ *
+ * The scalar functions compute a whole family of symbols to return a single
+ * element of it. Instead of allocating a new array on every call, they borrow
+ * storage from an arena attached to the calling thread. The arena only grows
+ * when a larger family is requested, so that repeated calls of comparable size
+ * do not touch the heap.
+ *
+ */
+
+#include <cstddef>
+
+namespace WignerSymbols {
+
+class ScratchArena
+{
+public:
+  ScratchArena();
+  ~ScratchArena();
+
+  /*! Returns a buffer that can hold at least n doubles. Its content is
+   * unspecified and it remains valid until the next call to reserve()
+   * or trim() on the same arena. */
+  double* reserve(std::size_t n);
+
+  /*! Number of doubles the arena can currently hold without allocating. */
+  std::size_t capacity() const { return cap; }
+
+  /*! Largest number of doubles requested since construction or since the
+   * last call to resetHighWaterMark(). */
+  std::size_t highWaterMark() const { return peak; }
+
+  /*! Releases the storage beyond n doubles. trim() frees everything. */
+  void trim(std::size_t n = 0);
+
+  /*! Resets the high-water mark. The storage is left untouched. */
+  void resetHighWaterMark() { peak = 0; }
+
+  /*! Returns the arena of the calling thread. */
+  static ScratchArena& local();
+
+private:
+  ScratchArena(const ScratchArena&);
+  ScratchArena& operator=(const ScratchArena&);
+
+  double*     buffer;
+  std::size_t cap;
+  std::size_t peak;
+};
+
+} // namespace WignerSymbols
+
+#endif // WIGNER_SYMBOLS_SCRATCH_ARENA_H
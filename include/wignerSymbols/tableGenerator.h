@@ -0,0 +1,77 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html.              -/
+ ********************************************************/
+
+#ifndef WIGNER_SYMBOLS_TABLE_GENERATOR_H
+#define WIGNER_SYMBOLS_TABLE_GENERATOR_H
+
+/** \file tableGenerator.h
+ *
+ * \author Joey Dumont <joey.dumont@gmail.com>
+ *
+ * \since 2026-10-18
+ *
+ * \brief Defines the parallel generation of tables of Wigner symbols.
+ *
+ * A table is a list of families, each computed by a single call to the
+ * family functions wigner3j(l2,l3,m1,m2,m3) or wigner6j(l2,l3,l4,l5,l6).
+ * The families are stored one after the other in a single array. The
+ * position of each family is known before the computation, so that the
+ * threads write their results without any locking.
+ *
+ */
+
+#include <cstddef>
+#include <vector>
+
+#include "workStealing.h"
+
+namespace WignerSymbols {
+
+/*! Parameters of a family of Wigner-3j symbols, as passed to wigner3j(l2,l3,m1,m2,m3). */
+struct Wigner3jFamily
+{
+  double l2, l3, m1, m2, m3;
+};
+
+/*! Parameters of a family of Wigner-6j symbols, as passed to wigner6j(l2,l3,l4,l5,l6). */
+struct Wigner6jFamily
+{
+  double l2, l3, l4, l5, l6;
+};
+
+/*! Number of coefficients in a family, i.e. the number of allowed values of l1. */
+std::size_t familySize(const Wigner3jFamily& family);
+std::size_t familySize(const Wigner6jFamily& family);
+
+/*! Estimated relative cost of the computation of a family. */
+double familyCost(const Wigner3jFamily& family);
+double familyCost(const Wigner6jFamily& family);
+
+/*! Lists the 3j families with integer 0 <= l3 <= l2 <= lmax in canonical
+ * order: by increasing l2, l3, m2 and m3. The other families follow from
+ * the exchange of the last two columns. */
+std::vector<Wigner3jFamily> wigner3jFamilies(int lmax);
+
+/*! Lists the 6j families with integer l2, ..., l6 <= lmax that satisfy the
+ * selection rules, in canonical order: by increasing l2, l3, l4, l5 and l6. */
+std::vector<Wigner6jFamily> wigner6jFamilies(int lmax);
+
+/*! Computes the given families using nthreads threads (0 for all the hardware
+ * threads). On return, the family k is stored between the indices offsets[k]
+ * and offsets[k+1]-1 of the returned array. If stats is not null, it is
+ * filled with the activity of each thread. */
+std::vector<double> wigner3jTable(const std::vector<Wigner3jFamily>& families,
+                                  std::vector<std::size_t>& offsets,
+                                  unsigned int nthreads = 0, SchedulerStats* stats = 0);
+
+std::vector<double> wigner6jTable(const std::vector<Wigner6jFamily>& families,
+                                  std::vector<std::size_t>& offsets,
+                                  unsigned int nthreads = 0, SchedulerStats* stats = 0);
+
+} // namespace WignerSymbols
+
+#endif // WIGNER_SYMBOLS_TABLE_GENERATOR_H
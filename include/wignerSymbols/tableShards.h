@@ -0,0 +1,101 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html.              -/
+ ********************************************************/
+
+#ifndef WIGNER_SYMBOLS_TABLE_SHARDS_H
+#define WIGNER_SYMBOLS_TABLE_SHARDS_H
+
+/** \file tableShards.h
+ *
+ * \author Joey Dumont <joey.dumont@gmail.com>
+ *
+ * \since 2026-10-18
+ *
+ * \brief Defines the generation of tables in shards, and their merging.
+ *
+ * A table too large for one node is split among several processes, for
+ * instance the ranks of an MPI job. We cut the canonical list of families
+ * into contiguous ranges of equal estimated cost, so that each process
+ * computes its range with wigner3jTable() or wigner6jTable() and writes it
+ * to its own file. Since the ranges are contiguous, the merged table is
+ * the concatenation of the shards in order.
+ *
+ * A shard file starts with a header holding the magic string "WIGSHARD",
+ * the format version, the kind of symbol, lmax, the position of the shard
+ * in the table and a checksum of its content. It is followed by an index,
+ * made of the parameters of the families and the offsets of their symbols,
+ * and by the symbols themselves. A merged table is written in the same
+ * format, as the single shard of a partition in one part.
+ *
+ */
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "tableGenerator.h"
+
+namespace WignerSymbols {
+
+/*! A contiguous range of the families of a table, with their symbols. */
+struct TableShard
+{
+  int                symbol;         //!< 3 or 6.
+  int                lmax;
+  int                part, parts;    //!< Position of the shard in the partition.
+  unsigned long long firstFamily;    //!< Index of the first family in the table.
+  unsigned long long totalFamilies;  //!< Number of families in the table.
+
+  std::vector<double>             parameters; //!< Five parameters per family.
+  std::vector<unsigned long long> offsets;    //!< Family k spans [offsets[k], offsets[k+1]).
+  std::vector<double>             values;
+
+  /*! Number of families in the shard. */
+  std::size_t families() const { return (offsets.empty() ? 0 : offsets.size()-1); }
+};
+
+/*! Cuts n = cost.size() tasks into parts contiguous ranges of nearly equal
+ * total cost. The range p is [bounds[p], bounds[p+1]). */
+std::vector<std::size_t> partitionFamilies(const std::vector<double>& cost, int parts);
+
+/*! Computes the part-th of parts shards of the table of wigner3jFamilies(lmax)
+ * or wigner6jFamilies(lmax), using nthreads threads (0 for all the hardware
+ * threads). */
+TableShard wigner3jShard(int lmax, int part, int parts,
+                         unsigned int nthreads = 0, SchedulerStats* stats = 0);
+TableShard wigner6jShard(int lmax, int part, int parts,
+                         unsigned int nthreads = 0, SchedulerStats* stats = 0);
+
+/*! Writes the shard to the file at path. Returns false and sets error if
+ * the file cannot be written. */
+bool writeTableShard(const std::string& path, const TableShard& shard, std::string* error = 0);
+
+/*! Reads the shard at path. Returns false and sets error if the file cannot
+ * be read, or if its checksum does not match. */
+bool readTableShard(const std::string& path, TableShard& shard, std::string* error = 0);
+
+struct ShardMergeStats
+{
+  bool               ok;        //!< False if the shards could not be merged.
+  std::string        error;     //!< Description of the error.
+  unsigned long long families;  //!< Families in the merged table.
+  unsigned long long values;    //!< Symbols in the merged table.
+  unsigned long long verified;  //!< Families recomputed and compared.
+  double             seconds;   //!< Wall time of the merge.
+};
+
+/*! Merges the shards of a table, given in any order, into the file at
+ * output. The shards are read one at a time. We check that they are the
+ * parts 0 to parts-1 of the same partition, that they cover the canonical
+ * families contiguously, and that their checksums and family parameters
+ * match. If verifyStride is not 0, every verifyStride-th family is also
+ * recomputed and compared to the merged one. */
+ShardMergeStats mergeTableShards(const std::vector<std::string>& shards, const std::string& output,
+                                 unsigned long long verifyStride = 0);
+
+} // namespace WignerSymbols
+
+#endif // WIGNER_SYMBOLS_TABLE_SHARDS_H
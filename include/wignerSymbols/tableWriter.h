@@ -0,0 +1,97 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html.              -/
+ ********************************************************/
+
+#ifndef WIGNER_SYMBOLS_TABLE_WRITER_H
+#define WIGNER_SYMBOLS_TABLE_WRITER_H
+
+/** \file tableWriter.h
+ *
+ * \author Joey Dumont <joey.dumont@gmail.com>
+ *
+ * \since 2026-10-18
+ *
+ * \brief Defines the streaming generation of 3j tables on disk.
+ *
+ * For large lmax, the table of 3j symbols does not fit in memory. We walk
+ * the families in the canonical order of wigner3jFamilies() without listing
+ * them, and group consecutive families into chunks of fixed uncompressed
+ * size. A writer thread compresses the chunks and appends them to the file,
+ * while the calling thread computes the next ones. The chunks circulate
+ * through a fixed pool of buffers, so that the memory used does not depend
+ * on lmax.
+ *
+ * After each chunk, we record a checkpoint next to the table, so that an
+ * interrupted run can be resumed from the last complete chunk.
+ *
+ * The file starts with the magic string "WIGNER3J", the format version and
+ * lmax. Each chunk has a header holding the number of its families, the
+ * index and parameters of its first family, and its uncompressed and stored
+ * sizes, followed by the symbols of its families. When the library is built
+ * with zlib, the bytes of the symbols are shuffled and compressed.
+ *
+ */
+
+#include <cstddef>
+#include <functional>
+#include <string>
+
+#include "tableGenerator.h"
+
+namespace WignerSymbols {
+
+/*! Position in the canonical order of the 3j families with integer
+ * 0 <= l3 <= l2 <= lmax. */
+struct Wigner3jFamilyCursor
+{
+  int l2, l3, m2, m3;
+
+  /*! Parameters of the family at the cursor. */
+  Wigner3jFamily family() const;
+
+  /*! Moves to the next family. Returns false past the last one. */
+  bool next(int lmax);
+};
+
+struct TableWriterOptions
+{
+  TableWriterOptions();
+
+  std::size_t        chunkBytes;       //!< Uncompressed size of a chunk.
+  std::size_t        bufferedChunks;   //!< Number of chunks in the pool.
+  int                compressionLevel; //!< zlib level, 0 to store the chunks as is.
+  bool               resume;           //!< Resume from the checkpoint, if any.
+  unsigned long long maxFamilies;      //!< Stop after this many families (0: no limit).
+};
+
+struct TableWriterStats
+{
+  bool               ok;            //!< False if an I/O error occurred.
+  std::string        error;         //!< Description of the error.
+  bool               complete;      //!< The table holds all the families.
+  unsigned long long families;      //!< Families written by this run.
+  unsigned long long chunks;        //!< Chunks written by this run.
+  unsigned long long rawBytes;      //!< Uncompressed bytes written by this run.
+  unsigned long long storedBytes;   //!< Bytes written to disk by this run.
+  std::size_t        bufferBytes;   //!< Memory held by the chunk buffers.
+  double             seconds;       //!< Wall time of the run.
+};
+
+/*! Computes the 3j families of wigner3jFamilies(lmax) and writes them to the
+ * file at path, in chunks. The checkpoint is written to path+".checkpoint".
+ * An I/O error stops the computation at the next family. */
+TableWriterStats writeWigner3jTable(int lmax, const std::string& path,
+                                    const TableWriterOptions& options = TableWriterOptions());
+
+/*! Reads a table written by writeWigner3jTable() and calls visit on each
+ * family, in order, with its symbols. visit may return false to stop.
+ * Returns false if the file is not a valid table. */
+bool readWigner3jTable(const std::string& path,
+                       const std::function<bool(const Wigner3jFamily&, const double*, std::size_t)>& visit);
+
+} // namespace WignerSymbols
+
+#endif // WIGNER_SYMBOLS_TABLE_WRITER_H
@@ -0,0 +1,70 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html.              -/
+ ********************************************************/
+
+#ifndef WIGNER_SYMBOLS_TENSOR_OPERATORS_H
+#define WIGNER_SYMBOLS_TENSOR_OPERATORS_H
+
+/** \file tensorOperators.h
+ *
+ * \author Joey Dumont <joey.dumont@gmail.com>
+ *
+ * \since 2026-10-18
+ *
+ * \brief Defines the application of spherical tensor operators to states.
+ *
+ * The basis is made of blocks |j m>, m = -j, ..., j, stacked in the order of
+ * a list of angular momenta j_b. By the Wigner-Eckart theorem, the component
+ * q of a tensor operator of rank k acts as
+ *
+ *   <j' m'|T^k_q|j m> = (-1)^(j'-m') (j' k j; -m' q m) <j'||T^k||j>,
+ *
+ * with m' = m+q. Rather than building the matrix, we visit the pairs of
+ * blocks (j',j) with a nonzero reduced matrix element. For each pair, the
+ * symbols (j' k j; -m' q m) = (k j j'; q m -m') are computed for all m at
+ * once with wigner3j_m(k,j,j',q), and applied to the block of the state.
+ * The working set of a pair is thus a few vectors of size 2j+1. The output
+ * blocks are distributed among threads, so that each thread writes to its
+ * own part of the result.
+ *
+ */
+
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+#include "workStealing.h"
+
+namespace WignerSymbols {
+
+/*! Offsets of the blocks of the basis with angular momenta j. The block b
+ * spans [offsets[b], offsets[b+1]), and offsets.back() is the dimension of
+ * the basis. */
+std::vector<std::size_t> tensorBasisOffsets(const std::vector<double>& j);
+
+/*! Applies the component q of the tensor operator of rank k to the state.
+ * reduced[r*n+c] is the reduced matrix element <j_r||T^k||j_c>, where n is
+ * the number of blocks. The output blocks are distributed among nthreads
+ * threads (0 for all the hardware threads). Returns an empty vector if the
+ * sizes do not match. */
+std::vector<double> applyTensorOperator(double k, double q,
+                                        const std::vector<double>& j,
+                                        const std::vector<double>& reduced,
+                                        const std::vector<double>& state,
+                                        unsigned int nthreads = 0,
+                                        SchedulerStats* stats = 0);
+
+/*! Same as above, for complex reduced matrix elements and states. */
+std::vector<std::complex<double> > applyTensorOperator(double k, double q,
+                                                       const std::vector<double>& j,
+                                                       const std::vector<std::complex<double> >& reduced,
+                                                       const std::vector<std::complex<double> >& state,
+                                                       unsigned int nthreads = 0,
+                                                       SchedulerStats* stats = 0);
+
+} // namespace WignerSymbols
+
+#endif // WIGNER_SYMBOLS_TENSOR_OPERATORS_H
@@ -0,0 +1,87 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html.              -/
+ ********************************************************/
+
+#ifndef WIGNER_SYMBOLS_WIGNER6J_CACHE_H
+#define WIGNER_SYMBOLS_WIGNER6J_CACHE_H
+
+/** \file wigner6jCache.h
+ *
+ * \author Joey Dumont <joey.dumont@gmail.com>
+ *
+ * \since 2026-10-18
+ *
+ * \brief Defines a cache of 6j families shared by several threads.
+ *
+ * Each scalar evaluation of wigner6j(l1,...,l6) computes the whole family
+ * wigner6j(l2,...,l6). Recoupling calculations ask for the same symbols
+ * many times, in different orientations. The 6j symbol is invariant under
+ * the 24 operations of the tetrahedral group: the permutations of its
+ * columns and the exchange of the upper and lower arguments of two of them.
+ * We bring each symbol to the orientation whose family (l2,...,l6) is the
+ * smallest, and look that family up in the cache, so that all the
+ * orientations of a symbol share one family.
+ *
+ * The families are kept in a FamilyCache bounded by a byte budget, which
+ * evicts the least recently used ones.
+ *
+ */
+
+#include <cstddef>
+#include <memory>
+
+namespace WignerSymbols {
+
+struct Wigner6jCacheStats
+{
+  unsigned long long hits;
+  unsigned long long misses;
+  unsigned long long evictions;
+  unsigned long long contended;   //!< Lookups that waited for the lock of their shard.
+  std::size_t        families;
+  std::size_t        bytes;       //!< Memory held by the families, with their bookkeeping.
+  std::size_t        byteBudget;
+
+  double hitRate() const { return hits+misses == 0 ? 0.0 : (double)hits/(hits+misses); }
+};
+
+class Wigner6jCache
+{
+public:
+  /*! Cache holding at most about byteBudget bytes. A family larger than the
+   * share of a shard, byteBudget/64, is computed but not kept. */
+  explicit Wigner6jCache(std::size_t byteBudget = 64u << 20);
+  ~Wigner6jCache();
+
+  /*! Same value as wigner6j(l1,l2,l3,l4,l5,l6). The symbols with an
+   * argument above familyLmaxLimit, 2^28, are rejected and return 0. */
+  double operator()(double l1, double l2, double l3,
+                    double l4, double l5, double l6);
+
+  Wigner6jCacheStats stats() const;
+
+  /*! Removes all the families and resets the counters. */
+  void clear();
+
+private:
+  Wigner6jCache(const Wigner6jCache&);
+  Wigner6jCache& operator=(const Wigner6jCache&);
+
+  struct State;
+  std::unique_ptr<State> state;
+};
+
+/*! Evaluates wigner6j(l1,...,l6) with a cache shared by the whole process,
+ * with the default budget. */
+double wigner6j_cached(double l1, double l2, double l3,
+                       double l4, double l5, double l6);
+
+/*! The cache used by wigner6j_cached(). */
+Wigner6jCache& sharedWigner6jCache();
+
+} // namespace WignerSymbols
+
+#endif // WIGNER_SYMBOLS_WIGNER6J_CACHE_H
@@ -26,6 +26,8 @@
  *		J. Math. Phys. 16, 1961 (1975).
  *  K. Schulten and R. G. Gordon, "Recursive evaluation of 3j and 6j coefficients,"
  *		Comput. Phys. Commun. 11, 269–278 (1976).
+ *  J. Luscombe and M. Luban, "Simplified recursive algorithm for Wigner 3j and 6j symbols,"
+ *		Phys. Rev. E 57, 7274–7277 (1998).
  */
 
 #include <cmath>
@@ -36,6 +38,39 @@
 
 namespace WignerSymbols {
 
+/*! Strategies used by the family functions to keep the recursion
+ * within the range of double precision numbers. */
+enum RecursionMode
+{
+	/*! Original algorithm: every time a coefficient overflows, all the
+	 * coefficients computed so far are divided by a large constant. */
+	SchultenGordonRescale,
+
+	/*! The coefficients are stored as a mantissa and the binary exponent of
+	 * the segment of the recursion they belong to. The exponents are applied
+	 * once at the end of each sweep, which keeps the cost linear in the
+	 * length of the family and avoids the roundoff of repeated divisions. */
+	SchultenGordonScaled,
+
+	/*! Simplified algorithm of Luscombe and Luban: in the classically
+	 * forbidden regions, the ratios of consecutive coefficients are computed
+	 * inward from both ends; the three-term recursion is only used across
+	 * the classically allowed region. The coefficients decrease away from
+	 * it, so that neither an arbitrary seed, nor a matching step, nor any
+	 * rescaling is needed. The sign of the family is carried by the ratios,
+	 * since the coefficients far in a forbidden region underflow. */
+	LuscombeLuban
+};
+
+/*! Families of at least this length are computed in the Scaled mode by
+ * running the forward and backward sweeps of the recursion on two threads.
+ * Each sweep fills its own part of the family until they meet in the
+ * classically allowed region. The default is 8192 when the machine has
+ * more than one hardware thread, and the split is disabled otherwise. The
+ * smallest accepted value is 16. */
+void setSplitRecursionThreshold(int size);
+int  splitRecursionThreshold();
+
 /*! @name Evaluation of Wigner-3j and -6j symbols.
  * We implement Schulten's algorithm in C++.
  */
@@ -43,9 +78,24 @@ namespace WignerSymbols {
 std::vector<double> wigner3j(double l2, double l3,
 						double m1, double m2, double m3);
 
+std::vector<double> wigner3j(double l2, double l3,
+						double m1, double m2, double m3,
+						RecursionMode mode);
+
 double wigner3j(double l1, double l2, double l3,
 					double m1, double m2, double m3);
 
+/*! Computes the Wigner-3j symbols with m1=m2=m3=0 for all possible values
+ * of l1. Only the entries where l1+l2+l3 is even are stored, i.e.
+ * l1 = |l2-l3|, |l2-l3|+2, ..., l2+l3; the others vanish by parity.
+ * l2 and l3 must be integers. */
+std::vector<double> wigner3j_m0(double l2, double l3);
+
+/*! Computes the Wigner-3j symbols (l1 l2 l3; m1 m2 -m1-m2) for all possible
+ * values of m2, from max(-l2,-l3-m1) to min(l2,l3-m1), with the three-term
+ * recursion in m2 of Schulten and Gordon. */
+std::vector<double> wigner3j_m(double l1, double l2, double l3, double m1);
+
 double wigner3j_auxA(double l1, double l2, double l3,
 						double m1, double m2, double m3);
 double wigner3j_auxB(double l1, double l2, double l3,
@@ -54,9 +104,90 @@ double wigner3j_auxB(double l1, double l2, double l3,
 std::vector<double> wigner6j(double l2, double l3,
 						double l4, double l5, double l6);
 
+std::vector<double> wigner6j(double l2, double l3,
+						double l4, double l5, double l6,
+						RecursionMode mode);
+
 double wigner6j(double l1, double l2, double l3,
 					double l4, double l5, double l6);
 
+/*! Computes the family of Wigner-3j symbols along the angular momentum
+ * l_varying (1, 2 or 3), the other arguments being fixed. The value passed
+ * for l_varying is ignored. The symbols are returned in the caller's
+ * ordering, for l_varying from max(|la-lb|,|m_varying|) to la+lb, where la
+ * and lb are the two fixed momenta. The family is brought to the first
+ * column by a cyclic permutation, which leaves the symbols unchanged, and
+ * computed in a single sweep. Returns an empty vector if varying is not
+ * 1, 2 or 3. */
+std::vector<double> wigner3j_family(int varying,
+						double l1, double l2, double l3,
+						double m1, double m2, double m3);
+
+std::vector<double> wigner3j_family(int varying,
+						double l1, double l2, double l3,
+						double m1, double m2, double m3,
+						RecursionMode mode);
+
+/*! Computes the family of Wigner-6j symbols {l1 l2 l3; l4 l5 l6} along
+ * l_varying (1 to 6), the other arguments being fixed. The value passed for
+ * l_varying is ignored. The family starts at the smallest value allowed by
+ * the two triads that contain l_varying. The 6j symbol is invariant under
+ * the permutations of its columns and the exchange of the upper and lower
+ * arguments of two columns, which bring l_varying to the first position
+ * without any phase. Returns an empty vector if varying is not 1 to 6. */
+std::vector<double> wigner6j_family(int varying,
+						double l1, double l2, double l3,
+						double l4, double l5, double l6);
+
+std::vector<double> wigner6j_family(int varying,
+						double l1, double l2, double l3,
+						double l4, double l5, double l6,
+						RecursionMode mode);
+
+/*! Part of the recursion coefficients of the 3j families with given l2 and
+ * l3 that does not depend on the projections: S[k] is the square root of
+ * (l1^2-(l2-l3)^2)((l2+l3+1)^2-l1^2) at l1 = l1min+k, l1min = |l2-l3|.
+ * A plan is computed once and shared by the families of all the (m1,m2,m3),
+ * which then only evaluate the terms that depend on the projections. */
+struct Wigner3jPlan
+{
+	double l2, l3, l1min;
+	std::vector<double> S;
+};
+
+Wigner3jPlan wigner3jPlan(double l2, double l3);
+
+/*! Computes the family wigner3j(plan.l2,plan.l3,m1,m2,m3) with the given
+ * plan. The version without a mode uses SchultenGordonScaled; the
+ * SchultenGordonRescale mode does not tabulate the coefficients and
+ * ignores the plan. */
+std::vector<double> wigner3j(const Wigner3jPlan& plan,
+						double m1, double m2, double m3);
+
+std::vector<double> wigner3j(const Wigner3jPlan& plan,
+						double m1, double m2, double m3,
+						RecursionMode mode);
+
+/*! Recursion coefficients of the 6j families with given l2, l3, l5 and l6,
+ * for l1 from l1min = max(|l2-l3|,|l5-l6|). A[k] is wigner6j_auxA, which
+ * does not depend on l4, and C[k] is the part of wigner6j_auxB that does
+ * not depend on l4. The families of all the l4 then only evaluate the
+ * term of wigner6j_auxB in l4. */
+struct Wigner6jPlan
+{
+	double l2, l3, l5, l6, l1min;
+	std::vector<double> A, C;
+};
+
+Wigner6jPlan wigner6jPlan(double l2, double l3, double l5, double l6);
+
+/*! Computes the family wigner6j(plan.l2,plan.l3,l4,plan.l5,plan.l6) with
+ * the given plan, in the same modes as the 3j plans. */
+std::vector<double> wigner6j(const Wigner6jPlan& plan, double l4);
+
+std::vector<double> wigner6j(const Wigner6jPlan& plan, double l4,
+						RecursionMode mode);
+
 double wigner6j_auxA(double l1, double l2, double l3,
 						double l4, double l5, double l6);
 
@@ -40,6 +40,10 @@ extern "C"
 {
   extern void drc3jj_wrap(double,double,double,double,double*,double*,double*,int,int*);
   extern void drc6j_wrap(double,double,double,double,double,double*,double*,double*,int,int*);
+  extern void drc3jj_batch_wrap(int,const double*,const double*,const double*,const double*,
+                                const int*,double*,double*,double*,int,int*);
+  extern void drc6j_batch_wrap(int,const double*,const double*,const double*,const double*,const double*,
+                               const int*,double*,double*,double*,int,int*);
 }
 
 /*! Compute a string of Wigner-3j symbols for given l2,l3,m1,m2,m3. */
@@ -61,9 +65,32 @@ inline double clebschGordan_f(double l1, double l2, double l3, double m1, double
 /*! Computes the Wigner-6j symbol for given, l1, l2, l3, l4, l5, l6.
  * We explicitly enforce the selection rules. */
 double wigner6j_f(double l1, double l2, double l3, double l4, double l5, double l6);
-}
+
+/*! Computes the strings of Wigner-3j symbols of the parameter sets
+ * (l2[k],l3[k],m1[k],m2[k],m3[k]) in a single call to the Fortran code.
+ * On return, the string of the k-th set is stored between the indices
+ * offsets[k] and offsets[k+1]-1 of the returned array. Sets that violate
+ * the selection rules, or that DRC3JJ would reject, are given an empty slot
+ * and are not passed to it, since its error handler stops the program. If
+ * given, errors receives the IER flag of DRC3JJ for each set, 0 when it
+ * succeeds or is skipped. If the parameter vectors differ in length, the
+ * array, offsets and errors are all returned empty. */
+std::vector<double> wigner3j_batch_f(const std::vector<double>& l2, const std::vector<double>& l3,
+                                     const std::vector<double>& m1, const std::vector<double>& m2,
+                                     const std::vector<double>& m3, std::vector<int>& offsets,
+                                     std::vector<int>* errors = 0);
+
+/*! Computes the strings of Wigner-6j symbols of the parameter sets
+ * (l2[k],l3[k],l4[k],l5[k],l6[k]) in a single call to the Fortran code.
+ * The output, the error flags of DRC6J and the rejection of vectors of
+ * different lengths are as in wigner3j_batch_f. */
+std::vector<double> wigner6j_batch_f(const std::vector<double>& l2, const std::vector<double>& l3,
+                                     const std::vector<double>& l4, const std::vector<double>& l5,
+                                     const std::vector<double>& l6, std::vector<int>& offsets,
+                                     std::vector<int>* errors = 0);
 
 /*! Computes a string of Wigner-6j symbols for given l2, l3, l4, l5, l6. */
 std::vector<double> wigner6j_f(double l2, double l3, double l4, double l5, double l6);
+}
 
 #endif // WIGNER_SYMBOLS_FORTRAN_H
@@ -0,0 +1,62 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html.              -/
+ ********************************************************/
+
+#ifndef WIGNER_SYMBOLS_WORK_STEALING_H
+#define WIGNER_SYMBOLS_WORK_STEALING_H
+
+/** \file workStealing.h
+ *
+ * \author Joey Dumont <joey.dumont@gmail.com>
+ *
+ * \since 2026-10-18
+ *
+ * \brief Defines a work-stealing loop for tasks of very uneven cost.
+ *
+ * The families of Wigner symbols that make up a table have lengths that
+ * range from 1 to 2*lmax+1. A static split of such a list leaves most
+ * threads idle while a few finish the long families. We instead sort the
+ * tasks by their estimated cost, deal them to one queue per thread, and
+ * let idle threads steal half of the remaining work of a busy one.
+ *
+ */
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace WignerSymbols {
+
+/*! Activity of a single worker thread. */
+struct WorkerStats
+{
+  std::size_t tasks;        ///< Number of tasks executed by the thread.
+  std::size_t steals;       ///< Number of successful steals.
+  double      busySeconds;  ///< Time spent executing tasks.
+};
+
+/*! Activity of all the worker threads of a parallel loop. */
+struct SchedulerStats
+{
+  double                   wallSeconds;
+  std::vector<WorkerStats> workers;
+
+  /*! Fraction of the wall time the threads spent executing tasks. */
+  double utilization() const;
+};
+
+/*! Calls task(k) for every k in [0,n) using nthreads threads, the calling
+ * thread included. cost[k] is an estimate of the relative cost of task k;
+ * only its ordering matters. Tasks must write to disjoint locations, as
+ * no synchronization is performed between them. If nthreads is 0, we use
+ * all the hardware threads. If stats is not null, it is filled with the
+ * activity of each thread. */
+void parallelFor(std::size_t n, const std::vector<double>& cost, unsigned int nthreads,
+                 const std::function<void(std::size_t)>& task, SchedulerStats* stats = 0);
+
+} // namespace WignerSymbols
+
+#endif // WIGNER_SYMBOLS_WORK_STEALING_H
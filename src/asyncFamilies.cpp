@@ -0,0 +1,330 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html.              -/
+ ********************************************************/
+
+#include "../include/wignerSymbols/asyncFamilies.h"
+#include "../include/wignerSymbols/tableGenerator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+namespace WignerSymbols {
+
+struct FamilyJob::State
+{
+  State() : symbol(3), mode(SchultenGordonScaled), out(0), capacity(0), size(0),
+            status(FamilyJobPending), cancelRequested(false), finished(false), written(0) {}
+
+  int           symbol;
+  double        p[5];
+  RecursionMode mode;
+  double*       out;
+  std::size_t   capacity, size;
+  FamilyJobCallback callback;
+
+  std::mutex              mutex;
+  std::condition_variable done;
+  FamilyJobStatus         status;
+  bool                    cancelRequested;
+  bool                    finished;   //!< The callback has returned.
+  std::size_t             written;
+};
+
+namespace {
+
+typedef std::shared_ptr<FamilyJob::State> JobState;
+
+/*! Number of symbols written by wigner3j(): a single zero when the
+ * projections violate a selection rule. */
+std::size_t outputSize(const Wigner3jFamily& f)
+{
+  double eps = std::numeric_limits<double>::epsilon();
+  bool select = std::fabs(f.m1+f.m2+f.m3) < eps
+             && std::fabs(f.m2) <= f.l2+eps && std::fabs(f.m3) <= f.l3+eps;
+  return select ? std::max<std::size_t>(1,familySize(f)) : 1;
+}
+
+/*! Number of symbols written by wigner6j(): a single zero when a triad
+ * that does not involve l1 violates a selection rule. The
+ * SchultenGordonRescale recursion only checks the sum rules. */
+std::size_t outputSize(const Wigner6jFamily& f, RecursionMode mode)
+{
+  bool triangles = std::fabs(f.l4-f.l2) <= f.l6 && f.l6 <= f.l4+f.l2
+                && std::fabs(f.l4-f.l5) <= f.l3 && f.l3 <= f.l4+f.l5;
+  bool sums = std::floor(f.l4+f.l2+f.l6) == f.l4+f.l2+f.l6
+           && std::floor(f.l4+f.l5+f.l3) == f.l4+f.l5+f.l3;
+  bool select = sums && (triangles || mode == SchultenGordonRescale);
+  return select ? std::max<std::size_t>(1,familySize(f)) : 1;
+}
+
+/*! Calls the callback with the final status, which the caller has set,
+ * and wakes the waiting threads. A callback that throws makes the job fail. */
+void finish(const JobState& job)
+{
+  FamilyJobStatus status;
+  std::size_t written;
+  {
+    std::lock_guard<std::mutex> lock(job->mutex);
+    status  = job->status;
+    written = job->written;
+  }
+  bool thrown = false;
+  if (job->callback)
+  {
+    try { job->callback(status,written); }
+    catch (...) { thrown = true; }
+  }
+  {
+    std::lock_guard<std::mutex> lock(job->mutex);
+    if (thrown) job->status = FamilyJobFailed;
+    job->finished = true;
+  }
+  job->done.notify_all();
+}
+
+void setStatus(const JobState& job, FamilyJobStatus status)
+{
+  std::lock_guard<std::mutex> lock(job->mutex);
+  job->status = status;
+}
+
+void run(const JobState& job)
+{
+  {
+    std::lock_guard<std::mutex> lock(job->mutex);
+    if (job->status != FamilyJobPending) return;
+    job->status = FamilyJobRunning;
+  }
+
+  const double* p = job->p;
+  std::vector<double> values;
+  try
+  {
+    values = (job->symbol == 3)
+      ? wigner3j(p[0],p[1],p[2],p[3],p[4],job->mode)
+      : wigner6j(p[0],p[1],p[2],p[3],p[4],job->mode);
+  }
+  catch (...)
+  {
+    setStatus(job,FamilyJobFailed);
+    finish(job);
+    return;
+  }
+
+  // The copy and the final status are set in the same critical section, so
+  // that cancel() either prevents the copy or reports that the job has
+  // finished.
+  {
+    std::lock_guard<std::mutex> lock(job->mutex);
+    if (job->cancelRequested) job->status = FamilyJobCancelled;
+    else if (values.size() > job->capacity) job->status = FamilyJobTooSmall;
+    else
+    {
+      std::copy(values.begin(),values.end(),job->out);
+      job->written = values.size();
+      job->status  = FamilyJobDone;
+    }
+  }
+  finish(job);
+}
+
+} // namespace
+
+FamilyJob::FamilyJob() {}
+
+FamilyJob::FamilyJob(const std::shared_ptr<State>& state) : state(state) {}
+
+FamilyJobStatus FamilyJob::status() const
+{
+  if (!state) return FamilyJobCancelled;
+  std::lock_guard<std::mutex> lock(state->mutex);
+  return state->status;
+}
+
+std::size_t FamilyJob::size() const
+{
+  return state ? state->size : 0;
+}
+
+FamilyJobStatus FamilyJob::wait() const
+{
+  if (!state) return FamilyJobCancelled;
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->done.wait(lock,[this]() { return state->finished; });
+  return state->status;
+}
+
+bool FamilyJob::waitFor(double seconds) const
+{
+  if (!state) return true;
+  std::unique_lock<std::mutex> lock(state->mutex);
+  return state->done.wait_for(lock,std::chrono::duration<double>(seconds),
+                              [this]() { return state->finished; });
+}
+
+bool FamilyJob::cancel()
+{
+  if (!state) return false;
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    if (state->status == FamilyJobRunning)
+    {
+      state->cancelRequested = true;
+      return true;
+    }
+    if (state->status != FamilyJobPending) return false;
+    state->status = FamilyJobCancelled;
+  }
+  // The worker that pops the job will skip it.
+  finish(state);
+  return true;
+}
+
+struct FamilyJobPool::Queue
+{
+  std::mutex                  mutex;
+  std::condition_variable     notEmpty, notFull;
+  std::deque<JobState>        jobs;
+  std::vector<std::thread>    workers;
+  std::size_t                 maxQueued;
+  bool                        stopping;
+};
+
+FamilyJobPool::FamilyJobPool(unsigned int nthreads, std::size_t maxQueued)
+  : queue(new Queue)
+{
+  if (nthreads == 0) nthreads = std::max(1u,std::thread::hardware_concurrency());
+  queue->maxQueued = std::max<std::size_t>(1,maxQueued);
+  queue->stopping  = false;
+
+  Queue* q = queue.get();
+  for (unsigned int t=0;t<nthreads;t++)
+    queue->workers.push_back(std::thread([q]()
+    {
+      for (;;)
+      {
+        JobState job;
+        {
+          std::unique_lock<std::mutex> lock(q->mutex);
+          q->notEmpty.wait(lock,[q]() { return q->stopping || !q->jobs.empty(); });
+          if (q->jobs.empty()) return;
+          job = q->jobs.front();
+          q->jobs.pop_front();
+        }
+        q->notFull.notify_one();
+        run(job);
+      }
+    }));
+}
+
+FamilyJobPool::~FamilyJobPool()
+{
+  std::deque<JobState> jobs;
+  {
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    queue->stopping = true;
+    jobs.swap(queue->jobs);
+  }
+  queue->notEmpty.notify_all();
+  queue->notFull.notify_all();
+  for (std::size_t i=0;i<jobs.size();i++) FamilyJob(jobs[i]).cancel();
+  for (std::size_t i=0;i<queue->workers.size();i++) queue->workers[i].join();
+}
+
+FamilyJob FamilyJobPool::submit(const std::shared_ptr<FamilyJob::State>& job)
+{
+  if (job->size > job->capacity)
+  {
+    setStatus(job,FamilyJobTooSmall);
+    finish(job);
+    return FamilyJob(job);
+  }
+
+  bool queued = false;
+  {
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    queue->notFull.wait(lock,[this]() { return queue->stopping || queue->jobs.size() < queue->maxQueued; });
+    if (!queue->stopping)
+    {
+      queue->jobs.push_back(job);
+      queued = true;
+    }
+  }
+  if (queued) queue->notEmpty.notify_one();
+  else FamilyJob(job).cancel();
+  return FamilyJob(job);
+}
+
+FamilyJob FamilyJobPool::wigner3j(double l2, double l3, double m1, double m2, double m3,
+                                  double* out, std::size_t capacity,
+                                  RecursionMode mode, const FamilyJobCallback& callback)
+{
+  std::shared_ptr<FamilyJob::State> job = std::make_shared<FamilyJob::State>();
+  double p[5] = {l2,l3,m1,m2,m3};
+  std::copy(p,p+5,job->p);
+  Wigner3jFamily family = {l2,l3,m1,m2,m3};
+  job->symbol   = 3;
+  job->size     = outputSize(family);
+  job->mode     = mode;
+  job->out      = out;
+  job->capacity = capacity;
+  job->callback = callback;
+  return submit(job);
+}
+
+FamilyJob FamilyJobPool::wigner6j(double l2, double l3, double l4, double l5, double l6,
+                                  double* out, std::size_t capacity,
+                                  RecursionMode mode, const FamilyJobCallback& callback)
+{
+  std::shared_ptr<FamilyJob::State> job = std::make_shared<FamilyJob::State>();
+  double p[5] = {l2,l3,l4,l5,l6};
+  std::copy(p,p+5,job->p);
+  Wigner6jFamily family = {l2,l3,l4,l5,l6};
+  job->symbol   = 6;
+  job->size     = outputSize(family,mode);
+  job->mode     = mode;
+  job->out      = out;
+  job->capacity = capacity;
+  job->callback = callback;
+  return submit(job);
+}
+
+unsigned int FamilyJobPool::threads() const
+{
+  return (unsigned int)queue->workers.size();
+}
+
+std::size_t FamilyJobPool::pending() const
+{
+  std::lock_guard<std::mutex> lock(queue->mutex);
+  return queue->jobs.size();
+}
+
+FamilyJobPool& sharedFamilyJobPool()
+{
+  static FamilyJobPool pool;
+  return pool;
+}
+
+FamilyJob wigner3j_async(double l2, double l3, double m1, double m2, double m3,
+                         double* out, std::size_t capacity, const FamilyJobCallback& callback)
+{
+  return sharedFamilyJobPool().wigner3j(l2,l3,m1,m2,m3,out,capacity,SchultenGordonScaled,callback);
+}
+
+FamilyJob wigner6j_async(double l2, double l3, double l4, double l5, double l6,
+                         double* out, std::size_t capacity, const FamilyJobCallback& callback)
+{
+  return sharedFamilyJobPool().wigner6j(l2,l3,l4,l5,l6,out,capacity,SchultenGordonScaled,callback);
+}
+
+} // namespace WignerSymbols
@@ -0,0 +1,146 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html.              -/
+ ********************************************************/
+
+#include "../include/wignerSymbols/bispectrum.h"
+#include "../include/wignerSymbols/kernels.h"
+#include "../include/wignerSymbols/scratchArena.h"
+#include "../include/wignerSymbols/wignerSymbols-cpp.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace WignerSymbols {
+
+namespace {
+
+// Number of groups of bispectrumWidth environments handled by a task.
+const std::size_t groupsPerTask = 8;
+
+} // anonymous namespace
+
+BispectrumPlan bispectrumPlan(int lmax)
+{
+  BispectrumPlan plan;
+  plan.lmax = std::max(lmax,0);
+  lmax = plan.lmax;
+  plan.rowBegin.push_back(0);
+
+  for (int l1=0;l1<=lmax;l1++)
+    for (int l2=l1;l2<=lmax;l2++)
+    {
+      // <l1 m1 l2 m2|l m> for all l, by (m1,m2). The family of the 3j symbols
+      // (l1 l2 l; m1 m2 -m) starts at l = max(l2-l1,|m|).
+      int n2 = 2*l2+1;
+      std::vector<std::vector<double> > families((2*l1+1)*n2);
+      for (int m1=-l1;m1<=l1;m1++)
+        for (int m2=-l2;m2<=l2;m2++)
+        {
+          int m = m1+m2;
+          std::vector<double>& family = families[(m1+l1)*n2+m2+l2];
+          family = wigner3j_family(3,l1,l2,0,m1,m2,-m);
+          int lmin = std::max(l2-l1,std::abs(m));
+          for (std::size_t i=0;i<family.size();i++)
+          {
+            int lc = lmin+(int)i;
+            family[i] *= (((l1-l2+m)%2) ? -1.0 : 1.0)*std::sqrt(2.0*lc+1.0);
+          }
+        }
+
+      for (int l=l2-l1;l<=std::min(l1+l2,lmax);l++)
+      {
+        plan.l1.push_back(l1);
+        plan.l2.push_back(l2);
+        plan.l.push_back(l);
+
+        for (int m1=-l1;m1<=l1;m1++)
+        {
+          int m2min = std::max(-l2,-l-m1), m2max = std::min(l2,l-m1);
+          if (m2min > m2max) continue;
+
+          plan.rows.push_back(l1*l1+l1+m1);
+          plan.rows.push_back(l2*l2+l2+m2min);
+          plan.rows.push_back(l*l+l+m1+m2min);
+          plan.rows.push_back(m2max-m2min+1);
+          for (int m2=m2min;m2<=m2max;m2++)
+          {
+            const std::vector<double>& family = families[(m1+l1)*n2+m2+l2];
+            plan.cg.push_back(family[l-std::max(l2-l1,std::abs(m1+m2))]);
+          }
+        }
+        plan.rowBegin.push_back((int)plan.rows.size()/4);
+      }
+    }
+
+  return plan;
+}
+
+void bispectrum(const BispectrumPlan& plan, std::size_t count,
+                const std::complex<double>* coefficients, double* descriptors,
+                unsigned int nthreads, SchedulerStats* stats)
+{
+  const std::size_t W = bispectrumWidth;
+  std::size_t ncoef = plan.coefficients(), ndesc = plan.size();
+  std::size_t groups = (count+W-1)/W;
+  std::size_t tasks = (groups+groupsPerTask-1)/groupsPerTask;
+  const Kernels& kernel = kernels();
+
+  // All the groups cost the same, except the last one.
+  std::vector<double> cost(tasks,1.0);
+
+  parallelFor(tasks, cost, nthreads, [&](std::size_t task)
+  {
+    double* re  = ScratchArena::local().reserve((2*ncoef+ndesc)*W);
+    double* im  = re+ncoef*W;
+    double* out = im+ncoef*W;
+
+    std::size_t gend = std::min(groups,(task+1)*groupsPerTask);
+    for (std::size_t g=task*groupsPerTask;g<gend;g++)
+    {
+      std::size_t first = g*W, width = std::min(W,count-first);
+
+      // Interleave the coefficients of the group. Missing environments of
+      // the last group are padded with zeros.
+      for (std::size_t e=0;e<W;e++)
+      {
+        if (e >= width)
+        {
+          for (std::size_t i=0;i<ncoef;i++)
+            re[i*W+e] = im[i*W+e] = 0.0;
+          continue;
+        }
+        const std::complex<double>* c = coefficients+(first+e)*ncoef;
+        for (std::size_t i=0;i<ncoef;i++)
+        {
+          re[i*W+e] = c[i].real();
+          im[i*W+e] = c[i].imag();
+        }
+      }
+
+      kernel.bispectrum((int)ndesc,&plan.rowBegin[0],&plan.rows[0],&plan.cg[0],re,im,out);
+
+      for (std::size_t e=0;e<width;e++)
+        for (std::size_t t=0;t<ndesc;t++)
+          descriptors[(first+e)*ndesc+t] = out[t*W+e];
+    }
+  }, stats);
+}
+
+std::vector<double> bispectrum(const BispectrumPlan& plan,
+                               const std::vector<std::complex<double> >& coefficients,
+                               unsigned int nthreads, SchedulerStats* stats)
+{
+  std::size_t ncoef = plan.coefficients();
+  if (coefficients.size() % ncoef != 0) return std::vector<double>();
+
+  std::size_t count = coefficients.size()/ncoef;
+  std::vector<double> descriptors(count*plan.size());
+  if (count > 0)
+    bispectrum(plan,count,&coefficients[0],&descriptors[0],nthreads,stats);
+  return descriptors;
+}
+
+} // namespace WignerSymbols
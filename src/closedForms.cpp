@@ -0,0 +1,111 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html.              -/
+ ********************************************************/
+
+#include "../include/wignerSymbols/closedForms.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace WignerSymbols {
+
+namespace {
+
+/*! Rounds a sum of angular momenta to the nearest integer. The scalar
+ * symbol uses it instead of std::floor, which is a library call on the
+ * baseline instruction set. The family calls std::floor once. */
+long integer(double x)
+{
+	return (long)(x >= 0.0 ? x+0.5 : x-0.5);
+}
+
+/*! Multiplies num by n! and den by N!, up to their common factor N!. We
+ * only use it when n and N are close. */
+void factorialRatio(long n, long N, double& num, double& den)
+{
+	for (long i=N+1;i<=n;i++)
+		num *= i;
+	for (long i=n+1;i<=N;i++)
+		den *= i;
+}
+
+} // anonymous namespace
+
+double wigner3j_closedForm(double l1, double l2, double l3,
+						double m1, double m2, double m3)
+{
+	// The projections must match the parity of their angular momenta.
+	if (integer(l1+m1)!=l1+m1 || integer(l2+m2)!=l2+m2) return 0.0;
+
+	// Triangle coefficients. a and c cannot exceed 2*l2.
+	long a = integer(l1+l2-l3);
+	long b = integer(l1-l2+l3);
+	long c = integer(-l1+l2+l3);
+	long J = integer(l1+l2+l3);
+
+	// Arguments of the factorials of the Racah sum, which reads
+	// sum_t (-1)^t/[t!(u+t)!(a-t)!(v-t)!(w+t)!(x-t)!].
+	long u = integer(l3-l1-m2);
+	long v = integer(l2+m2);
+	long w = integer(l3-l2+m1);
+	long x = integer(l1-m1);
+
+	long tmin = std::max(0L,std::max(-u,-w));
+	long tmax = std::min(a,std::min(v,x));
+	if (tmin>tmax) return 0.0;
+
+	// The factorials of large arguments are measured relative to N1! and
+	// N2!, whose arguments differ from theirs by at most a few units. The
+	// bases cancel between the prefactor and the terms of the sum.
+	long N1 = w+tmin;
+	long N2 = x-tmax;
+
+	double num = 1.0, den = 1.0;
+	factorialRatio(a,0,num,den);
+	factorialRatio(c,0,num,den);
+	factorialRatio(v,0,num,den);
+	factorialRatio(integer(l2-m2),0,num,den);
+	factorialRatio(integer(l1+m1),N1,num,den);
+	factorialRatio(integer(l3-m3),N1,num,den);
+	factorialRatio(integer(l3+m3),N2,num,den);
+	factorialRatio(x,N2,num,den);
+	factorialRatio(b,J+1,num,den);
+	double prefactor = std::sqrt(num/den);
+
+	// First term of the sum, then the ratio of consecutive terms.
+	num = 1.0;
+	den = 1.0;
+	factorialRatio(tmin,0,den,num);
+	factorialRatio(u+tmin,0,den,num);
+	factorialRatio(a-tmin,0,den,num);
+	factorialRatio(v-tmin,0,den,num);
+	factorialRatio(x-tmin,N2,den,num);
+	double term = (tmin%2 ? -num/den : num/den);
+	double sum  = term;
+	for (long t=tmin;t<tmax;t++)
+	{
+		term *= -double((a-t)*(v-t))*(x-t)/(double((t+1)*(u+t+1))*(w+t+1));
+		sum  += term;
+	}
+
+	double sign = (integer(l1-l2-m3)%2 ? -1.0 : 1.0);
+	return sign*prefactor*sum;
+}
+
+std::vector<double> wigner3j_closedForm(double l2, double l3,
+						double m1, double m2, double m3)
+{
+	double l1min = std::max(std::fabs(l2-l3),std::fabs(m1));
+	double l1max = l2+l3;
+	int size = (int)std::floor(l1max-l1min+1.0+1.0e-10);
+
+	std::vector<double> thrcof(std::max(size,0));
+	for (int k=0;k<size;k++)
+		thrcof[k] = wigner3j_closedForm(l1min+k,l2,l3,m1,m2,m3);
+	return thrcof;
+}
+
+} // namespace WignerSymbols
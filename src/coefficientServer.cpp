@@ -0,0 +1,507 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html.              -/
+ ********************************************************/
+
+#include "../include/wignerSymbols/coefficientServer.h"
+#include "../include/wignerSymbols/familyCache.h"
+#include "../include/wignerSymbols/tableGenerator.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <thread>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace WignerSymbols {
+
+namespace {
+
+bool lexicographicLess(const int32_t* a, const int32_t* b)
+{
+  return std::lexicographical_compare(a,a+5,b,b+5);
+}
+
+bool even(int32_t n)
+{
+  return (n&1) == 0;
+}
+
+/*! Brings the family (2l2,2l3,2m1,2m2,2m3) to its canonical form. The four
+ * forms related by the exchange of the last two columns and the reversal
+ * of the projections are ordered by (l3,l2,-m1,m2,m3), and we keep the
+ * smallest, which has l3 <= l2 and m1 >= 0. Returns true if the symbols of
+ * the canonical family carry the phase (-1)^(l1+l2+l3). */
+bool canonical3j(const int32_t* q, int32_t* key)
+{
+  bool odd = false;
+  int32_t best[5] = {0,0,0,0,0};
+  for (int t=0;t<4;t++)
+  {
+    bool swap = (t&1) != 0, flip = (t&2) != 0;
+    int32_t s = flip ? -1 : 1;
+    int32_t c[5] = {swap ? q[1] : q[0], swap ? q[0] : q[1], s*q[2],
+                    s*(swap ? q[4] : q[3]), s*(swap ? q[3] : q[4])};
+    int32_t order[5] = {c[1],c[0],-c[2],c[3],c[4]};
+    int32_t bestOrder[5] = {best[1],best[0],-best[2],best[3],best[4]};
+    if (t == 0 || lexicographicLess(order,bestOrder))
+    {
+      std::copy(c,c+5,best);
+      odd = swap != flip;
+    }
+  }
+  std::copy(best,best+5,key);
+  return odd;
+}
+
+void setError(std::string* error, const std::string& message)
+{
+  if (error) *error = message;
+}
+
+bool receiveAll(int fd, void* data, std::size_t bytes)
+{
+  char* p = static_cast<char*>(data);
+  while (bytes > 0)
+  {
+    ssize_t n = recv(fd,p,bytes,0);
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) return false;
+    p += n; bytes -= (std::size_t)n;
+  }
+  return true;
+}
+
+bool sendAll(int fd, const void* data, std::size_t bytes)
+{
+  const char* p = static_cast<const char*>(data);
+  while (bytes > 0)
+  {
+    ssize_t n = send(fd,p,bytes,MSG_NOSIGNAL);
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) return false;
+    p += n; bytes -= (std::size_t)n;
+  }
+  return true;
+}
+
+bool socketAddress(const std::string& path, sockaddr_un& address, std::string* error)
+{
+  std::memset(&address,0,sizeof(address));
+  address.sun_family = AF_UNIX;
+  if (path.empty() || path.size() >= sizeof(address.sun_path))
+  {
+    setError(error,"invalid socket path: " + path);
+    return false;
+  }
+  std::memcpy(address.sun_path,path.c_str(),path.size()+1);
+  return true;
+}
+
+} // namespace
+
+CoefficientServerOptions::CoefficientServerOptions()
+  : lmax(10000), cacheFamilies(1 << 16), precompute3j(-1), precompute6j(-1)
+{}
+
+struct CoefficientServer::State
+{
+  struct Connection
+  {
+    std::thread thread;
+    int         fd;
+    bool        done;
+  };
+
+  // The families are bounded by their number, not by their size.
+  explicit State(std::size_t cacheFamilies)
+    : cache((std::size_t)-1,cacheFamilies), listenFd(-1), running(false),
+      connections(0), requests(0), symbols(0), hits(0), misses(0) {}
+
+  CoefficientServerOptions options;
+  FamilyCache              cache;
+  int                      listenFd;
+  std::atomic<bool>        running;
+  std::thread              acceptor;
+
+  std::mutex                                connectionMutex;
+  std::list<std::unique_ptr<Connection> >   clients;
+
+  std::atomic<unsigned long long> connections, requests, symbols, hits, misses;
+};
+
+CoefficientServer::CoefficientServer(const CoefficientServerOptions& options)
+  : state(new State(options.cacheFamilies))
+{
+  state->options = options;
+  state->options.lmax = std::max(0,std::min(options.lmax,familyLmaxLimit));
+}
+
+CoefficientServer::~CoefficientServer()
+{
+  stop();
+}
+
+namespace {
+
+template <class Family3jOr6j>
+void pinFamilies(FamilyCache& cache, int32_t symbol, const std::vector<Family3jOr6j>& families,
+                 const std::vector<double>& table, const std::vector<std::size_t>& offsets)
+{
+  for (std::size_t k=0;k<families.size();k++)
+  {
+    FamilyKey key;
+    key.symbol = symbol;
+    const double* q = &families[k].l2;
+    for (int j=0;j<5;j++) key.p[j] = (int32_t)std::lround(2.0*q[j]);
+    cache.pin(key,std::make_shared<const std::vector<double> >(table.begin()+offsets[k],
+                                                               table.begin()+offsets[k+1]));
+  }
+}
+
+} // namespace
+
+bool CoefficientServer::start(std::string* error)
+{
+  if (state->running) return true;
+
+  sockaddr_un address;
+  if (!socketAddress(state->options.socketPath,address,error)) return false;
+
+  // The tables are computed before the socket accepts any connection.
+  if (state->options.precompute3j >= 0)
+  {
+    std::vector<Wigner3jFamily> all = wigner3jFamilies(state->options.precompute3j), families;
+    for (std::size_t k=0;k<all.size();k++)
+    {
+      int32_t q[5], key[5];
+      const double* p = &all[k].l2;
+      for (int j=0;j<5;j++) q[j] = (int32_t)std::lround(2.0*p[j]);
+      canonical3j(q,key);
+      if (!std::equal(q,q+5,key)) continue;
+      families.push_back(all[k]);
+    }
+    std::vector<std::size_t> offsets;
+    std::vector<double> table = wigner3jTable(families,offsets);
+    pinFamilies(state->cache,3,families,table,offsets);
+  }
+  if (state->options.precompute6j >= 0)
+  {
+    std::vector<Wigner6jFamily> all = wigner6jFamilies(state->options.precompute6j), families;
+    for (std::size_t k=0;k<all.size();k++)
+    {
+      // We keep the families that hold the canonical orientation of at
+      // least one of their symbols.
+      int32_t j[6];
+      const double* p = &all[k].l2;
+      for (int i=0;i<5;i++) j[i+1] = (int32_t)std::lround(2.0*p[i]);
+      int32_t lmin = std::max(std::abs(j[1]-j[2]),std::abs(j[4]-j[5]));
+      int32_t lmax = std::min(j[1]+j[2],j[4]+j[5]);
+      for (j[0]=lmin;j[0]<=lmax;j[0]+=2)
+      {
+        int32_t first;
+        FamilyKey key;
+        canonicalWigner6j(j,first,key);
+        if (std::equal(j+1,j+6,key.p))
+        {
+          families.push_back(all[k]);
+          break;
+        }
+      }
+    }
+    std::vector<std::size_t> offsets;
+    std::vector<double> table = wigner6jTable(families,offsets);
+    pinFamilies(state->cache,6,families,table,offsets);
+  }
+
+  int fd = socket(AF_UNIX,SOCK_STREAM,0);
+  if (fd < 0)
+  {
+    setError(error,std::string("socket: ") + std::strerror(errno));
+    return false;
+  }
+  // A socket file left by a server that did not stop would prevent the bind.
+  unlink(address.sun_path);
+  if (bind(fd,reinterpret_cast<sockaddr*>(&address),sizeof(address)) != 0 || listen(fd,SOMAXCONN) != 0)
+  {
+    setError(error,"cannot listen on " + state->options.socketPath + ": " + std::strerror(errno));
+    ::close(fd);
+    return false;
+  }
+
+  state->listenFd = fd;
+  state->running  = true;
+
+  State* s = state.get();
+  CoefficientServer* server = this;
+  state->acceptor = std::thread([s,server]()
+  {
+    while (s->running)
+    {
+      int client = accept(s->listenFd,0,0);
+      if (client < 0)
+      {
+        if (errno == EINTR || errno == ECONNABORTED) continue;
+        break;
+      }
+      s->connections++;
+
+      std::lock_guard<std::mutex> lock(s->connectionMutex);
+      // The threads of the closed connections are joined here.
+      for (auto it=s->clients.begin();it!=s->clients.end();)
+      {
+        if ((*it)->done) { (*it)->thread.join(); it = s->clients.erase(it); }
+        else ++it;
+      }
+      if (!s->running) { ::close(client); break; }
+
+      // Without the memory or a thread for it, we drop the connection
+      // rather than the server.
+      State::Connection* c = 0;
+      try
+      {
+        c = new State::Connection;
+        c->fd = client;
+        c->done = false;
+        s->clients.push_back(std::unique_ptr<State::Connection>(c));
+        c->thread = std::thread([s,server,c]()
+        {
+          std::vector<int32_t> args;
+          std::vector<double>  values;
+          std::vector<char>    reply;
+          for (;;)
+          {
+            CoefficientRequestHeader request;
+            if (!receiveAll(c->fd,&request,sizeof(request))) break;
+
+            CoefficientReplyHeader header = {coefficientReplyMagic,CoefficientOk,0};
+            if (request.magic != coefficientRequestMagic
+                || request.kind < Wigner3jKind || request.kind > ClebschGordanKind
+                || request.count > coefficientMaxBatch)
+            {
+              header.status = CoefficientBadRequest;
+              sendAll(c->fd,&header,sizeof(header));
+              break;
+            }
+
+            // A request that fails, for instance on a family too large for
+            // the memory, only closes its own connection.
+            try
+            {
+              args.resize(6*(std::size_t)request.count);
+              if (!receiveAll(c->fd,args.data(),args.size()*sizeof(int32_t))) break;
+
+              // The values are computed in an aligned buffer and copied after the header.
+              values.resize(request.count);
+              if (server->evaluate(request.kind,args.data(),request.count,values.data()))
+              {
+                header.count = request.count;
+                reply.resize(sizeof(header) + request.count*sizeof(double));
+                std::memcpy(reply.data(),&header,sizeof(header));
+                if (request.count > 0)
+                  std::memcpy(reply.data()+sizeof(header),values.data(),request.count*sizeof(double));
+              }
+              else
+                header.status = CoefficientBadRequest;
+            }
+            catch (...)
+            {
+              header.status = CoefficientServerError;
+            }
+            if (header.status != CoefficientOk)
+            {
+              sendAll(c->fd,&header,sizeof(header));
+              break;
+            }
+            s->requests++;
+            if (!sendAll(c->fd,reply.data(),reply.size())) break;
+          }
+
+          std::lock_guard<std::mutex> lock(s->connectionMutex);
+          ::close(c->fd);
+          c->fd = -1;
+          c->done = true;
+        });
+      }
+      catch (...)
+      {
+        ::close(client);
+        if (!s->clients.empty() && s->clients.back().get() == c) s->clients.pop_back();
+      }
+    }
+  });
+  return true;
+}
+
+void CoefficientServer::stop()
+{
+  if (!state->running) return;
+  state->running = false;
+
+  // Shutting the sockets down wakes the threads blocked in accept and recv.
+  shutdown(state->listenFd,SHUT_RDWR);
+  state->acceptor.join();
+  ::close(state->listenFd);
+  state->listenFd = -1;
+  unlink(state->options.socketPath.c_str());
+
+  std::list<std::unique_ptr<State::Connection> > clients;
+  {
+    std::lock_guard<std::mutex> lock(state->connectionMutex);
+    for (auto& c : state->clients)
+      if (c->fd >= 0) shutdown(c->fd,SHUT_RDWR);
+    clients.swap(state->clients);
+  }
+  for (auto& c : clients) c->thread.join();
+}
+
+bool CoefficientServer::evaluate(uint32_t kind, const int32_t* args, std::size_t count, double* values)
+{
+  // We check all the arguments first, so that a rejected request computes
+  // no family.
+  const int32_t limit = 2*state->options.lmax;
+  for (std::size_t i=0;i<6*count;i++)
+    if (args[i] < -limit || args[i] > limit) return false;
+
+  // Consecutive symbols of a batch often belong to the same family, which
+  // we then look up once.
+  FamilyKey last;
+  last.symbol = 0;
+  SharedFamily family;
+  unsigned long long hits = 0, misses = 0;
+
+  for (std::size_t i=0;i<count;i++)
+  {
+    const int32_t* j = args + 6*i;
+    double& value = values[i];
+    value = 0.0;
+
+    FamilyKey key;
+    double sign = 1.0, factor = 1.0;
+    int32_t first, start;
+    if (kind == Wigner6jKind)
+    {
+      if (!(doubledTriad(j[0],j[1],j[2]) && doubledTriad(j[0],j[4],j[5])
+            && doubledTriad(j[3],j[1],j[5]) && doubledTriad(j[3],j[4],j[2]))) continue;
+      canonicalWigner6j(j,first,key);
+      start = std::max(std::abs(key.p[0]-key.p[1]),std::abs(key.p[3]-key.p[4]));
+    }
+    else
+    {
+      // <l1 m1 l2 m2|L M> = (-1)^(l1-l2+M) sqrt(2L+1) (l1 l2 L; m1 m2 -M).
+      int32_t q[6] = {j[0],j[1],j[2],j[3],j[4],j[5]};
+      if (kind == ClebschGordanKind)
+      {
+        q[5] = -j[5];
+        int32_t e = (j[0]-j[1]+j[5])/2;
+        if (!even(e)) sign = -1.0;
+        factor = std::sqrt(j[2]+1.0);
+      }
+      if (!(q[3]+q[4]+q[5] == 0 && doubledTriad(q[0],q[1],q[2])
+            && std::abs(q[3]) <= q[0] && std::abs(q[4]) <= q[1] && std::abs(q[5]) <= q[2]
+            && even(q[0]+q[3]) && even(q[1]+q[4]) && even(q[2]+q[5]))) continue;
+      key.symbol = 3;
+      int32_t p[5] = {q[1],q[2],q[3],q[4],q[5]};
+      if (canonical3j(p,key.p) && !even((q[0]+q[1]+q[2])/2)) sign = -sign;
+      first = q[0];
+      start = std::max(std::abs(key.p[0]-key.p[1]),std::abs(key.p[2]));
+    }
+
+    if (!family || !(key == last))
+    {
+      bool miss;
+      family = state->cache.get(key,&miss);
+      if (miss) misses++;
+      last = key;
+    }
+    hits++;
+    std::size_t index = (std::size_t)((first-start)/2);
+    if (index < family->size()) value = sign*factor*(*family)[index];
+  }
+
+  state->symbols += count;
+  state->hits    += hits-misses;
+  state->misses  += misses;
+  return true;
+}
+
+CoefficientServerStats CoefficientServer::stats() const
+{
+  CoefficientServerStats s;
+  s.connections = state->connections;
+  s.requests    = state->requests;
+  s.symbols     = state->symbols;
+  s.hits        = state->hits;
+  s.misses      = state->misses;
+  FamilyCacheStats cache = state->cache.stats();
+  s.families    = cache.families;
+  s.pinned      = cache.pinned;
+  return s;
+}
+
+CoefficientClient::CoefficientClient() : fd(-1) {}
+
+CoefficientClient::~CoefficientClient()
+{
+  close();
+}
+
+bool CoefficientClient::connect(const std::string& socketPath, std::string* error)
+{
+  close();
+  sockaddr_un address;
+  if (!socketAddress(socketPath,address,error)) return false;
+  fd = socket(AF_UNIX,SOCK_STREAM,0);
+  if (fd < 0 || ::connect(fd,reinterpret_cast<sockaddr*>(&address),sizeof(address)) != 0)
+  {
+    setError(error,"cannot connect to " + socketPath + ": " + std::strerror(errno));
+    close();
+    return false;
+  }
+  return true;
+}
+
+void CoefficientClient::close()
+{
+  if (fd >= 0) ::close(fd);
+  fd = -1;
+}
+
+bool CoefficientClient::evaluate(uint32_t kind, const int32_t* args, std::size_t count, double* values)
+{
+  if (fd < 0 || count > coefficientMaxBatch) return false;
+
+  CoefficientRequestHeader request = {coefficientRequestMagic,kind,(uint32_t)count};
+  std::vector<char> message(sizeof(request) + 6*count*sizeof(int32_t));
+  std::memcpy(message.data(),&request,sizeof(request));
+  if (count > 0) std::memcpy(message.data()+sizeof(request),args,6*count*sizeof(int32_t));
+
+  CoefficientReplyHeader reply;
+  if (!sendAll(fd,message.data(),message.size()) || !receiveAll(fd,&reply,sizeof(reply))
+      || reply.magic != coefficientReplyMagic || reply.status != CoefficientOk || reply.count != count
+      || !receiveAll(fd,values,count*sizeof(double)))
+  {
+    close();
+    return false;
+  }
+  return true;
+}
+
+bool CoefficientClient::evaluate(uint32_t kind, const std::vector<double>& args, std::vector<double>& values)
+{
+  std::vector<int32_t> doubled(args.size()/6*6);
+  for (std::size_t i=0;i<doubled.size();i++) doubled[i] = (int32_t)std::lround(2.0*args[i]);
+  values.resize(doubled.size()/6);
+  return evaluate(kind,doubled.data(),values.size(),values.data());
+}
+
+} // namespace WignerSymbols
@@ -0,0 +1,236 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html.              -/
+ ********************************************************/
+
+#include "../include/wignerSymbols/familyCache.h"
+#include "../include/wignerSymbols/wignerSymbols-cpp.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace WignerSymbols {
+
+bool FamilyKey::operator==(const FamilyKey& other) const
+{
+  return symbol == other.symbol && std::equal(p,p+5,other.p);
+}
+
+std::size_t FamilyKeyHash::operator()(const FamilyKey& key) const
+{
+  uint64_t h = 14695981039346656037ULL;
+  h = (h^(uint32_t)key.symbol)*1099511628211ULL;
+  for (int i=0;i<5;i++) h = (h^(uint32_t)key.p[i])*1099511628211ULL;
+  return (std::size_t)(h^(h>>32));
+}
+
+bool doubledTriad(int64_t ja, int64_t jb, int64_t jc)
+{
+  return std::abs(ja-jb) <= jc && jc <= ja+jb && (ja+jb+jc)%2 == 0;
+}
+
+// The columns are permuted, and the upper and lower arguments of the
+// columns in flips[f] are exchanged.
+void canonicalWigner6j(const int32_t* j, int32_t& first, FamilyKey& key)
+{
+  static const int permutations[6][3] = {{0,1,2},{0,2,1},{1,0,2},{1,2,0},{2,0,1},{2,1,0}};
+  static const bool flips[4][3] = {{false,false,false},{true,true,false},{true,false,true},{false,true,true}};
+
+  int32_t best[6] = {0,0,0,0,0,0};
+  for (int p=0;p<6;p++)
+    for (int f=0;f<4;f++)
+    {
+      int32_t c[6];
+      for (int k=0;k<3;k++)
+      {
+        int column = permutations[p][k];
+        c[k]   = flips[f][k] ? j[column+3] : j[column];
+        c[k+3] = flips[f][k] ? j[column]   : j[column+3];
+      }
+      // Compare (j2,...,j6,j1).
+      int32_t a[6] = {c[1],c[2],c[3],c[4],c[5],c[0]};
+      int32_t b[6] = {best[1],best[2],best[3],best[4],best[5],best[0]};
+      if ((p == 0 && f == 0) || std::lexicographical_compare(a,a+6,b,b+6)) std::copy(c,c+6,best);
+    }
+  first = best[0];
+  key.symbol = 6;
+  std::copy(best+1,best+6,key.p);
+}
+
+SharedFamily computeFamily(const FamilyKey& key)
+{
+  const int32_t* p = key.p;
+  if (key.symbol == 3)
+    return std::make_shared<const std::vector<double> >(
+      wigner3j(0.5*p[0],0.5*p[1],0.5*p[2],0.5*p[3],0.5*p[4],SchultenGordonScaled));
+  return std::make_shared<const std::vector<double> >(
+    wigner6j(0.5*p[0],0.5*p[1],0.5*p[2],0.5*p[3],0.5*p[4],SchultenGordonScaled));
+}
+
+namespace {
+
+/*! Estimated memory of the bookkeeping of a family: the hash table and list
+ * nodes, and the control block of the shared vector. */
+const std::size_t entryOverhead = 160;
+
+} // namespace
+
+struct FamilyCache::State
+{
+  struct Entry
+  {
+    SharedFamily family;
+    std::list<FamilyKey>::iterator position;   //!< Unused for the pinned families.
+    std::size_t bytes;
+    bool pinned;
+  };
+
+  struct Shard
+  {
+    Shard() : bytes(0), pinned(0), hits(0), misses(0), evictions(0), contended(0) {}
+
+    std::mutex mutex;
+    std::unordered_map<FamilyKey,Entry,FamilyKeyHash> families;
+    std::list<FamilyKey> recent;   //!< Evictable families, most recently used first.
+    std::size_t bytes, pinned;
+    unsigned long long hits, misses, evictions, contended;
+    char padding[64];   //!< Keeps the locks of neighbouring shards on different cache lines.
+  };
+
+  std::size_t shardBytes, shardFamilies;
+  Shard       shard[shards];
+
+  Shard& of(const FamilyKey& key) { return shard[FamilyKeyHash()(key)%shards]; }
+
+  /*! Locks the shard, counting the lookups that have to wait. */
+  static std::unique_lock<std::mutex> lock(Shard& s)
+  {
+    std::unique_lock<std::mutex> guard(s.mutex,std::try_to_lock);
+    if (!guard.owns_lock())
+    {
+      guard.lock();
+      s.contended++;
+    }
+    return guard;
+  }
+
+  /*! Looks the family up in its locked shard, and counts the lookup. */
+  Entry* find(Shard& s, const FamilyKey& key)
+  {
+    auto it = s.families.find(key);
+    if (it == s.families.end())
+    {
+      s.misses++;
+      return 0;
+    }
+    s.hits++;
+    if (!it->second.pinned) s.recent.splice(s.recent.begin(),s.recent,it->second.position);
+    return &it->second;
+  }
+
+  /*! Computes the family outside of the lock of its shard, and keeps it
+   * unless it exceeds the limits of the shard by itself. */
+  SharedFamily compute(Shard& s, const FamilyKey& key)
+  {
+    SharedFamily family = computeFamily(key);
+    std::size_t bytes = family->size()*sizeof(double) + entryOverhead;
+    if (bytes > shardBytes || shardFamilies == 0) return family;
+
+    std::unique_lock<std::mutex> guard = lock(s);
+    // Another thread may have computed the same family meanwhile.
+    auto it = s.families.find(key);
+    if (it != s.families.end()) return it->second.family;
+    s.recent.push_front(key);
+    Entry entry = {family,s.recent.begin(),bytes,false};
+    s.families.insert(std::make_pair(key,entry));
+    s.bytes += bytes;
+    while (s.bytes > shardBytes || s.recent.size() > shardFamilies)
+    {
+      auto oldest = s.families.find(s.recent.back());
+      s.bytes -= oldest->second.bytes;
+      s.families.erase(oldest);
+      s.recent.pop_back();
+      s.evictions++;
+    }
+    return family;
+  }
+};
+
+FamilyCache::FamilyCache(std::size_t byteBudget, std::size_t maxFamilies)
+  : state(new State)
+{
+  state->shardBytes    = byteBudget/shards;
+  state->shardFamilies = maxFamilies == 0 ? 0 : std::max<std::size_t>(1,maxFamilies/shards);
+}
+
+FamilyCache::~FamilyCache() {}
+
+void FamilyCache::pin(const FamilyKey& key, const SharedFamily& family)
+{
+  State::Shard& s = state->of(key);
+  std::lock_guard<std::mutex> guard(s.mutex);
+  State::Entry entry = {family,s.recent.end(),0,true};
+  if (s.families.insert(std::make_pair(key,entry)).second) s.pinned++;
+}
+
+SharedFamily FamilyCache::get(const FamilyKey& key, bool* miss)
+{
+  State::Shard& s = state->of(key);
+  {
+    std::unique_lock<std::mutex> guard = State::lock(s);
+    State::Entry* entry = state->find(s,key);
+    if (miss) *miss = !entry;
+    if (entry) return entry->family;
+  }
+  return state->compute(s,key);
+}
+
+double FamilyCache::value(const FamilyKey& key, std::size_t index, bool* miss)
+{
+  State::Shard& s = state->of(key);
+  {
+    std::unique_lock<std::mutex> guard = State::lock(s);
+    State::Entry* entry = state->find(s,key);
+    if (miss) *miss = !entry;
+    if (entry) return (*entry->family)[index];
+  }
+  return (*state->compute(s,key))[index];
+}
+
+FamilyCacheStats FamilyCache::stats() const
+{
+  FamilyCacheStats c = {0,0,0,0,0,0,0};
+  for (int i=0;i<shards;i++)
+  {
+    State::Shard& s = state->shard[i];
+    std::lock_guard<std::mutex> guard(s.mutex);
+    c.hits      += s.hits;
+    c.misses    += s.misses;
+    c.evictions += s.evictions;
+    c.contended += s.contended;
+    c.families  += s.families.size();
+    c.pinned    += s.pinned;
+    c.bytes     += s.bytes;
+  }
+  return c;
+}
+
+void FamilyCache::clear()
+{
+  for (int i=0;i<shards;i++)
+  {
+    State::Shard& s = state->shard[i];
+    std::lock_guard<std::mutex> guard(s.mutex);
+    s.families.clear();
+    s.recent.clear();
+    s.bytes = s.pinned = 0;
+    s.hits = s.misses = s.evictions = s.contended = 0;
+  }
+}
+
+} // namespace WignerSymbols
@@ -0,0 +1,115 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html.              -/
+ ********************************************************/
+
+#include "../include/wignerSymbols/familyWalker.h"
+#include "../include/wignerSymbols/kernels.h"
+#include "../include/wignerSymbols/wignerSymbols-cpp.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace WignerSymbols {
+
+namespace {
+
+bool allowed(double l, double m)
+{
+  return std::fabs(m) <= l && std::floor(l+m) == l+m;
+}
+
+/*! Family (l2 l3; m1 m2 m3) on the grid l1 = l1min, ..., l1min+size-1.
+ * The symbols outside the family vanish. */
+void familyOnGrid(double l2, double l3, double m1, double m2, double m3,
+                  double l1min, std::vector<double>& out)
+{
+  std::fill(out.begin(),out.end(),0.0);
+  if (!allowed(l2,m2) || !allowed(l3,m3) || std::fabs(m1) > l2+l3) return;
+
+  std::vector<double> family = wigner3j(l2,l3,m1,m2,m3,SchultenGordonScaled);
+  double start = std::max(std::fabs(l2-l3),std::fabs(m1));
+  for (std::size_t i=0;i<family.size();i++)
+  {
+    double k = start+i-l1min;
+    if (k >= 0.0 && k < out.size()) out[(std::size_t)k] = family[i];
+  }
+}
+
+const double eps = std::numeric_limits<double>::epsilon();
+
+void reseed(Wigner3jWalker& w)
+{
+  familyOnGrid(w.l2,w.l3,w.m1,w.m2,w.m3,w.l1min,w.values);
+  familyOnGrid(w.l2,w.l3,w.m1+1.0,w.m2-1.0,w.m3,w.l1min,w.partner);
+  for (std::size_t i=0;i<w.values.size();i++)
+  {
+    w.errorF[i] = eps*std::fabs(w.values[i]);
+    w.errorH[i] = eps*std::fabs(w.partner[i]);
+  }
+  w.errorBound = eps;
+}
+
+} // namespace
+
+Wigner3jWalker wigner3jWalker(double l2, double l3, double m2, double m3, double tolerance)
+{
+  Wigner3jWalker w;
+  w.l2 = l2; w.l3 = l3; w.m1 = -m2-m3; w.m2 = m2; w.m3 = m3;
+  w.l1min     = std::max(std::fabs(l2-l3),std::fabs(w.m1));
+  w.tolerance = tolerance;
+  w.errorBound = 0.0;
+  w.steps     = 0;
+  w.reseeds   = 0;
+  if (!allowed(l2,m2) || !allowed(l3,m3) || w.l1min > l2+l3) return w;
+
+  std::size_t size = (std::size_t)(l2+l3-w.l1min+1.0);
+  w.values.resize(size);
+  w.partner.resize(size);
+  w.a1.resize(size);
+  w.errorF.resize(size);
+  w.errorH.resize(size);
+  for (std::size_t i=0;i<size;i++)
+  {
+    double l1 = w.l1min+i;
+    w.a1[i] = std::sqrt(std::max(0.0,(l1-w.m1)*(l1+w.m1+1.0)));
+  }
+  reseed(w);
+  return w;
+}
+
+bool step(Wigner3jWalker& w)
+{
+  if (w.values.empty() || w.m2-1.0 < -w.l2 || w.m3+1.0 > w.l3) return false;
+
+  const double l2 = w.l2, l3 = w.l3, m2 = w.m2, m3 = w.m3;
+  const double a2 = std::sqrt((l2-m2+1.0)*(l2+m2));
+  const double a3 = std::sqrt((l3-m3)*(l3+m3+1.0));
+  const double b2 = std::sqrt(std::max(0.0,(l2+m2-1.0)*(l2-m2+2.0)));
+
+  // F' = -(a1 H + a2 F)/a3, then H' = -(a1 F' + a3 H)/b2. H' vanishes at
+  // the end of the diagonal, where b2 = 0. The errors are propagated with
+  // the absolute values of the same coefficients, plus one rounding.
+  const double f = -a2/a3, h = -1.0/a3;
+  const double g = b2 > 0.0 ? -1.0/b2 : 0.0, k = b2 > 0.0 ? -a3/b2 : 0.0;
+  double largest, error;
+  kernels().walkerStep((int)w.values.size(),w.a1.data(),f,h,g,k,w.values.data(),
+                       w.partner.data(),w.errorF.data(),w.errorH.data(),&largest,&error);
+
+  w.m2 -= 1.0;
+  w.m3 += 1.0;
+  w.steps++;
+
+  w.errorBound = largest > 0.0 ? error/largest : 0.0;
+  if (w.errorBound > w.tolerance)
+  {
+    reseed(w);
+    w.reseeds++;
+  }
+  return true;
+}
+
+} // namespace WignerSymbols
@@ -0,0 +1,348 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html.              -/
+ ********************************************************/
+
+#include "../include/wignerSymbols/kernels.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define WIGNER_SYMBOLS_X86_DISPATCH
+#endif
+
+#if defined(__GNUC__)
+#define WIGNER_SYMBOLS_ALWAYS_INLINE inline __attribute__((always_inline))
+#else
+#define WIGNER_SYMBOLS_ALWAYS_INLINE inline
+#endif
+
+namespace WignerSymbols {
+
+namespace {
+
+// The bodies of the kernels are written once and inlined in a wrapper per
+// instruction set, so that the compiler vectorizes them for that target.
+// This file is compiled with -fno-math-errno and -fassociative-math, which
+// lets the square roots and the reduction vectorize.
+
+WIGNER_SYMBOLS_ALWAYS_INLINE
+void wigner3jCoefficientsBody(double l1min, int n,
+		double l2, double l3, double m1, double m2, double m3,
+		double* A, double* B)
+{
+	double d23 = (l2-l3)*(l2-l3);
+	double s23 = (l2+l3+1.0)*(l2+l3+1.0);
+	double mm  = m1*m1;
+	double c   = l2*(l2+1.0)*m1-l3*(l3+1.0)*m1;
+	for (int k=0;k<n;k++)
+	{
+		double l1 = l1min+k;
+		double l1sq = l1*l1;
+		A[k] = std::sqrt((l1sq-d23)*(s23-l1sq)*(l1sq-mm));
+		B[k] = -(2.0*l1+1.0)*(c-l1*(l1+1.0)*(m3-m2));
+	}
+}
+
+WIGNER_SYMBOLS_ALWAYS_INLINE
+void wigner6jCoefficientsBody(double l1min, int n,
+		double l2, double l3, double l4, double l5, double l6,
+		double* A, double* B)
+{
+	double d23 = (l2-l3)*(l2-l3);
+	double s23 = (l2+l3+1.0)*(l2+l3+1.0);
+	double d56 = (l5-l6)*(l5-l6);
+	double s56 = (l5+l6+1.0)*(l5+l6+1.0);
+	double j2 = l2*(l2+1.0), j3 = l3*(l3+1.0), j4 = l4*(l4+1.0);
+	double j5 = l5*(l5+1.0), j6 = l6*(l6+1.0);
+	for (int k=0;k<n;k++)
+	{
+		double l1 = l1min+k;
+		double l1sq = l1*l1;
+		double j1 = l1*(l1+1.0);
+		A[k] = std::sqrt((l1sq-d23)*(s23-l1sq)*(l1sq-d56)*(s56-l1sq));
+		B[k] = (2.0*l1+1.0)*(j1*(-j1+j2+j3)+j5*(j1+j2-j3)+j6*(j1-j2+j3)-2.0*j1*j4);
+	}
+}
+
+WIGNER_SYMBOLS_ALWAYS_INLINE
+void wigner3jPlanCoefficientsBody(double l1min, int n, const double* S,
+		double l2, double l3, double m1, double m2, double m3,
+		double* A, double* B)
+{
+	double mm = m1*m1;
+	double c  = l2*(l2+1.0)*m1-l3*(l3+1.0)*m1;
+	for (int k=0;k<n;k++)
+	{
+		double l1 = l1min+k;
+		A[k] = S[k]*std::sqrt(l1*l1-mm);
+		B[k] = -(2.0*l1+1.0)*(c-l1*(l1+1.0)*(m3-m2));
+	}
+}
+
+WIGNER_SYMBOLS_ALWAYS_INLINE
+void wigner6jPlanCoefficientsBody(double l1min, int n, const double* C, double l4, double* B)
+{
+	double j4 = l4*(l4+1.0);
+	for (int k=0;k<n;k++)
+	{
+		double l1 = l1min+k;
+		B[k] = C[k]-2.0*(2.0*l1+1.0)*l1*(l1+1.0)*j4;
+	}
+}
+
+WIGNER_SYMBOLS_ALWAYS_INLINE
+double normalizationSumBody(const double* f, int n, double l1min)
+{
+	double sum = 0.0;
+	for (int k=0;k<n;k++)
+		sum += (2.0*(l1min+k)+1.0)*f[k]*f[k];
+	return sum;
+}
+
+WIGNER_SYMBOLS_ALWAYS_INLINE
+void scaleBody(double* f, int n, double c)
+{
+	for (int k=0;k<n;k++)
+		f[k] *= c;
+}
+
+WIGNER_SYMBOLS_ALWAYS_INLINE
+void bispectrumBody(int ntriples, const int* rowBegin, const int* rows, const double* cg,
+		const double* re, const double* im, double* out)
+{
+	// The environments are the innermost dimension, so that every loop over
+	// e is a plain vector operation, whatever the length of the rows.
+	const int W = bispectrumWidth;
+	for (int t=0;t<ntriples;t++)
+	{
+		double b[W] = {0.0};
+		for (int r=rowBegin[t];r<rowBegin[t+1];r++)
+		{
+			const int* row = rows+4*r;
+			const double* re2 = re+row[1]*W;
+			const double* im2 = im+row[1]*W;
+			const double* rel = re+row[2]*W;
+			const double* iml = im+row[2]*W;
+			double sre[W] = {0.0}, sim[W] = {0.0};
+			for (int k=0;k<row[3];k++)
+			{
+				double c = cg[k];
+				for (int e=0;e<W;e++)
+				{
+					sre[e] += c*(re2[k*W+e]*rel[k*W+e]+im2[k*W+e]*iml[k*W+e]);
+					sim[e] += c*(im2[k*W+e]*rel[k*W+e]-re2[k*W+e]*iml[k*W+e]);
+				}
+			}
+			cg += row[3];
+
+			const double* re1 = re+row[0]*W;
+			const double* im1 = im+row[0]*W;
+			for (int e=0;e<W;e++)
+				b[e] += re1[e]*sre[e]-im1[e]*sim[e];
+		}
+		for (int e=0;e<W;e++)
+			out[t*W+e] = b[e];
+	}
+}
+
+WIGNER_SYMBOLS_ALWAYS_INLINE
+void walkerStepBody(int n, const double* a1, double f, double h, double g, double k,
+		double* F, double* H, double* eF, double* eH, double* largest, double* error)
+{
+	const double eps = std::numeric_limits<double>::epsilon();
+	const double af = std::fabs(f), ah = std::fabs(h), ag = std::fabs(g), ak = std::fabs(k);
+	double big = 0.0, err = 0.0;
+	for (int i=0;i<n;i++)
+	{
+		double next  = f*F[i]+h*a1[i]*H[i];
+		double eNext = af*eF[i]+ah*a1[i]*eH[i]+eps*std::fabs(next);
+		double hNext = g*a1[i]*next+k*H[i];
+		eH[i] = ag*a1[i]*eNext+ak*eH[i]+eps*std::fabs(hNext);
+		H[i]  = hNext;
+		F[i]  = next;
+		eF[i] = eNext;
+		big = std::fabs(next) > big ? std::fabs(next) : big;
+		err = eNext > err ? eNext : err;
+	}
+	*largest = big;
+	*error   = err;
+}
+
+WIGNER_SYMBOLS_ALWAYS_INLINE
+void dequantizeFloatBody(const float* in, int n, double* out)
+{
+	for (int k=0;k<n;k++)
+		out[k] = in[k];
+}
+
+WIGNER_SYMBOLS_ALWAYS_INLINE
+void dequantizeFixed16Body(const int16_t* in, int n, double scale, double* out)
+{
+	for (int k=0;k<n;k++)
+		out[k] = in[k]*scale;
+}
+
+// The gathers compute the position of each symbol in the loop that loads
+// it. The loads are scalar: the compilers we build with do not emit gather
+// instructions for these loops, even in the AVX2 and AVX-512 variants.
+template <typename T>
+WIGNER_SYMBOLS_ALWAYS_INLINE
+void gatherBody(const T* values, const std::size_t* offsets,
+		const std::size_t* family, const int* index, int n, double* out)
+{
+	for (int k=0;k<n;k++)
+		out[k] = values[offsets[family[k]]+index[k]];
+}
+
+WIGNER_SYMBOLS_ALWAYS_INLINE
+void gatherFixed16Body(const int16_t* values, const float* scales, const std::size_t* offsets,
+		const std::size_t* family, const int* index, int n, double* out)
+{
+	for (int k=0;k<n;k++)
+		out[k] = values[offsets[family[k]]+index[k]]*(double)scales[family[k]];
+}
+
+#define WIGNER_SYMBOLS_KERNELS(suffix, attributes)                                            \
+attributes void wigner3jCoefficients_##suffix(double l1min, int n,                           \
+		double l2, double l3, double m1, double m2, double m3, double* A, double* B)           \
+{ wigner3jCoefficientsBody(l1min,n,l2,l3,m1,m2,m3,A,B); }                                     \
+attributes void wigner6jCoefficients_##suffix(double l1min, int n,                           \
+		double l2, double l3, double l4, double l5, double l6, double* A, double* B)          \
+{ wigner6jCoefficientsBody(l1min,n,l2,l3,l4,l5,l6,A,B); }                                     \
+attributes void wigner3jPlanCoefficients_##suffix(double l1min, int n, const double* S,     \
+		double l2, double l3, double m1, double m2, double m3, double* A, double* B)           \
+{ wigner3jPlanCoefficientsBody(l1min,n,S,l2,l3,m1,m2,m3,A,B); }                               \
+attributes void wigner6jPlanCoefficients_##suffix(double l1min, int n, const double* C,     \
+		double l4, double* B)                                                                 \
+{ wigner6jPlanCoefficientsBody(l1min,n,C,l4,B); }                                             \
+attributes double normalizationSum_##suffix(const double* f, int n, double l1min)           \
+{ return normalizationSumBody(f,n,l1min); }                                                   \
+attributes void scale_##suffix(double* f, int n, double c)                                  \
+{ scaleBody(f,n,c); }                                                                         \
+attributes void dequantizeFloat_##suffix(const float* in, int n, double* out)               \
+{ dequantizeFloatBody(in,n,out); }                                                            \
+attributes void dequantizeFixed16_##suffix(const int16_t* in, int n, double scale,          \
+		double* out)                                                                          \
+{ dequantizeFixed16Body(in,n,scale,out); }                                                    \
+attributes void gatherDouble_##suffix(const double* values, const std::size_t* offsets,     \
+		const std::size_t* family, const int* index, int n, double* out)                      \
+{ gatherBody(values,offsets,family,index,n,out); }                                            \
+attributes void gatherFloat_##suffix(const float* values, const std::size_t* offsets,       \
+		const std::size_t* family, const int* index, int n, double* out)                      \
+{ gatherBody(values,offsets,family,index,n,out); }                                            \
+attributes void gatherFixed16_##suffix(const int16_t* values, const float* scales,          \
+		const std::size_t* offsets, const std::size_t* family, const int* index, int n,       \
+		double* out)                                                                          \
+{ gatherFixed16Body(values,scales,offsets,family,index,n,out); }                              \
+attributes void bispectrum_##suffix(int ntriples, const int* rowBegin, const int* rows,     \
+		const double* cg, const double* re, const double* im, double* out)                     \
+{ bispectrumBody(ntriples,rowBegin,rows,cg,re,im,out); }                                      \
+attributes void walkerStep_##suffix(int n, const double* a1, double f, double h, double g,  \
+		double k, double* F, double* H, double* eF, double* eH, double* largest, double* error) \
+{ walkerStepBody(n,a1,f,h,g,k,F,H,eF,eH,largest,error); }                                     \
+const Kernels kernels_##suffix = {                                                            \
+	wigner3jCoefficients_##suffix, wigner6jCoefficients_##suffix,                             \
+	wigner3jPlanCoefficients_##suffix, wigner6jPlanCoefficients_##suffix,                     \
+	normalizationSum_##suffix, scale_##suffix,                                                \
+	dequantizeFloat_##suffix, dequantizeFixed16_##suffix,                                     \
+	gatherDouble_##suffix, gatherFloat_##suffix, gatherFixed16_##suffix,                      \
+	bispectrum_##suffix, walkerStep_##suffix };
+
+WIGNER_SYMBOLS_KERNELS(baseline, )
+#ifdef WIGNER_SYMBOLS_X86_DISPATCH
+WIGNER_SYMBOLS_KERNELS(avx2,   __attribute__((target("avx2,fma"))))
+WIGNER_SYMBOLS_KERNELS(avx512, __attribute__((target("avx512f,fma"))))
+#endif
+
+#undef WIGNER_SYMBOLS_KERNELS
+
+InstructionSet bestInstructionSet()
+{
+	if (instructionSetSupported(AVX512)) return AVX512;
+	if (instructionSetSupported(AVX2))   return AVX2;
+	return Baseline;
+}
+
+InstructionSet selectInstructionSet()
+{
+	const char* name = std::getenv("WIGNER_SYMBOLS_ISA");
+	if (name)
+	{
+		InstructionSet all[] = {Baseline, AVX2, AVX512};
+		for (int k=0;k<3;k++)
+			if (std::strcmp(name,instructionSetName(all[k]))==0 && instructionSetSupported(all[k]))
+				return all[k];
+	}
+	return bestInstructionSet();
+}
+
+} // anonymous namespace
+
+bool instructionSetSupported(InstructionSet isa)
+{
+	switch (isa)
+	{
+	case Baseline:
+		return true;
+#ifdef WIGNER_SYMBOLS_X86_DISPATCH
+	case AVX2:
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+	case AVX512:
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("fma");
+#endif
+	default:
+		return false;
+	}
+}
+
+const char* instructionSetName(InstructionSet isa)
+{
+	switch (isa)
+	{
+	case AVX2:   return "avx2";
+	case AVX512: return "avx512";
+	default:     return "baseline";
+	}
+}
+
+const Kernels& kernels(InstructionSet isa)
+{
+	switch (isa)
+	{
+#ifdef WIGNER_SYMBOLS_X86_DISPATCH
+	case AVX2:   return kernels_avx2;
+	case AVX512: return kernels_avx512;
+#endif
+	default:     return kernels_baseline;
+	}
+}
+
+InstructionSet activeInstructionSet()
+{
+	static const InstructionSet isa = selectInstructionSet();
+	return isa;
+}
+
+const Kernels& kernels()
+{
+	static const Kernels& selected = kernels(activeInstructionSet());
+	return selected;
+}
+
+namespace {
+
+// We select the kernels when the library is loaded, so that the first
+// call does not pay for the detection.
+const Kernels& loadTimeSelection = kernels();
+
+} // anonymous namespace
+
+} // namespace WignerSymbols
@@ -0,0 +1,28 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html.              -/
+ ********************************************************/
+
+#include "../include/wignerSymbols/mEnumerators.h"
+#include "../include/wignerSymbols/wignerSymbols-cpp.h"
+
+namespace WignerSymbols {
+
+Wigner3jMTerms wigner3jMTerms(double l1, double l2, double l3, double m3)
+{
+  Wigner3jMTerms terms;
+  terms.l1 = l1;
+  terms.l2 = l2;
+  terms.l3 = l3;
+  terms.m3 = m3;
+
+  // (l1 l2 l3; m1 m2 m3) = (l3 l1 l2; m3 m1 m2), whose family in m1 starts
+  // at max(-l1,-l2-m3).
+  terms.m1min  = std::max(-l1,-l2-m3);
+  terms.values = wigner3j_m(l3,l1,l2,m3);
+  return terms;
+}
+
+} // namespace WignerSymbols
@@ -0,0 +1,195 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html.              -/
+ ********************************************************/
+
+#include "../include/wignerSymbols/quantizedTable.h"
+#include "../include/wignerSymbols/kernels.h"
+#include "../include/wignerSymbols/wignerSymbols-cpp.h"
+
+#include <atomic>
+
+namespace WignerSymbols {
+
+namespace {
+
+/*! Raises the shared maximum to value. */
+void raise(std::atomic<double>& maximum, double value)
+{
+  double current = maximum.load();
+  while (value > current && !maximum.compare_exchange_weak(current,value)) {}
+}
+
+/*! Allocates the storage of the families whose sizes are given by offsets. */
+void allocate(QuantizedTable& t)
+{
+  std::size_t n = t.offsets.back();
+  switch (t.storage)
+  {
+  case DoubleStorage:  t.doubles.assign(n,0.0); break;
+  case Float32Storage: t.floats.assign(n,0.0f); break;
+  case Fixed16Storage: t.fixed.assign(n,0); t.scales.assign(t.families(),1.0f); break;
+  }
+}
+
+/*! Stores the family k, of size n, and returns its largest error relative
+ * to its largest symbol. */
+double store(QuantizedTable& t, std::size_t k, const double* f, std::size_t n)
+{
+  double largest = 0.0;
+  for (std::size_t i=0;i<n;i++) largest = std::max(largest,std::fabs(f[i]));
+  if (largest == 0.0) return 0.0;
+
+  std::size_t at = t.offsets[k];
+  double error = 0.0;
+  switch (t.storage)
+  {
+  case DoubleStorage:
+    std::copy(f,f+n,t.doubles.begin()+at);
+    break;
+
+  case Float32Storage:
+    for (std::size_t i=0;i<n;i++)
+    {
+      t.floats[at+i] = (float)f[i];
+      error = std::max(error,std::fabs((double)t.floats[at+i]-f[i]));
+    }
+    break;
+
+  case Fixed16Storage:
+  {
+    // 2^(e-1) <= largest < 2^e.
+    double scale = std::ldexp(1.0,std::ilogb(largest)+1-15);
+    t.scales[k] = (float)scale;
+    for (std::size_t i=0;i<n;i++)
+    {
+      long q = std::lround(f[i]/scale);
+      q = std::max(-32768L,std::min(32767L,q));
+      t.fixed[at+i] = (int16_t)q;
+      error = std::max(error,std::fabs(q*scale-f[i]));
+    }
+    break;
+  }
+  }
+  return error/largest;
+}
+
+std::vector<double> compute(const Wigner3jFamily& f) { return wigner3j(f.l2,f.l3,f.m1,f.m2,f.m3); }
+std::vector<double> compute(const Wigner6jFamily& f) { return wigner6j(f.l2,f.l3,f.l4,f.l5,f.l6); }
+
+template <typename Family>
+QuantizedTable quantizedTable(const std::vector<Family>& families, TableStorage storage,
+                              unsigned int nthreads, SchedulerStats* stats)
+{
+  std::size_t n = families.size();
+
+  QuantizedTable t;
+  t.storage = storage;
+  t.offsets.assign(n+1,0);
+  std::vector<double> cost(n);
+  for (std::size_t k=0;k<n;k++)
+  {
+    t.offsets[k+1] = t.offsets[k]+familySize(families[k]);
+    cost[k]        = familyCost(families[k]);
+  }
+  allocate(t);
+
+  std::atomic<double> maxError(0.0);
+  parallelFor(n, cost, nthreads, [&](std::size_t k)
+  {
+    std::vector<double> f = compute(families[k]);
+    std::size_t size = std::min(f.size(),t.offsets[k+1]-t.offsets[k]);
+    raise(maxError,store(t,k,f.data(),size));
+  }, stats);
+
+  t.maxError = maxError.load();
+  return t;
+}
+
+} // anonymous namespace
+
+double storageErrorBound(TableStorage storage)
+{
+  switch (storage)
+  {
+  case Float32Storage: return std::ldexp(1.0,-24);
+  case Fixed16Storage: return std::ldexp(1.0,-14);
+  default:             return 0.0;
+  }
+}
+
+std::size_t QuantizedTable::bytes() const
+{
+  return doubles.size()*sizeof(double)+floats.size()*sizeof(float)
+        +fixed.size()*sizeof(int16_t)+scales.size()*sizeof(float);
+}
+
+double QuantizedTable::operator()(std::size_t k, int i) const
+{
+  std::size_t at = offsets[k]+i;
+  switch (storage)
+  {
+  case Float32Storage: return floats[at];
+  case Fixed16Storage: return fixed[at]*(double)scales[k];
+  default:             return doubles[at];
+  }
+}
+
+void QuantizedTable::family(std::size_t k, double* out) const
+{
+  std::size_t at = offsets[k];
+  int n = (int)(offsets[k+1]-at);
+  switch (storage)
+  {
+  case Float32Storage: kernels().dequantizeFloat(&floats[0]+at,n,out); break;
+  case Fixed16Storage: kernels().dequantizeFixed16(&fixed[0]+at,n,scales[k],out); break;
+  default:             std::copy(doubles.begin()+at,doubles.begin()+at+n,out); break;
+  }
+}
+
+void QuantizedTable::gather(const std::size_t* family, const int* index, std::size_t n, double* out) const
+{
+  const Kernels& kernel = kernels();
+  const int block = 1 << 16;
+  for (std::size_t j=0;j<n;j+=block)
+  {
+    int m = (int)std::min<std::size_t>(block,n-j);
+    switch (storage)
+    {
+    case Float32Storage: kernel.gatherFloat(floats.data(),offsets.data(),family+j,index+j,m,out+j); break;
+    case Fixed16Storage: kernel.gatherFixed16(fixed.data(),scales.data(),offsets.data(),family+j,index+j,m,out+j); break;
+    default:             kernel.gatherDouble(doubles.data(),offsets.data(),family+j,index+j,m,out+j); break;
+    }
+  }
+}
+
+QuantizedTable quantizeTable(const std::vector<double>& table, const std::vector<std::size_t>& offsets,
+                             TableStorage storage)
+{
+  QuantizedTable t;
+  t.storage  = storage;
+  t.offsets  = offsets;
+  t.maxError = 0.0;
+  if (offsets.empty()) t.offsets.push_back(0);
+  allocate(t);
+
+  for (std::size_t k=0;k<t.families();k++)
+    t.maxError = std::max(t.maxError,store(t,k,&table[0]+offsets[k],offsets[k+1]-offsets[k]));
+  return t;
+}
+
+QuantizedTable wigner3jQuantizedTable(const std::vector<Wigner3jFamily>& families, TableStorage storage,
+                                      unsigned int nthreads, SchedulerStats* stats)
+{
+  return quantizedTable(families,storage,nthreads,stats);
+}
+
+QuantizedTable wigner6jQuantizedTable(const std::vector<Wigner6jFamily>& families, TableStorage storage,
+                                      unsigned int nthreads, SchedulerStats* stats)
+{
+  return quantizedTable(families,storage,nthreads,stats);
+}
+
+} // namespace WignerSymbols
@@ -0,0 +1,92 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html.              -/
+ ********************************************************/
+
+#include "../include/wignerSymbols/recoupling.h"
+#include "../include/wignerSymbols/wignerSymbols-cpp.h"
+
+namespace WignerSymbols {
+
+namespace {
+
+/*! Number of values of j between jmin and jmax, in steps of one. */
+int count(double jmin, double jmax)
+{
+  double eps = std::numeric_limits<double>::epsilon();
+  int n = (int)std::floor(jmax-jmin+1.0+eps);
+  return (n > 0 ? n : 0);
+}
+
+}
+
+RecouplingMatrix recouplingMatrix(double j1, double j2, double j3, double J)
+{
+  RecouplingMatrix m;
+  m.j1 = j1; m.j2 = j2; m.j3 = j3; m.J = J;
+
+  // The intermediate momenta must couple with both of their partners.
+  m.j12min  = std::max(std::fabs(j1-j2),std::fabs(j3-J));
+  m.j23min  = std::max(std::fabs(j2-j3),std::fabs(j1-J));
+  m.rows    = count(m.j12min,std::min(j1+j2,j3+J));
+  m.cols    = count(m.j23min,std::min(j2+j3,j1+J));
+
+  // J must be reachable, with the parity of j1+j2+j3.
+  double parity = j1+j2+j3+J;
+  if (m.rows == 0 || m.cols == 0 || std::floor(parity) != parity)
+  {
+    m.rows = m.cols = 0;
+    return m;
+  }
+
+  m.data.assign((std::size_t)m.rows*m.cols,0.0);
+  double phase = ((long)parity%2 ? -1.0 : 1.0);
+
+  for (int r=0;r<m.rows;r++)
+  {
+    double j12 = m.j12min+r;
+
+    // {j1 j2 j12; j3 J j23} for all j23, by a single family call.
+    std::vector<double> sixcof = wigner6j(j3,j2,j12,j1,J,SchultenGordonScaled);
+    int n = std::min<int>(m.cols,sixcof.size());
+    for (int c=0;c<n;c++)
+    {
+      double j23 = m.j23min+c;
+      m.data[r+(std::size_t)c*m.rows] = phase*std::sqrt((2.0*j12+1.0)*(2.0*j23+1.0))*sixcof[c];
+    }
+  }
+
+  return m;
+}
+
+std::vector<RecouplingMatrix> recouplingMatrices(double j1, double j2, double j3,
+                                                 unsigned int nthreads, SchedulerStats* stats)
+{
+  // The total angular momenta reachable from (j1 j2)j12 and j3.
+  double Jmin = j1+j2+j3;
+  for (double j12=std::fabs(j1-j2);j12<=j1+j2;j12+=1.0)
+    Jmin = std::min(Jmin,std::max(0.0,std::fabs(j12-j3)));
+  int n = count(Jmin,j1+j2+j3);
+
+  // The cost of a block is the number of its elements.
+  std::vector<RecouplingMatrix> blocks(n);
+  std::vector<double> cost(n);
+  for (int k=0;k<n;k++)
+  {
+    double J  = Jmin+k;
+    int rows  = count(std::max(std::fabs(j1-j2),std::fabs(j3-J)),std::min(j1+j2,j3+J));
+    int cols  = count(std::max(std::fabs(j2-j3),std::fabs(j1-J)),std::min(j2+j3,j1+J));
+    cost[k]   = (double)rows*cols+rows;
+  }
+
+  parallelFor(n, cost, nthreads, [&](std::size_t k)
+  {
+    blocks[k] = recouplingMatrix(j1,j2,j3,Jmin+k);
+  }, stats);
+
+  return blocks;
+}
+
+} // namespace WignerSymbols
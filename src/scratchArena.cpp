@@ -0,0 +1,56 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html.              -/
+ ********************************************************/
+
+#include "../include/wignerSymbols/scratchArena.h"
+
+#include <algorithm>
+
+namespace WignerSymbols {
+
+ScratchArena::ScratchArena()
+  : buffer(0), cap(0), peak(0)
+{}
+
+ScratchArena::~ScratchArena()
+{
+  delete [] buffer;
+}
+
+double* ScratchArena::reserve(std::size_t n)
+{
+  peak = std::max(peak, n);
+
+  // We only grow the buffer. We at least double its size to amortize
+  // the cost of a sequence of slowly increasing requests.
+  if (n > cap)
+  {
+    std::size_t newCap = std::max(n, 2*cap);
+    delete [] buffer;
+    buffer = new double[newCap];
+    cap    = newCap;
+  }
+
+  return buffer;
+}
+
+void ScratchArena::trim(std::size_t n)
+{
+  if (n >= cap) return;
+
+  // The content does not need to be preserved.
+  delete [] buffer;
+  buffer = (n > 0 ? new double[n] : 0);
+  cap    = n;
+}
+
+ScratchArena& ScratchArena::local()
+{
+  static thread_local ScratchArena arena;
+  return arena;
+}
+
+} // namespace WignerSymbols
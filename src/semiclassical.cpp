@@ -0,0 +1,484 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html.              -/
+ ********************************************************/
+
+#include "../include/wignerSymbols/semiclassical.h"
+#include "../include/wignerSymbols/wignerSymbols-cpp.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace WignerSymbols {
+
+namespace {
+
+const double pi = 3.141592653589793238;
+
+/*! Smallest family for which we try the semiclassical approximation. Below
+ * that, the recursion is cheap and the approximation is poor anyway. */
+const double minimumFamilySize = 32.0;
+
+/*! Smallest distance of m2 and m3 to their bounds for which we try the
+ * semiclassical approximation of a 3j symbol. Closer to a stretched
+ * configuration, its error grows faster than our estimate of it. */
+const double minimumProjectionGap = 32.0;
+
+/*! Smallest distance of the triads (l4,l2,l6) and (l4,l5,l3) of a 6j
+ * symbol to their stretched configurations for which we try the
+ * semiclassical approximation. It plays the role of minimumProjectionGap:
+ * a small l4 brings both triads close to stretched. */
+const double minimumTriadGap = 32.0;
+
+/*! Factors between the measured differences and the error estimate. The 6j
+ * estimate falls short more often than the 3j one, by up to a factor of
+ * 1.6 in our samples away from the stretched triads. */
+const double errorSafetyFactor3j = 4.0;
+const double errorSafetyFactor6j = 8.0;
+
+/*! Distance of the triad (a,b,c) to its nearest stretched configuration. */
+double triadGap(double a, double b, double c)
+{
+	return std::min(a+b-c,std::min(a+c-b,b+c-a));
+}
+
+/*! Airy function of the first kind. We use the Maclaurin series on
+ * [-8,5] and the asymptotic expansions, truncated at their smallest
+ * term, elsewhere. */
+double airyAi(double x)
+{
+	const double c1 = 0.355028053887817239;
+	const double c2 = 0.258819403792806798;
+
+	if (x >= -8.0 && x <= 5.0)
+	{
+		double x3 = x*x*x;
+		double f = 1.0, tf = 1.0;
+		double g = x,   tg = x;
+		for (int k=1;k<200;k++)
+		{
+			tf *= x3/((3.0*k-1.0)*(3.0*k));
+			tg *= x3/((3.0*k)*(3.0*k+1.0));
+			f  += tf;
+			g  += tg;
+			if (std::fabs(tf)<1.0e-18*std::fabs(f) && std::fabs(tg)<1.0e-18*std::fabs(g))
+				break;
+		}
+		return c1*f-c2*g;
+	}
+
+	double y = std::fabs(x);
+	double z = 2.0/3.0*y*std::sqrt(y);
+
+	// u_k are the coefficients of the asymptotic expansions.
+	double u = 1.0, previous = 1.0;
+	if (x > 0.0)
+	{
+		double sum = 1.0, zk = 1.0;
+		for (int k=1;k<60;k++)
+		{
+			u  *= (6.0*k-5.0)*(6.0*k-3.0)*(6.0*k-1.0)/((2.0*k-1.0)*216.0*k);
+			zk *= -z;
+			double term = u/zk;
+			if (std::fabs(term) > previous) break;
+			previous = std::fabs(term);
+			sum += term;
+			if (previous < 1.0e-17) break;
+		}
+		return std::exp(-z)*sum/(2.0*std::sqrt(pi)*std::pow(y,0.25));
+	}
+
+	double P = 1.0, Q = 0.0, zk = 1.0;
+	for (int k=1;k<60;k++)
+	{
+		u  *= (6.0*k-5.0)*(6.0*k-3.0)*(6.0*k-1.0)/((2.0*k-1.0)*216.0*k);
+		zk *= z;
+		double term = u/zk;
+		if (term > previous || term < 1.0e-17) break;
+		previous = term;
+		if (k%2 == 0) P += ((k/2)%2     ? -term : term);
+		else          Q += (((k-1)/2)%2 ? -term : term);
+	}
+	return (std::sin(z+pi/4.0)*P-std::cos(z+pi/4.0)*Q)/(std::sqrt(pi)*std::pow(y,0.25));
+}
+
+/*! Gauss-Legendre nodes and weights on [0,1]. */
+struct GaussLegendre
+{
+	std::vector<double> x, w;
+
+	explicit GaussLegendre(int n)
+		: x(n), w(n)
+	{
+		for (int i=0;i<n;i++)
+		{
+			// Newton iteration on the Legendre polynomial of degree n.
+			double z = std::cos(pi*(i+0.75)/(n+0.5));
+			double dp = 1.0;
+			for (int it=0;it<100;it++)
+			{
+				double p1 = 1.0, p2 = 0.0;
+				for (int j=0;j<n;j++)
+				{
+					double p3 = p2;
+					p2 = p1;
+					p1 = ((2.0*j+1.0)*z*p2-j*p3)/(j+1.0);
+				}
+				dp = n*(z*p1-p2)/(z*z-1.0);
+				double z1 = z;
+				z = z1-p1/dp;
+				if (std::fabs(z-z1) < 1.0e-15) break;
+			}
+			x[i] = 0.5*(1.0-z);
+			w[i] = 1.0/((1.0-z*z)*dp*dp);
+		}
+	}
+
+	static const GaussLegendre& rule()
+	{
+		static const GaussLegendre gl(48);
+		return gl;
+	}
+};
+
+/*! Coefficients of the 3j recursion over l1, written in the symmetric form
+ * a(l1+1)g(l1+1)+b(l1)g(l1)+a(l1)g(l1-1) = 0, with g = sqrt(2l1+1)*f. */
+struct Wigner3jCoupling
+{
+	double l2, l3, m1, m2, m3;
+
+	double a(double j) const
+	{
+		return wigner3j_auxA(j,l2,l3,m1,m2,m3)/(j*std::sqrt((2.0*j-1.0)*(2.0*j+1.0)));
+	}
+	double b(double j) const
+	{
+		return wigner3j_auxB(j,l2,l3,m1,m2,m3)/(j*(j+1.0)*(2.0*j+1.0));
+	}
+	double l1min()  const { return std::max(std::fabs(l2-l3),std::fabs(m1)); }
+	double l1max()  const { return l2+l3; }
+	double weight(double j) const { return 2.0*j+1.0; }
+	double signMax() const { return std::pow(-1.0,l2-l3-m1); }
+};
+
+/*! Coefficients of the 6j recursion over l1, with g = sqrt((2l1+1)(2l4+1))*f. */
+struct Wigner6jCoupling
+{
+	double l2, l3, l4, l5, l6;
+
+	double a(double j) const
+	{
+		return wigner6j_auxA(j,l2,l3,l4,l5,l6)/(j*std::sqrt((2.0*j-1.0)*(2.0*j+1.0)));
+	}
+	double b(double j) const
+	{
+		return wigner6j_auxB(j,l2,l3,l4,l5,l6)/(j*(j+1.0)*(2.0*j+1.0));
+	}
+	double l1min()  const { return std::max(std::fabs(l2-l3),std::fabs(l5-l6)); }
+	double l1max()  const { return std::min(l2+l3,l5+l6); }
+	double weight(double j) const { return (2.0*j+1.0)*(2.0*l4+1.0); }
+	double signMax() const { return std::pow(-1.0,std::floor(l2+l3+l5+l6+1.0e-10)); }
+};
+
+/*! The symmetric recursion couples g(j) and g(j+1) through a(j+1). We
+ * attach this coupling to the midpoint j+1/2, either by evaluating a there
+ * (Centered) or by taking the geometric mean of its neighbours (Geometric).
+ * Both are second-order accurate; their difference measures the error. */
+enum Discretization { Centered, Geometric };
+
+/*! Uniform semiclassical solution of the symmetric recursion. The classical
+ * region lies between the turning points jm and jp, where
+ * x(j) = -b(j)/(2abar(j)) = cos(theta(j)) lies in [-1,1]. Each solution is
+ * anchored at one turning point and written with the Airy function of the
+ * phase integral from that point. */
+template <class Coupling>
+class UniformApproximation
+{
+public:
+	UniformApproximation(const Coupling& c, Discretization d)
+		: coupling(c), discretization(d), jm(0.0), jp(0.0), typeM(1), typeP(1),
+		  norm(0.0), signLower(1.0), gap(0.0), ok(false)
+	{
+		ok = initialize();
+	}
+
+	bool valid() const { return ok; }
+
+	/*! Largest difference between the two anchored solutions around the
+	 * middle of the classical region, where we switch from one to the other. */
+	double mismatch() const { return gap; }
+
+	/*! Value of the symbol at l1 = j. */
+	double operator()(double j) const
+	{
+		double g;
+		if (j >= 0.5*(jm+jp))
+			g = coupling.signMax()*signUpper(j)*solution(j,jp,typeP,-1);
+		else
+			g = signLower*signLowerEnd(j)*solution(j,jm,typeM,1);
+		return norm*g/std::sqrt(coupling.weight(j));
+	}
+
+private:
+	double abar(double j) const
+	{
+		if (discretization == Geometric)
+			return std::sqrt(coupling.a(j)*coupling.a(j+1.0));
+		return coupling.a(j+0.5);
+	}
+
+	double x(double j) const { return -coupling.b(j)/(2.0*abar(j)); }
+
+	/*! Discriminant, positive in the classical region. */
+	double discriminant(double j) const
+	{
+		double ab = abar(j), b = coupling.b(j);
+		return 4.0*ab*ab-b*b;
+	}
+
+	double bisect(double lo, double hi) const
+	{
+		double dlo = discriminant(lo);
+		for (int it=0;it<200 && hi-lo > 1.0e-12*(1.0+std::fabs(lo));it++)
+		{
+			double mid = 0.5*(lo+hi);
+			double dmid = discriminant(mid);
+			if ((dmid > 0.0) == (dlo > 0.0)) { lo = mid; dlo = dmid; }
+			else                              hi = mid;
+		}
+		return 0.5*(lo+hi);
+	}
+
+	bool initialize()
+	{
+		double lo = coupling.l1min()+0.5;
+		double hi = coupling.l1max()-0.5;
+
+		// We bracket the turning points on a uniform grid. We require a
+		// single classical region, separated from both ends of the family
+		// by a classically forbidden region.
+		const int n = 64;
+		std::vector<double> roots;
+		double jPrev = lo, dPrev = discriminant(lo);
+		if (dPrev > 0.0) return false;
+		for (int k=1;k<=n;k++)
+		{
+			double j = lo+(hi-lo)*k/n;
+			double d = discriminant(j);
+			if ((d > 0.0) != (dPrev > 0.0))
+			{
+				if (roots.size() == 2) return false;
+				roots.push_back(bisect(jPrev,j));
+			}
+			jPrev = j;
+			dPrev = d;
+		}
+		if (roots.size() != 2) return false;
+		jm = roots[0];
+		jp = roots[1];
+
+		// At a turning point where x=-1, the solution alternates in sign.
+		typeM = (x(jm) > 0.0 ? 1 : -1);
+		typeP = (x(jp) > 0.0 ? 1 : -1);
+
+		// The normalization follows from the average of g^2 over the
+		// classical region, int dj/(abar sin(theta)) = int 2dj/sqrt(D).
+		// We use a Gauss-Chebyshev quadrature.
+		const int nc = 128;
+		double sum = 0.0, h = 0.5*(jp-jm), c = 0.5*(jp+jm);
+		for (int k=1;k<=nc;k++)
+		{
+			double t = std::cos((2.0*k-1.0)*pi/(2.0*nc));
+			double d = std::max(discriminant(c+h*t),0.0);
+			sum += h*std::sqrt(1.0-t*t)*2.0/std::sqrt(d);
+		}
+		sum *= pi/nc;
+		norm = std::sqrt(2.0/sum);
+
+		// We fix the relative sign of the two solutions by matching them
+		// in the middle of the classical region, away from the nodes.
+		double mid = std::floor(c), best = -1.0;
+		double gp[3], gm[3];
+		for (int k=0;k<3;k++)
+		{
+			double j = mid+k-1.0;
+			gp[k] = coupling.signMax()*signUpper(j)*solution(j,jp,typeP,-1);
+			gm[k] = signLowerEnd(j)*solution(j,jm,typeM,1);
+			double q = std::min(std::fabs(gp[k]),std::fabs(gm[k]));
+			if (q > best)
+			{
+				best = q;
+				signLower = (gp[k]*gm[k] > 0.0 ? 1.0 : -1.0);
+			}
+		}
+		for (int k=0;k<3;k++)
+			gap = std::max(gap,norm*std::fabs(gp[k]-signLower*gm[k])/std::sqrt(coupling.weight(mid+k-1.0)));
+		return true;
+	}
+
+	double phase(double j, int type) const
+	{
+		double theta = std::acos(std::max(-1.0,std::min(1.0,x(j))));
+		return (type > 0 ? theta : pi-theta);
+	}
+
+	double decay(double j) const
+	{
+		return std::acosh(std::max(1.0,std::fabs(x(j))));
+	}
+
+	/*! Uniform solution anchored at the turning point jt. The classical
+	 * region lies on the side given by direction. */
+	double solution(double j, double jt, int type, int direction) const
+	{
+		const GaussLegendre& gl = GaussLegendre::rule();
+		double distance = (j-jt)*direction;
+		bool   allowed  = (distance > 0.0);
+
+		// We substitute j = jt+(j-jt)u^2 to remove the square root
+		// singularity of the integrand at the turning point.
+		double S = 0.0;
+		for (std::size_t i=0;i<gl.x.size();i++)
+		{
+			double u  = gl.x[i];
+			double ju = jt+(j-jt)*u*u;
+			S += gl.w[i]*(allowed ? phase(ju,type) : decay(ju))*2.0*u;
+		}
+		S *= std::fabs(distance);
+
+		double zeta = std::pow(1.5*S,2.0/3.0);
+		if (allowed)
+			return std::sqrt(pi)*std::pow(zeta,0.25)/std::sqrt(abar(j)*std::sin(phase(j,type)))*airyAi(-zeta);
+		return std::sqrt(pi)*std::pow(zeta,0.25)/std::sqrt(abar(j)*std::sinh(decay(j)))*airyAi(zeta);
+	}
+
+	/*! Sign alternation of the solution anchored at a turning point of
+	 * negative type, counted from the corresponding end of the family. */
+	double signUpper(double j) const
+	{
+		if (typeP > 0) return 1.0;
+		return ((long)std::floor(coupling.l1max()-j+0.5)%2 ? -1.0 : 1.0);
+	}
+	double signLowerEnd(double j) const
+	{
+		if (typeM > 0) return 1.0;
+		return ((long)std::floor(j-coupling.l1min()+0.5)%2 ? -1.0 : 1.0);
+	}
+
+	Coupling       coupling;
+	Discretization discretization;
+	double         jm, jp;
+	int            typeM, typeP;
+	double         norm;
+	double         signLower;
+	double         gap;
+	bool           ok;
+};
+
+/*! Evaluates the symbol at l1 with both discretizations. Returns false if
+ * the approximation does not apply, or if the estimated error, scaled by
+ * safety, exceeds the tolerance. */
+template <class Coupling>
+bool semiclassical(const Coupling& c, double l1, double tolerance, double safety,
+					double& value, double& error)
+{
+	double l1min = c.l1min(), l1max = c.l1max();
+	if (l1max-l1min < minimumFamilySize) return false;
+
+	UniformApproximation<Coupling> centered(c,Centered);
+	if (!centered.valid()) return false;
+	UniformApproximation<Coupling> geometric(c,Geometric);
+	if (!geometric.valid()) return false;
+
+	// The difference vanishes at the nodes of the symbol, so we take the
+	// largest difference over the neighbours of l1. We stay away from the
+	// ends of the family, where the geometric mean vanishes.
+	error = 0.0;
+	for (int k=-1;k<=1;k++)
+	{
+		double j = std::max(l1min+1.0,std::min(l1max-1.0,l1+k));
+		error = std::max(error,std::fabs(centered(j)-geometric(j)));
+	}
+	// The difference of the discretizations misses the error accumulated
+	// by the phase integrals, which shows up as a mismatch between the
+	// solutions anchored at either turning point.
+	error = safety*std::max(error,centered.mismatch());
+	if (!(error <= tolerance)) return false;
+
+	value = centered(l1);
+	return true;
+}
+
+} // anonymous namespace
+
+double wigner3j_semiclassical(double l1, double l2, double l3,
+						double m1, double m2, double m3,
+						double tolerance, double* error)
+{
+	if (error) *error = 0.0;
+
+	// We enforce the selection rules.
+	bool select = (
+		   std::fabs(m1+m2+m3)<1.0e-10
+		&& std::floor(l1+l2+l3)==(l1+l2+l3)
+		&& l3 >= std::fabs(l1-l2)
+		&& l3 <= l1+l2
+		&& std::fabs(m1) <= l1
+		&& std::fabs(m2) <= l2
+		&& std::fabs(m3) <= l3
+		);
+
+	if (!select) return 0.0;
+
+	Wigner3jCoupling c = {l2,l3,m1,m2,m3};
+	double value, estimate;
+	bool stretched = (l2-std::fabs(m2) < minimumProjectionGap
+				   || l3-std::fabs(m3) < minimumProjectionGap);
+	if (!stretched && semiclassical(c,l1,tolerance,errorSafetyFactor3j,value,estimate))
+	{
+		if (error) *error = estimate;
+		return value;
+	}
+
+	int index = (int)(l1-c.l1min());
+	return wigner3j(l2,l3,m1,m2,m3,SchultenGordonScaled)[index];
+}
+
+double wigner6j_semiclassical(double l1, double l2, double l3,
+						double l4, double l5, double l6,
+						double tolerance, double* error)
+{
+	if (error) *error = 0.0;
+
+	// We enforce the selection rules on the triads.
+	bool select = (
+		   std::fabs(l1-l2) <= l3 && l3 <= l1+l2
+		&& std::fabs(l1-l5) <= l6 && l6 <= l1+l5
+		&& std::fabs(l4-l2) <= l6 && l6 <= l4+l2
+		&& std::fabs(l4-l5) <= l3 && l3 <= l4+l5
+		&& std::floor(l1+l2+l3)==(l1+l2+l3)
+		&& std::floor(l1+l5+l6)==(l1+l5+l6)
+		&& std::floor(l4+l2+l6)==(l4+l2+l6)
+		&& std::floor(l4+l5+l3)==(l4+l5+l3)
+		);
+
+	if (!select) return 0.0;
+
+	Wigner6jCoupling c = {l2,l3,l4,l5,l6};
+	double value, estimate;
+	bool stretched = (triadGap(l4,l2,l6) < minimumTriadGap
+				   || triadGap(l4,l5,l3) < minimumTriadGap);
+	if (!stretched && semiclassical(c,l1,tolerance,errorSafetyFactor6j,value,estimate))
+	{
+		if (error) *error = estimate;
+		return value;
+	}
+
+	int index = (int)(l1-c.l1min());
+	return wigner6j(l2,l3,l4,l5,l6,SchultenGordonScaled)[index];
+}
+
+} // namespace WignerSymbols
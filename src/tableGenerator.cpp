@@ -0,0 +1,144 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html.              -/
+ ********************************************************/
+
+#include "../include/wignerSymbols/tableGenerator.h"
+#include "../include/wignerSymbols/wignerSymbols-cpp.h"
+
+namespace WignerSymbols {
+
+namespace {
+
+// Short families are dominated by the allocation and the normalization,
+// hence the constant term of the cost.
+const double familyOverhead = 8.0;
+
+}
+
+std::size_t familySize(const Wigner3jFamily& f)
+{
+  double eps   = std::numeric_limits<double>::epsilon();
+  double l1min = std::max(std::fabs(f.l2-f.l3),std::fabs(f.m1));
+  double l1max = f.l2+f.l3;
+  int size     = (int)std::floor(l1max-l1min+1.0+eps);
+
+  return (size > 0 ? size : 0);
+}
+
+std::size_t familySize(const Wigner6jFamily& f)
+{
+  double eps   = std::numeric_limits<double>::epsilon();
+  double l1min = std::max(std::fabs(f.l2-f.l3),std::fabs(f.l5-f.l6));
+  double l1max = std::min(f.l2+f.l3,f.l5+f.l6);
+  int size     = (int)std::floor(l1max-l1min+1.0+eps);
+
+  return (size > 0 ? size : 0);
+}
+
+std::vector<Wigner3jFamily> wigner3jFamilies(int lmax)
+{
+  std::vector<Wigner3jFamily> families;
+  for (int l2=0;l2<=lmax;l2++)
+    for (int l3=0;l3<=l2;l3++)
+      for (int m2=-l2;m2<=l2;m2++)
+        for (int m3=-l3;m3<=l3;m3++)
+        {
+          Wigner3jFamily f = {(double)l2, (double)l3, (double)(-m2-m3), (double)m2, (double)m3};
+          families.push_back(f);
+        }
+
+  return families;
+}
+
+std::vector<Wigner6jFamily> wigner6jFamilies(int lmax)
+{
+  std::vector<Wigner6jFamily> families;
+  for (int l2=0;l2<=lmax;l2++)
+    for (int l3=0;l3<=lmax;l3++)
+      for (int l4=0;l4<=lmax;l4++)
+        for (int l5=0;l5<=lmax;l5++)
+          for (int l6=0;l6<=lmax;l6++)
+          {
+            // Triangle relations of the tryads that do not involve l1.
+            if (l6 < std::abs(l4-l2) || l6 > l4+l2) continue;
+            if (l3 < std::abs(l4-l5) || l3 > l4+l5) continue;
+
+            Wigner6jFamily f = {(double)l2, (double)l3, (double)l4, (double)l5, (double)l6};
+            if (familySize(f) > 0) families.push_back(f);
+          }
+
+  return families;
+}
+
+double familyCost(const Wigner3jFamily& family)
+{
+  return familySize(family)+familyOverhead;
+}
+
+double familyCost(const Wigner6jFamily& family)
+{
+  return familySize(family)+familyOverhead;
+}
+
+std::vector<double> wigner3jTable(const std::vector<Wigner3jFamily>& families,
+                                  std::vector<std::size_t>& offsets,
+                                  unsigned int nthreads, SchedulerStats* stats)
+{
+  std::size_t n = families.size();
+
+  // We compute the position and the cost of each family.
+  std::vector<double> cost(n);
+  offsets.assign(n+1,0);
+  for (std::size_t k=0;k<n;k++)
+  {
+    std::size_t size = familySize(families[k]);
+    offsets[k+1]     = offsets[k]+size;
+    cost[k]          = familyCost(families[k]);
+  }
+
+  std::vector<double> table(offsets[n],0.0);
+
+  parallelFor(n, cost, nthreads, [&](std::size_t k)
+  {
+    const Wigner3jFamily& f = families[k];
+    std::vector<double> thrcof = wigner3j(f.l2,f.l3,f.m1,f.m2,f.m3);
+    std::size_t size = std::min(thrcof.size(), offsets[k+1]-offsets[k]);
+    std::copy(thrcof.begin(), thrcof.begin()+size, table.begin()+offsets[k]);
+  }, stats);
+
+  return table;
+}
+
+std::vector<double> wigner6jTable(const std::vector<Wigner6jFamily>& families,
+                                  std::vector<std::size_t>& offsets,
+                                  unsigned int nthreads, SchedulerStats* stats)
+{
+  std::size_t n = families.size();
+
+  // We compute the position and the cost of each family.
+  std::vector<double> cost(n);
+  offsets.assign(n+1,0);
+  for (std::size_t k=0;k<n;k++)
+  {
+    std::size_t size = familySize(families[k]);
+    offsets[k+1]     = offsets[k]+size;
+    cost[k]          = familyCost(families[k]);
+  }
+
+  std::vector<double> table(offsets[n],0.0);
+
+  parallelFor(n, cost, nthreads, [&](std::size_t k)
+  {
+    const Wigner6jFamily& f = families[k];
+    std::vector<double> sixcof = wigner6j(f.l2,f.l3,f.l4,f.l5,f.l6);
+    std::size_t size = std::min(sixcof.size(), offsets[k+1]-offsets[k]);
+    std::copy(sixcof.begin(), sixcof.begin()+size, table.begin()+offsets[k]);
+  }, stats);
+
+  return table;
+}
+
+} // namespace WignerSymbols
@@ -0,0 +1,461 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html.              -/
+ ********************************************************/
+
+#include "../include/wignerSymbols/tableShards.h"
+#include "../include/wignerSymbols/wignerSymbols-cpp.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#include <stdint.h>
+
+namespace WignerSymbols {
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+const char     shardMagic[8] = {'W','I','G','S','H','A','R','D'};
+const uint32_t shardVersion  = 1;
+
+struct ShardHeader
+{
+  char     magic[8];
+  uint32_t version;
+  int32_t  symbol;
+  int32_t  lmax;
+  int32_t  part;
+  int32_t  parts;
+  uint32_t reserved;
+  uint64_t firstFamily;
+  uint64_t families;
+  uint64_t totalFamilies;
+  uint64_t values;
+  uint64_t checksum;
+};
+
+/*! Hash of a sequence of 64-bit words, in the manner of FNV-1a. It is
+ * updated one word at a time, so that a file can be checked in pieces. */
+struct Checksum
+{
+  uint64_t h;
+
+  Checksum() : h(14695981039346656037ULL) {}
+
+  void update(const void* data, std::size_t words)
+  {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    for (std::size_t i=0;i<words;i++)
+    {
+      uint64_t w;
+      std::memcpy(&w,p+8*i,8);
+      h = (h^w)*1099511628211ULL;
+    }
+  }
+};
+
+void setError(std::string* error, const std::string& message)
+{
+  if (error) *error = message;
+}
+
+void parameters3j(const Wigner3jFamily& f, double* q)
+{
+  q[0] = f.l2; q[1] = f.l3; q[2] = f.m1; q[3] = f.m2; q[4] = f.m3;
+}
+
+void parameters6j(const Wigner6jFamily& f, double* q)
+{
+  q[0] = f.l2; q[1] = f.l3; q[2] = f.l4; q[3] = f.l5; q[4] = f.l6;
+}
+
+/*! Parameters of the canonical families, five per family. */
+std::vector<double> canonicalParameters(int symbol, int lmax)
+{
+  std::vector<double> p;
+  if (symbol == 3)
+  {
+    std::vector<Wigner3jFamily> families = wigner3jFamilies(lmax);
+    for (std::size_t k=0;k<families.size();k++)
+    {
+      double q[5];
+      parameters3j(families[k],q);
+      p.insert(p.end(),q,q+5);
+    }
+  }
+  else
+  {
+    std::vector<Wigner6jFamily> families = wigner6jFamilies(lmax);
+    for (std::size_t k=0;k<families.size();k++)
+    {
+      double q[5];
+      parameters6j(families[k],q);
+      p.insert(p.end(),q,q+5);
+    }
+  }
+  return p;
+}
+
+std::vector<double> recompute(int symbol, const double* q)
+{
+  return (symbol == 3 ? wigner3j(q[0],q[1],q[2],q[3],q[4]) : wigner6j(q[0],q[1],q[2],q[3],q[4]));
+}
+
+template <typename Family>
+TableShard makeShard(int symbol, int lmax, int part, int parts,
+                     const std::vector<Family>& families, void (*parameters)(const Family&, double*),
+                     std::vector<double> (*table)(const std::vector<Family>&, std::vector<std::size_t>&,
+                                                  unsigned int, SchedulerStats*),
+                     unsigned int nthreads, SchedulerStats* stats)
+{
+  std::vector<double> cost(families.size());
+  for (std::size_t k=0;k<families.size();k++)
+    cost[k] = familyCost(families[k]);
+  std::vector<std::size_t> bounds = partitionFamilies(cost,parts);
+
+  TableShard shard;
+  shard.symbol        = symbol;
+  shard.lmax          = lmax;
+  shard.part          = part;
+  shard.parts         = parts;
+  shard.totalFamilies = families.size();
+
+  std::size_t first = (part >= 0 && part < parts ? bounds[part] : 0);
+  std::size_t last  = (part >= 0 && part < parts ? bounds[part+1] : 0);
+  shard.firstFamily = first;
+
+  std::vector<Family> range(families.begin()+first,families.begin()+last);
+  std::vector<std::size_t> offsets;
+  shard.values = table(range,offsets,nthreads,stats);
+  shard.offsets.assign(offsets.begin(),offsets.end());
+
+  for (std::size_t k=0;k<range.size();k++)
+  {
+    double q[5];
+    parameters(range[k],q);
+    shard.parameters.insert(shard.parameters.end(),q,q+5);
+  }
+  return shard;
+}
+
+bool readHeader(FILE* file, ShardHeader& header)
+{
+  return std::fread(&header,sizeof(header),1,file) == 1
+      && std::memcmp(header.magic,shardMagic,sizeof(shardMagic)) == 0
+      && header.version == shardVersion
+      && (header.symbol == 3 || header.symbol == 6);
+}
+
+} // anonymous namespace
+
+std::vector<std::size_t> partitionFamilies(const std::vector<double>& cost, int parts)
+{
+  parts = std::max(parts,1);
+  std::size_t n = cost.size();
+
+  double total = 0.0;
+  for (std::size_t k=0;k<n;k++) total += cost[k];
+
+  // The range p ends at the first task whose prefix cost reaches a
+  // fraction (p+1)/parts of the total.
+  std::vector<std::size_t> bounds(parts+1,n);
+  bounds[0] = 0;
+  double prefix = 0.0;
+  std::size_t k = 0;
+  for (int p=1;p<parts;p++)
+  {
+    double target = total*p/parts;
+    while (k < n && prefix+0.5*cost[k] < target) prefix += cost[k++];
+    bounds[p] = k;
+  }
+  return bounds;
+}
+
+TableShard wigner3jShard(int lmax, int part, int parts, unsigned int nthreads, SchedulerStats* stats)
+{
+  return makeShard(3,lmax,part,parts,wigner3jFamilies(lmax),parameters3j,wigner3jTable,nthreads,stats);
+}
+
+TableShard wigner6jShard(int lmax, int part, int parts, unsigned int nthreads, SchedulerStats* stats)
+{
+  return makeShard(6,lmax,part,parts,wigner6jFamilies(lmax),parameters6j,wigner6jTable,nthreads,stats);
+}
+
+bool writeTableShard(const std::string& path, const TableShard& shard, std::string* error)
+{
+  ShardHeader header;
+  std::memset(&header,0,sizeof(header));
+  std::memcpy(header.magic,shardMagic,sizeof(shardMagic));
+  header.version       = shardVersion;
+  header.symbol        = shard.symbol;
+  header.lmax          = shard.lmax;
+  header.part          = shard.part;
+  header.parts         = shard.parts;
+  header.firstFamily   = shard.firstFamily;
+  header.families      = shard.families();
+  header.totalFamilies = shard.totalFamilies;
+  header.values        = shard.values.size();
+
+  std::vector<uint64_t> offsets(shard.offsets.begin(),shard.offsets.end());
+  if (offsets.empty()) offsets.push_back(0);
+
+  Checksum sum;
+  sum.update(shard.parameters.data(),shard.parameters.size());
+  sum.update(offsets.data(),offsets.size());
+  sum.update(shard.values.data(),shard.values.size());
+  header.checksum = sum.h;
+
+  FILE* file = std::fopen(path.c_str(),"wb");
+  if (!file)
+  {
+    setError(error,"cannot open "+path);
+    return false;
+  }
+  bool ok = std::fwrite(&header,sizeof(header),1,file) == 1
+         && std::fwrite(shard.parameters.data(),sizeof(double),shard.parameters.size(),file) == shard.parameters.size()
+         && std::fwrite(offsets.data(),sizeof(uint64_t),offsets.size(),file) == offsets.size()
+         && std::fwrite(shard.values.data(),sizeof(double),shard.values.size(),file) == shard.values.size();
+  ok = (std::fclose(file) == 0) && ok;
+  if (!ok) setError(error,"cannot write "+path);
+  return ok;
+}
+
+bool readTableShard(const std::string& path, TableShard& shard, std::string* error)
+{
+  FILE* file = std::fopen(path.c_str(),"rb");
+  if (!file)
+  {
+    setError(error,"cannot open "+path);
+    return false;
+  }
+
+  ShardHeader header;
+  bool ok = readHeader(file,header);
+  std::vector<uint64_t> offsets;
+  if (ok)
+  {
+    shard.symbol        = header.symbol;
+    shard.lmax          = header.lmax;
+    shard.part          = header.part;
+    shard.parts         = header.parts;
+    shard.firstFamily   = header.firstFamily;
+    shard.totalFamilies = header.totalFamilies;
+    shard.parameters.resize(5*header.families);
+    offsets.resize(header.families+1);
+    shard.values.resize(header.values);
+    ok = std::fread(shard.parameters.data(),sizeof(double),shard.parameters.size(),file) == shard.parameters.size()
+      && std::fread(offsets.data(),sizeof(uint64_t),offsets.size(),file) == offsets.size()
+      && std::fread(shard.values.data(),sizeof(double),shard.values.size(),file) == shard.values.size();
+  }
+  std::fclose(file);
+  if (!ok)
+  {
+    setError(error,path+" is not a valid shard");
+    return false;
+  }
+
+  Checksum sum;
+  sum.update(shard.parameters.data(),shard.parameters.size());
+  sum.update(offsets.data(),offsets.size());
+  sum.update(shard.values.data(),shard.values.size());
+  if (sum.h != header.checksum || offsets.back() != header.values)
+  {
+    setError(error,"checksum mismatch in "+path);
+    return false;
+  }
+
+  shard.offsets.assign(offsets.begin(),offsets.end());
+  return true;
+}
+
+ShardMergeStats mergeTableShards(const std::vector<std::string>& shards, const std::string& output,
+                                 unsigned long long verifyStride)
+{
+  ShardMergeStats stats;
+  stats.ok = false;
+  stats.families = stats.values = stats.verified = 0;
+  stats.seconds = 0.0;
+  Clock::time_point start = Clock::now();
+
+  // We first read the headers, to order the shards and check that they
+  // are the parts of one partition and cover the table.
+  std::vector<std::pair<ShardHeader,std::string> > parts;
+  for (std::size_t s=0;s<shards.size();s++)
+  {
+    FILE* file = std::fopen(shards[s].c_str(),"rb");
+    ShardHeader header;
+    bool ok = file && readHeader(file,header);
+    if (file) std::fclose(file);
+    if (!ok)
+    {
+      stats.error = shards[s]+" is not a valid shard";
+      return stats;
+    }
+    parts.push_back(std::make_pair(header,shards[s]));
+  }
+  if (parts.empty())
+  {
+    stats.error = "no shards to merge";
+    return stats;
+  }
+  std::sort(parts.begin(),parts.end(),
+            [](const std::pair<ShardHeader,std::string>& a, const std::pair<ShardHeader,std::string>& b)
+            { return a.first.part < b.first.part; });
+
+  const ShardHeader& head = parts[0].first;
+  for (std::size_t s=0;s<parts.size();s++)
+  {
+    const ShardHeader& h = parts[s].first;
+    if (h.symbol != head.symbol || h.lmax != head.lmax || h.totalFamilies != head.totalFamilies)
+    {
+      stats.error = parts[s].second+" belongs to another table";
+      return stats;
+    }
+    if (h.parts != head.parts)
+    {
+      stats.error = parts[s].second+" belongs to another partition";
+      return stats;
+    }
+    if (h.part != (int32_t)s)
+    {
+      stats.error = (h.part > (int32_t)s ? "missing part before " : "duplicate part in ")+parts[s].second;
+      return stats;
+    }
+    if (h.firstFamily != stats.families)
+    {
+      stats.error = (h.firstFamily > stats.families ? "missing families before " : "overlapping families in ")+parts[s].second;
+      return stats;
+    }
+    stats.families += h.families;
+    stats.values   += h.values;
+  }
+  if ((int32_t)parts.size() != head.parts)
+  {
+    stats.error = "missing parts at the end of the partition";
+    return stats;
+  }
+  if (stats.families != head.totalFamilies)
+  {
+    stats.error = "missing families at the end of the table";
+    return stats;
+  }
+
+  std::vector<double> canonical = canonicalParameters(head.symbol,head.lmax);
+  if (canonical.size() != 5*stats.families)
+  {
+    stats.error = "the shards do not match the canonical families";
+    return stats;
+  }
+
+  ShardHeader header;
+  std::memset(&header,0,sizeof(header));
+  std::memcpy(header.magic,shardMagic,sizeof(shardMagic));
+  header.version       = shardVersion;
+  header.symbol        = head.symbol;
+  header.lmax          = head.lmax;
+  header.part          = 0;
+  header.parts         = 1;
+  header.families      = stats.families;
+  header.totalFamilies = stats.families;
+  header.values        = stats.values;
+
+  FILE* out = std::fopen(output.c_str(),"w+b");
+  if (!out)
+  {
+    stats.error = "cannot open "+output;
+    return stats;
+  }
+
+  // Each shard is copied to its place in the three sections of the file.
+  long parametersAt = sizeof(ShardHeader);
+  long offsetsAt    = parametersAt+5*stats.families*sizeof(double);
+  long valuesAt     = offsetsAt+(stats.families+1)*sizeof(uint64_t);
+  bool ok = std::fwrite(&header,sizeof(header),1,out) == 1;
+  uint64_t base = 0;
+
+  for (std::size_t s=0;s<parts.size() && ok;s++)
+  {
+    TableShard shard;
+    if (!readTableShard(parts[s].second,shard,&stats.error))
+    {
+      std::fclose(out);
+      return stats;
+    }
+
+    std::size_t n = shard.families(), first = shard.firstFamily;
+    if (!std::equal(shard.parameters.begin(),shard.parameters.end(),canonical.begin()+5*first))
+    {
+      std::fclose(out);
+      stats.error = "unexpected family parameters in "+parts[s].second;
+      return stats;
+    }
+
+    for (std::size_t k=0;k<n && verifyStride>0;k++)
+    {
+      if ((first+k) % verifyStride != 0) continue;
+      std::vector<double> ref = recompute(shard.symbol,&shard.parameters[5*k]);
+      std::size_t size = shard.offsets[k+1]-shard.offsets[k];
+      bool same = (ref.size() == size);
+      for (std::size_t i=0;i<size && same;i++)
+        same = std::fabs(ref[i]-shard.values[shard.offsets[k]+i]) <= 1.0e-13;
+      if (!same)
+      {
+        std::fclose(out);
+        stats.error = "family "+std::to_string(first+k)+" differs from its recomputation";
+        return stats;
+      }
+      stats.verified++;
+    }
+
+    std::vector<uint64_t> offsets(n);
+    for (std::size_t k=0;k<n;k++) offsets[k] = base+shard.offsets[k];
+
+    ok = std::fseek(out,parametersAt+5*first*sizeof(double),SEEK_SET) == 0
+      && std::fwrite(shard.parameters.data(),sizeof(double),5*n,out) == 5*n
+      && std::fseek(out,offsetsAt+first*sizeof(uint64_t),SEEK_SET) == 0
+      && std::fwrite(offsets.data(),sizeof(uint64_t),n,out) == n
+      && std::fseek(out,valuesAt+base*sizeof(double),SEEK_SET) == 0
+      && std::fwrite(shard.values.data(),sizeof(double),shard.values.size(),out) == shard.values.size();
+    base += shard.values.size();
+  }
+
+  uint64_t end = base;
+  ok = ok && std::fseek(out,offsetsAt+stats.families*sizeof(uint64_t),SEEK_SET) == 0
+          && std::fwrite(&end,sizeof(end),1,out) == 1;
+
+  // The checksum covers the whole content, which we read back in order.
+  Checksum sum;
+  ok = ok && std::fseek(out,parametersAt,SEEK_SET) == 0;
+  std::vector<uint64_t> buffer(1 << 16);
+  uint64_t words = 5*stats.families+stats.families+1+stats.values;
+  while (ok && words > 0)
+  {
+    std::size_t n = (std::size_t)std::min<uint64_t>(words,buffer.size());
+    ok = std::fread(buffer.data(),sizeof(uint64_t),n,out) == n;
+    sum.update(buffer.data(),n);
+    words -= n;
+  }
+  header.checksum = sum.h;
+  ok = ok && std::fseek(out,0,SEEK_SET) == 0
+          && std::fwrite(&header,sizeof(header),1,out) == 1;
+  ok = (std::fclose(out) == 0) && ok;
+
+  if (!ok)
+  {
+    stats.error = "cannot write "+output;
+    return stats;
+  }
+
+  stats.ok      = true;
+  stats.seconds = std::chrono::duration<double>(Clock::now()-start).count();
+  return stats;
+}
+
+} // namespace WignerSymbols
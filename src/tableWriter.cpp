@@ -0,0 +1,433 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html.              -/
+ ********************************************************/
+
+#include "../include/wignerSymbols/tableWriter.h"
+#include "../include/wignerSymbols/wignerSymbols-cpp.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include <stdint.h>
+#include <unistd.h>
+
+#ifdef WIGNER_SYMBOLS_WITH_ZLIB
+#include <zlib.h>
+#endif
+
+namespace WignerSymbols {
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+const char     fileMagic[8]  = {'W','I','G','N','E','R','3','J'};
+const uint32_t fileVersion   = 1;
+const uint32_t chunkMagic    = 0x4b4e4843; // "CHNK"
+
+struct FileHeader
+{
+  char     magic[8];
+  uint32_t version;
+  int32_t  lmax;
+};
+
+struct ChunkHeader
+{
+  uint32_t magic;
+  uint32_t families;
+  uint64_t firstFamily;
+  int32_t  l2, l3, m2, m3;
+  uint64_t rawBytes;
+  uint64_t storedBytes;
+  uint32_t compressed;
+  uint32_t reserved;
+};
+
+/*! Consecutive families, written as a single unit. */
+struct Chunk
+{
+  unsigned long long  firstFamily;
+  Wigner3jFamilyCursor first;
+  unsigned int        families;
+  std::vector<double> values;
+};
+
+/*! Blocking queue of chunks. Its capacity is never exceeded, since the
+ * chunks come from a fixed pool. */
+class ChunkQueue
+{
+public:
+  void push(Chunk* chunk)
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    chunks.push_back(chunk);
+    ready.notify_one();
+  }
+
+  Chunk* pop()
+  {
+    std::unique_lock<std::mutex> guard(lock);
+    while (chunks.empty()) ready.wait(guard);
+    Chunk* chunk = chunks.front();
+    chunks.pop_front();
+    return chunk;
+  }
+
+private:
+  std::mutex              lock;
+  std::condition_variable ready;
+  std::deque<Chunk*>      chunks;
+};
+
+/*! State saved after each chunk. */
+struct Checkpoint
+{
+  int                  lmax;
+  unsigned long long   families;
+  unsigned long long   chunks;
+  unsigned long long   offset;
+  Wigner3jFamilyCursor cursor;
+  int                  complete;
+};
+
+bool readCheckpoint(const std::string& path, Checkpoint& c)
+{
+  FILE* f = std::fopen(path.c_str(),"r");
+  if (!f) return false;
+  int n = std::fscanf(f,"wigner3j-table %*d lmax %d families %llu chunks %llu offset %llu cursor %d %d %d %d complete %d",
+                      &c.lmax,&c.families,&c.chunks,&c.offset,
+                      &c.cursor.l2,&c.cursor.l3,&c.cursor.m2,&c.cursor.m3,&c.complete);
+  std::fclose(f);
+  return (n == 9);
+}
+
+/*! We write to a temporary file and rename it, so that the checkpoint is
+ * never left half written. */
+bool writeCheckpoint(const std::string& path, const Checkpoint& c)
+{
+  std::string tmp = path+".tmp";
+  FILE* f = std::fopen(tmp.c_str(),"w");
+  if (!f) return false;
+  std::fprintf(f,"wigner3j-table %u\nlmax %d\nfamilies %llu\nchunks %llu\noffset %llu\ncursor %d %d %d %d\ncomplete %d\n",
+               fileVersion,c.lmax,c.families,c.chunks,c.offset,
+               c.cursor.l2,c.cursor.l3,c.cursor.m2,c.cursor.m3,c.complete);
+  bool ok = (std::fclose(f) == 0);
+  return ok && std::rename(tmp.c_str(),path.c_str()) == 0;
+}
+
+/*! Groups the k-th bytes of the n doubles together. The exponents and
+ * leading bytes of the mantissas then form long, repetitive runs, which
+ * zlib compresses better and faster than the interleaved doubles. */
+void shuffle(const unsigned char* in, std::size_t n, unsigned char* out)
+{
+  for (std::size_t i=0;i<n;i++)
+    for (std::size_t k=0;k<sizeof(double);k++)
+      out[k*n+i] = in[i*sizeof(double)+k];
+}
+
+void unshuffle(const unsigned char* in, std::size_t n, unsigned char* out)
+{
+  for (std::size_t i=0;i<n;i++)
+    for (std::size_t k=0;k<sizeof(double);k++)
+      out[i*sizeof(double)+k] = in[k*n+i];
+}
+
+/*! Compresses the chunk into out. Returns the number of bytes to write
+ * and whether they are compressed. */
+std::size_t encode(const Chunk& chunk, int level, std::vector<unsigned char>& shuffled,
+                   std::vector<unsigned char>& out, bool& compressed)
+{
+  const unsigned char* raw = reinterpret_cast<const unsigned char*>(chunk.values.data());
+  std::size_t rawBytes = chunk.values.size()*sizeof(double);
+
+#ifdef WIGNER_SYMBOLS_WITH_ZLIB
+  if (level > 0 && rawBytes > 0)
+  {
+    if (shuffled.size() < rawBytes) shuffled.resize(rawBytes);
+    shuffle(raw,chunk.values.size(),&shuffled[0]);
+
+    uLongf size = compressBound(rawBytes);
+    if (out.size() < size) out.resize(size);
+    if (compress2(&out[0],&size,&shuffled[0],rawBytes,level) == Z_OK && size < rawBytes)
+    {
+      compressed = true;
+      return size;
+    }
+  }
+#else
+  (void)level;
+  (void)shuffled;
+#endif
+
+  compressed = false;
+  if (out.size() < rawBytes) out.resize(rawBytes);
+  if (rawBytes > 0) std::memcpy(&out[0],raw,rawBytes);
+  return rawBytes;
+}
+
+} // anonymous namespace
+
+Wigner3jFamily Wigner3jFamilyCursor::family() const
+{
+  Wigner3jFamily f = {(double)l2, (double)l3, (double)(-m2-m3), (double)m2, (double)m3};
+  return f;
+}
+
+bool Wigner3jFamilyCursor::next(int lmax)
+{
+  // Same order as wigner3jFamilies(): l2, l3, m2 and m3 increase.
+  if (++m3 <= l3) return true;
+  if (++m2 <= l2) { m3 = -l3; return true; }
+  if (++l3 <= l2) { m2 = -l2; m3 = -l3; return true; }
+  if (++l2 <= lmax) { l3 = 0; m2 = -l2; m3 = 0; return true; }
+  return false;
+}
+
+TableWriterOptions::TableWriterOptions()
+  : chunkBytes(4 << 20), bufferedChunks(4), compressionLevel(1), resume(false), maxFamilies(0)
+{}
+
+TableWriterStats writeWigner3jTable(int lmax, const std::string& path, const TableWriterOptions& options)
+{
+  Clock::time_point start = Clock::now();
+
+  TableWriterStats stats;
+  stats.ok = true;
+  stats.complete = false;
+  stats.families = stats.chunks = stats.rawBytes = stats.storedBytes = 0;
+  stats.bufferBytes = 0;
+  stats.seconds = 0.0;
+
+  std::string checkpointPath = path+".checkpoint";
+  Checkpoint checkpoint = {lmax, 0, 0, sizeof(FileHeader), {0,0,0,0}, 0};
+  Wigner3jFamilyCursor cursor = {0,0,0,0};
+
+  // We resume after the last complete chunk, and discard what follows.
+  FILE* file = 0;
+  Checkpoint saved;
+  if (options.resume && readCheckpoint(checkpointPath,saved) && saved.lmax == lmax)
+  {
+    checkpoint = saved;
+    cursor     = saved.cursor;
+    if (truncate(path.c_str(),(off_t)saved.offset) == 0)
+      file = std::fopen(path.c_str(),"r+b");
+    if (file) std::fseek(file,0,SEEK_END);
+  }
+  else
+  {
+    file = std::fopen(path.c_str(),"wb");
+    if (file)
+    {
+      FileHeader header;
+      std::memcpy(header.magic,fileMagic,sizeof(fileMagic));
+      header.version = fileVersion;
+      header.lmax    = lmax;
+      std::fwrite(&header,sizeof(header),1,file);
+    }
+  }
+
+  if (!file)
+  {
+    stats.ok    = false;
+    stats.error = "cannot open "+path;
+    return stats;
+  }
+
+  if (checkpoint.complete)
+  {
+    std::fclose(file);
+    stats.complete = true;
+    return stats;
+  }
+
+  // Fixed pool of chunks, exchanged between the two threads.
+  std::size_t chunkDoubles = std::max<std::size_t>(options.chunkBytes/sizeof(double),1);
+  std::size_t poolSize     = std::max<std::size_t>(options.bufferedChunks,2);
+  std::vector<Chunk> pool(poolSize);
+  ChunkQueue freeChunks, fullChunks;
+  for (std::size_t k=0;k<poolSize;k++)
+  {
+    pool[k].values.reserve(chunkDoubles);
+    freeChunks.push(&pool[k]);
+  }
+
+  // The writer thread compresses and appends the chunks, then records the
+  // checkpoint. An empty chunk ends the stream. After a failure, it only
+  // recycles the chunks, and the calling thread stops computing.
+  std::vector<unsigned char> shuffled, encoded;
+  std::atomic<bool> writeFailed(false);
+  std::thread writer([&]()
+  {
+    bool failed = false;
+    for (;;)
+    {
+      Chunk* chunk = fullChunks.pop();
+      if (chunk->families == 0) { freeChunks.push(chunk); break; }
+
+      if (!failed)
+      {
+        bool compressed;
+        std::size_t size = encode(*chunk,options.compressionLevel,shuffled,encoded,compressed);
+
+        ChunkHeader header;
+        std::memset(&header,0,sizeof(header));
+        header.magic       = chunkMagic;
+        header.families    = chunk->families;
+        header.firstFamily = chunk->firstFamily;
+        header.l2          = chunk->first.l2;
+        header.l3          = chunk->first.l3;
+        header.m2          = chunk->first.m2;
+        header.m3          = chunk->first.m3;
+        header.rawBytes    = chunk->values.size()*sizeof(double);
+        header.storedBytes = size;
+        header.compressed  = compressed;
+
+        failed = (std::fwrite(&header,sizeof(header),1,file) != 1
+               || (size > 0 && std::fwrite(&encoded[0],size,1,file) != 1)
+               || std::fflush(file) != 0);
+
+        if (!failed)
+        {
+          stats.chunks++;
+          stats.families    += chunk->families;
+          stats.rawBytes    += header.rawBytes;
+          stats.storedBytes += sizeof(header)+size;
+
+          checkpoint.families += chunk->families;
+          checkpoint.chunks++;
+          checkpoint.offset   += sizeof(header)+size;
+          checkpoint.cursor    = chunk->first;
+          for (unsigned int k=0;k<chunk->families;k++)
+            if (!checkpoint.cursor.next(lmax)) checkpoint.complete = 1;
+          failed = !writeCheckpoint(checkpointPath,checkpoint);
+        }
+
+        if (failed)
+        {
+          stats.ok    = false;
+          stats.error = "cannot write "+path;
+          writeFailed = true;
+        }
+      }
+      freeChunks.push(chunk);
+    }
+  });
+
+  // We compute the families in canonical order and cut the stream into
+  // chunks at family boundaries.
+  unsigned long long index = checkpoint.families, produced = 0;
+  bool more = true;
+  while (more && !writeFailed)
+  {
+    Chunk* chunk = freeChunks.pop();
+    chunk->firstFamily = index;
+    chunk->first       = cursor;
+    chunk->families    = 0;
+    chunk->values.clear();
+
+    while (more && (chunk->families == 0 || chunk->values.size() < chunkDoubles))
+    {
+      Wigner3jFamily f = cursor.family();
+      if (chunk->families > 0 && chunk->values.size()+familySize(f) > chunkDoubles) break;
+
+      std::vector<double> thrcof = wigner3j(f.l2,f.l3,f.m1,f.m2,f.m3,SchultenGordonScaled);
+      chunk->values.insert(chunk->values.end(),thrcof.begin(),thrcof.begin()+familySize(f));
+      chunk->families++;
+      index++;
+      produced++;
+
+      more = cursor.next(lmax) && (options.maxFamilies == 0 || produced < options.maxFamilies)
+          && !writeFailed;
+    }
+    fullChunks.push(chunk);
+  }
+
+  // End of stream.
+  Chunk* last = freeChunks.pop();
+  last->families = 0;
+  fullChunks.push(last);
+  writer.join();
+  std::fclose(file);
+
+  for (std::size_t k=0;k<poolSize;k++)
+    stats.bufferBytes += pool[k].values.capacity()*sizeof(double);
+  stats.bufferBytes += shuffled.capacity()+encoded.capacity();
+
+  stats.complete = (checkpoint.complete != 0);
+  stats.seconds  = std::chrono::duration<double>(Clock::now()-start).count();
+  return stats;
+}
+
+bool readWigner3jTable(const std::string& path,
+                       const std::function<bool(const Wigner3jFamily&, const double*, std::size_t)>& visit)
+{
+  FILE* file = std::fopen(path.c_str(),"rb");
+  if (!file) return false;
+
+  FileHeader header;
+  bool ok = (std::fread(&header,sizeof(header),1,file) == 1
+          && std::memcmp(header.magic,fileMagic,sizeof(fileMagic)) == 0
+          && header.version == fileVersion);
+
+  std::vector<unsigned char> stored, shuffled;
+  std::vector<double>        values;
+  ChunkHeader chunk;
+  while (ok && std::fread(&chunk,sizeof(chunk),1,file) == 1)
+  {
+    ok = (chunk.magic == chunkMagic && chunk.rawBytes%sizeof(double) == 0);
+    if (!ok) break;
+
+    stored.resize(chunk.storedBytes);
+    values.resize(chunk.rawBytes/sizeof(double));
+    if (chunk.storedBytes > 0 && std::fread(&stored[0],chunk.storedBytes,1,file) != 1) { ok = false; break; }
+
+    if (chunk.compressed)
+    {
+#ifdef WIGNER_SYMBOLS_WITH_ZLIB
+      uLongf size = chunk.rawBytes;
+      shuffled.resize(chunk.rawBytes);
+      ok = (chunk.rawBytes > 0
+         && uncompress(&shuffled[0],&size,&stored[0],chunk.storedBytes) == Z_OK
+         && size == chunk.rawBytes);
+      if (ok) unshuffle(&shuffled[0],values.size(),reinterpret_cast<unsigned char*>(&values[0]));
+#else
+      ok = false;
+#endif
+    }
+    else if (chunk.rawBytes > 0)
+    {
+      ok = (chunk.storedBytes == chunk.rawBytes);
+      if (ok) std::memcpy(&values[0],&stored[0],chunk.rawBytes);
+    }
+    if (!ok) break;
+
+    // We split the chunk into its families.
+    Wigner3jFamilyCursor cursor = {chunk.l2, chunk.l3, chunk.m2, chunk.m3};
+    std::size_t offset = 0;
+    for (uint32_t k=0;k<chunk.families && ok;k++)
+    {
+      Wigner3jFamily f = cursor.family();
+      std::size_t size = familySize(f);
+      ok = (offset+size <= values.size());
+      if (!ok) break;
+      if (!visit(f,&values[offset],size)) { std::fclose(file); return true; }
+      offset += size;
+      cursor.next(header.lmax);
+    }
+  }
+
+  std::fclose(file);
+  return ok;
+}
+
+} // namespace WignerSymbols
@@ -0,0 +1,99 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html.              -/
+ ********************************************************/
+
+#include "../include/wignerSymbols/tensorOperators.h"
+#include "../include/wignerSymbols/wignerSymbols-cpp.h"
+
+namespace WignerSymbols {
+
+namespace {
+
+/*! Whether j', k and j satisfy the triangle relation, with integer sum. */
+bool coupled(double jp, double k, double j)
+{
+  double sum = jp+k+j;
+  return std::floor(sum) == sum && jp >= std::fabs(j-k) && jp <= j+k;
+}
+
+template <typename T>
+std::vector<T> apply(double k, double q, const std::vector<double>& j,
+                     const std::vector<T>& reduced, const std::vector<T>& state,
+                     unsigned int nthreads, SchedulerStats* stats)
+{
+  std::size_t n = j.size();
+  std::vector<std::size_t> offsets = tensorBasisOffsets(j);
+  if (reduced.size() != n*n || state.size() != offsets[n] || std::fabs(q) > k)
+    return std::vector<T>();
+
+  std::vector<T> result(offsets[n],T(0.0));
+
+  // The cost of an output block is the length of the families it needs.
+  std::vector<double> cost(n,0.0);
+  for (std::size_t r=0;r<n;r++)
+    for (std::size_t c=0;c<n;c++)
+      if (reduced[r*n+c] != T(0.0) && coupled(j[r],k,j[c]))
+        cost[r] += 2.0*std::min(j[r],j[c])+1.0;
+
+  parallelFor(n, cost, nthreads, [&](std::size_t r)
+  {
+    double jp = j[r];
+    T* out = &result[offsets[r]];
+
+    for (std::size_t c=0;c<n;c++)
+    {
+      T red = reduced[r*n+c];
+      if (red == T(0.0) || !coupled(jp,k,j[c])) continue;
+
+      // (j' k j; -m' q m) for m from mmin, with m' = m+q.
+      double jc   = j[c];
+      double mmin = std::max(-jc,-jp-q);
+      std::vector<double> thrcof = wigner3j_m(k,jc,jp,q);
+      const T* in = &state[offsets[c]];
+
+      // The phase (-1)^(j'-m') alternates with m.
+      std::size_t first = (std::size_t)(mmin+jc+0.5), shift = (std::size_t)(mmin+q+jp+0.5);
+      double phase = (((long)(jp-(mmin+q)+0.5))%2 ? -1.0 : 1.0);
+      for (std::size_t i=0;i<thrcof.size();i++)
+      {
+        out[shift+i] += (phase*thrcof[i])*red*in[first+i];
+        phase = -phase;
+      }
+    }
+  }, stats);
+
+  return result;
+}
+
+} // anonymous namespace
+
+std::vector<std::size_t> tensorBasisOffsets(const std::vector<double>& j)
+{
+  std::vector<std::size_t> offsets(j.size()+1,0);
+  for (std::size_t b=0;b<j.size();b++)
+    offsets[b+1] = offsets[b]+(std::size_t)(2.0*j[b]+1.5);
+  return offsets;
+}
+
+std::vector<double> applyTensorOperator(double k, double q,
+                                        const std::vector<double>& j,
+                                        const std::vector<double>& reduced,
+                                        const std::vector<double>& state,
+                                        unsigned int nthreads, SchedulerStats* stats)
+{
+  return apply(k,q,j,reduced,state,nthreads,stats);
+}
+
+std::vector<std::complex<double> > applyTensorOperator(double k, double q,
+                                                       const std::vector<double>& j,
+                                                       const std::vector<std::complex<double> >& reduced,
+                                                       const std::vector<std::complex<double> >& state,
+                                                       unsigned int nthreads, SchedulerStats* stats)
+{
+  return apply(k,q,j,reduced,state,nthreads,stats);
+}
+
+} // namespace WignerSymbols
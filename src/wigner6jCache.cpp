@@ -0,0 +1,79 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html.              -/
+ ********************************************************/
+
+#include "../include/wignerSymbols/wigner6jCache.h"
+#include "../include/wignerSymbols/familyCache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace WignerSymbols {
+
+struct Wigner6jCache::State
+{
+  // The families are bounded by their memory, not by their number.
+  explicit State(std::size_t byteBudget)
+    : byteBudget(byteBudget), cache(byteBudget,(std::size_t)-1) {}
+
+  std::size_t byteBudget;
+  FamilyCache cache;
+};
+
+Wigner6jCache::Wigner6jCache(std::size_t byteBudget)
+  : state(new State(byteBudget))
+{}
+
+Wigner6jCache::~Wigner6jCache() {}
+
+double Wigner6jCache::operator()(double l1, double l2, double l3,
+                                 double l4, double l5, double l6)
+{
+  double l[6] = {l1,l2,l3,l4,l5,l6};
+  int32_t j[6];
+  for (int k=0;k<6;k++)
+  {
+    // Beyond the limit, the doubled arguments would overflow the key.
+    if (!(l[k] >= 0.0 && l[k] <= familyLmaxLimit) || std::floor(2.0*l[k]) != 2.0*l[k]) return 0.0;
+    j[k] = (int32_t)(2.0*l[k]);
+  }
+  if (!(doubledTriad(j[0],j[1],j[2]) && doubledTriad(j[0],j[4],j[5])
+        && doubledTriad(j[3],j[1],j[5]) && doubledTriad(j[3],j[4],j[2]))) return 0.0;
+
+  int32_t first;
+  FamilyKey key;
+  canonicalWigner6j(j,first,key);
+  const int32_t* p = key.p;
+  std::size_t index = (std::size_t)((first - std::max(std::abs(p[0]-p[1]),std::abs(p[3]-p[4])))/2);
+  return state->cache.value(key,index);
+}
+
+Wigner6jCacheStats Wigner6jCache::stats() const
+{
+  FamilyCacheStats c = state->cache.stats();
+  Wigner6jCacheStats s = {c.hits,c.misses,c.evictions,c.contended,c.families,c.bytes,state->byteBudget};
+  return s;
+}
+
+void Wigner6jCache::clear()
+{
+  state->cache.clear();
+}
+
+Wigner6jCache& sharedWigner6jCache()
+{
+  static Wigner6jCache cache;
+  return cache;
+}
+
+double wigner6j_cached(double l1, double l2, double l3,
+                       double l4, double l5, double l6)
+{
+  return sharedWigner6jCache()(l1,l2,l3,l4,l5,l6);
+}
+
+} // namespace WignerSymbols
@@ -7,8 +7,524 @@
 
 #include "../include/wignerSymbols/commonFunctions.h"
 #include "../include/wignerSymbols/wignerSymbols-cpp.h"
+#include "../include/wignerSymbols/kernels.h"
+#include "../include/wignerSymbols/closedForms.h"
+#include "../include/wignerSymbols/scratchArena.h"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
 
 namespace WignerSymbols {
+
+namespace {
+
+/*! Coefficients of the three-term recursion of the 3j symbols. The forward
+ * recursion computes f(l1+1) = alphaForward*f(l1)+betaForward*f(l1-1), the
+ * backward one f(l1-1) = alphaBackward*f(l1)+betaBackward*f(l1+1). */
+struct Wigner3jRecursion
+{
+	double l2, l3, m1, m2, m3;
+
+	double alphaFirst(double l1min) const
+	{
+		if (l1min==0.0)
+			return -(m3-m2+2.0*wigner3j_auxB(l1min,l2,l3,m1,m2,m3))/wigner3j_auxA(1.0,l2,l3,m1,m2,m3);
+		return -wigner3j_auxB(l1min,l2,l3,m1,m2,m3)/(l1min*wigner3j_auxA(l1min+1.0,l2,l3,m1,m2,m3));
+	}
+	double alphaForward(double l1) const
+	{
+		return -wigner3j_auxB(l1,l2,l3,m1,m2,m3)/(l1*wigner3j_auxA(l1+1.0,l2,l3,m1,m2,m3));
+	}
+	double betaForward(double l1) const
+	{
+		return -(l1+1.0)*wigner3j_auxA(l1,l2,l3,m1,m2,m3)/(l1*wigner3j_auxA(l1+1.0,l2,l3,m1,m2,m3));
+	}
+	double alphaBackward(double l1) const
+	{
+		return -wigner3j_auxB(l1,l2,l3,m1,m2,m3)/((l1+1.0)*wigner3j_auxA(l1,l2,l3,m1,m2,m3));
+	}
+	double betaBackward(double l1) const
+	{
+		return -l1*wigner3j_auxA(l1+1.0,l2,l3,m1,m2,m3)/((l1+1.0)*wigner3j_auxA(l1,l2,l3,m1,m2,m3));
+	}
+};
+
+/*! Coefficients of the three-term recursion of the 6j symbols. */
+struct Wigner6jRecursion
+{
+	double l2, l3, l4, l5, l6;
+
+	double alphaFirst(double l1min) const
+	{
+		if (l1min==0.0)
+			return -(l2*(l2+1.0)+l3*(l3+1.0)+l5*(l5+1.0)+l6*(l6+1.0)-2.0*l4*(l4+1.0))/wigner6j_auxA(1.0,l2,l3,l4,l5,l6);
+		return -wigner6j_auxB(l1min,l2,l3,l4,l5,l6)/(l1min*wigner6j_auxA(l1min+1.0,l2,l3,l4,l5,l6));
+	}
+	double alphaForward(double l1) const
+	{
+		return -wigner6j_auxB(l1,l2,l3,l4,l5,l6)/(l1*wigner6j_auxA(l1+1.0,l2,l3,l4,l5,l6));
+	}
+	double betaForward(double l1) const
+	{
+		return -(l1+1.0)*wigner6j_auxA(l1,l2,l3,l4,l5,l6)/(l1*wigner6j_auxA(l1+1.0,l2,l3,l4,l5,l6));
+	}
+	double alphaBackward(double l1) const
+	{
+		return -wigner6j_auxB(l1,l2,l3,l4,l5,l6)/((l1+1.0)*wigner6j_auxA(l1,l2,l3,l4,l5,l6));
+	}
+	double betaBackward(double l1) const
+	{
+		return -l1*wigner6j_auxA(l1+1.0,l2,l3,l4,l5,l6)/((l1+1.0)*wigner6j_auxA(l1,l2,l3,l4,l5,l6));
+	}
+};
+
+/*! Recursion coefficients read from the tables A and B of the auxiliary
+ * functions at l1 = l1min+k, filled by the vectorized kernels. The first
+ * step is delegated to the direct recursion, which handles l1min = 0. */
+template <class Recursion>
+struct TabulatedRecursion
+{
+	const Recursion& r;
+	double           l1min;
+	const double*    A;
+	const double*    B;
+
+	int index(double l1) const { return (int)(l1-l1min+0.5); }
+
+	double alphaFirst(double l1) const
+	{
+		return r.alphaFirst(l1);
+	}
+	double alphaForward(double l1) const
+	{
+		int k = index(l1);
+		return -B[k]/(l1*A[k+1]);
+	}
+	double betaForward(double l1) const
+	{
+		int k = index(l1);
+		return -(l1+1.0)*A[k]/(l1*A[k+1]);
+	}
+	double alphaBackward(double l1) const
+	{
+		int k = index(l1);
+		return -B[k]/((l1+1.0)*A[k]);
+	}
+	double betaBackward(double l1) const
+	{
+		int k = index(l1);
+		return -l1*A[k+1]/((l1+1.0)*A[k]);
+	}
+};
+
+/*! Brings the segments [start[s],start[s+1]) of cof, whose binary exponents
+ * are expo[s], to the exponent of the last segment. start holds one more
+ * element than expo: the end of the last segment. */
+void applySegmentExponents(std::vector<double>& cof, const std::vector<int>& start,
+				const std::vector<int>& expo)
+{
+	for (size_t s=0;s+1<expo.size();s++)
+	{
+		double scale = std::ldexp(1.0,expo[s]-expo.back());
+		for (int k=start[s];k<start[s+1];k++)
+			cof[k] *= scale;
+	}
+}
+
+/*! Computes the unnormalized family with the Schulten-Gordon recursion,
+ * where the overflow is handled by tracking a binary exponent per segment
+ * of the forward and backward sweeps instead of rescaling the previous
+ * coefficients. size must be at least 2. */
+template <class Recursion>
+void scaledExponentRecursion(const Recursion& r, double l1min, double l1max,
+				int size, double srhuge, std::vector<double>& cof)
+{
+	// We start with an arbitrary value and the two-term recursion.
+	double alphaNew = r.alphaFirst(l1min), alphaOld, beta, l1(l1min);
+	cof[0] = 1.0;
+	cof[1] = alphaNew*cof[0];
+
+	if (size==2) return;
+
+	// Forward recursion. A new segment starts at i-1 every time we
+	// bring the last two coefficients back to unit magnitude.
+	std::vector<int> start(1,0), expo(1,0);
+	int i = 1;
+	bool alphaVar = false;
+	do
+	{
+		i++;
+		alphaOld = alphaNew;
+		l1 += 1.0;
+
+		alphaNew = r.alphaForward(l1);
+		beta     = r.betaForward(l1);
+		cof[i]   = alphaNew*cof[i-1]+beta*cof[i-2];
+
+		if (std::fabs(cof[i])>srhuge)
+		{
+			int p;
+			std::frexp(cof[i],&p);
+			cof[i]   = std::ldexp(cof[i],-p);
+			cof[i-1] = std::ldexp(cof[i-1],-p);
+			start.push_back(i-1);
+			expo.push_back(expo.back()+p);
+		}
+
+		// Same stopping criterion as the Rescale mode.
+		if (alphaVar) break;
+
+		if (std::fabs(alphaNew)-std::fabs(alphaOld)>0.0)
+			alphaVar=true;
+
+	}	while (i<(size-1));
+
+	// We apply the exponents of the forward sweep in a single pass.
+	start.push_back(i+1);
+	applySegmentExponents(cof,start,expo);
+
+	if (i==size-1) return;
+
+	// Backward recursion from l1max down to l1mid-1.
+	double l1midm1(cof[i-2]),l1mid(cof[i-1]),l1midp1(cof[i]);
+
+	cof[size-1] = 1.0;
+	l1 = l1max;
+	cof[size-2] = r.alphaBackward(l1)*cof[size-1];
+
+	// Segments are recorded by decreasing index. A new one starts at j+1.
+	std::vector<int> startB(1,size-1), expoB(1,0);
+	int j = size-2;
+	do
+	{
+		j--;
+		l1 -= 1.0;
+
+		alphaNew = r.alphaBackward(l1);
+		beta     = r.betaBackward(l1);
+		cof[j]   = alphaNew*cof[j+1]+beta*cof[j+2];
+
+		if (std::fabs(cof[j])>srhuge)
+		{
+			int p;
+			std::frexp(cof[j],&p);
+			cof[j]   = std::ldexp(cof[j],-p);
+			cof[j+1] = std::ldexp(cof[j+1],-p);
+			startB.push_back(j+1);
+			expoB.push_back(expoB.back()+p);
+		}
+
+	} while (j>(i-2));
+
+	// Segment s of the backward sweep covers ]startB[s+1],startB[s]].
+	for (size_t s=0;s+1<expoB.size();s++)
+	{
+		double scale = std::ldexp(1.0,expoB[s]-expoB.back());
+		for (int k=startB[s];k>startB[s+1];k--)
+			cof[k] *= scale;
+	}
+
+	// We match the two sweeps around l1mid.
+	double lambda = (l1midp1*cof[j+2]+l1mid*cof[j+1]+l1midm1*cof[j])
+				/(l1midp1*l1midp1+l1mid*l1mid+l1midm1*l1midm1);
+
+	for (int k=0;k<j;k++)
+		cof[k] *= lambda;
+}
+
+
+/*! Computes the unnormalized family with the algorithm of Luscombe and
+ * Luban. The ratios s(k) = f(k)/f(k+1) are computed from l1min as long as
+ * |s| < 1, i.e. through the classically forbidden region where the
+ * coefficients grow, and the ratios r(k) = f(k)/f(k-1) likewise from
+ * l1max. In between, the three-term recursion runs through the allowed
+ * region. The coefficients are at most of order one, so that no rescaling
+ * is needed, but the tail of a deep forbidden region can underflow to zero.
+ * We thus return the sign of f(l1max), taken from the product of the
+ * signs of the ratios. size must be at least 2. */
+template <class Recursion>
+double ratioRecursion(const Recursion& r, double l1min, double l1max,
+				int size, std::vector<double>& cof)
+{
+	// Forward ratios, stored in place.
+	int a = 0;
+	cof[0] = 1.0/r.alphaFirst(l1min);
+	while (std::fabs(cof[a])<1.0 && a<size-2)
+	{
+		a++;
+		double l1 = l1min+a;
+		cof[a] = 1.0/(r.alphaForward(l1)+r.betaForward(l1)*cof[a-1]);
+	}
+
+	// The forbidden region spans the whole family.
+	int top = (std::fabs(cof[a])<1.0 ? size-1 : a);
+	double ratio = cof[top];
+
+	// Backward ratios, stored in place, down to the allowed region.
+	int b = size-1;
+	if (top<size-1)
+	{
+		cof[b] = 1.0/r.alphaBackward(l1max);
+		while (std::fabs(cof[b])<1.0 && b>top+1)
+		{
+			b--;
+			double l1 = l1min+b;
+			cof[b] = 1.0/(r.alphaBackward(l1)+r.betaBackward(l1)*cof[b+1]);
+		}
+	}
+
+	// We unfold the forward ratios from f(top) = 1.
+	cof[top] = 1.0;
+	for (int k=top-1;k>=0;k--)
+		cof[k] *= cof[k+1];
+
+	if (top==size-1) return 1.0;
+
+	// Three-term recursion across the allowed region.
+	cof[top+1] = 1.0/ratio;
+	for (int k=top+1;k<b;k++)
+	{
+		double l1 = l1min+k;
+		cof[k+1] = r.alphaForward(l1)*cof[k]+r.betaForward(l1)*cof[k-1];
+	}
+
+	// We unfold the backward ratios.
+	double last = sgn(cof[b]);
+	for (int k=b+1;k<size;k++)
+	{
+		last *= sgn(cof[k]);
+		cof[k] *= cof[k-1];
+	}
+	return last;
+}
+
+
+/*! Length of the families from which the Scaled mode splits the sweeps
+ * between two threads. A second thread can only slow down a single core,
+ * so that the split is disabled by default there. */
+int defaultSplitThreshold()
+{
+	return (std::thread::hardware_concurrency() > 1 ? 8192 : std::numeric_limits<int>::max());
+}
+
+std::atomic<int> splitThreshold(defaultSplitThreshold());
+
+/*! State of one of the sweeps of splitRecursion(), shared with the other
+ * sweep under the lock of their Meeting. */
+struct SweepState
+{
+	int  claim;	// The sweep may write up to this index.
+	int  position;	// Last index written, as of the end of the last block.
+	bool turned;	// The sweep has reached the allowed region.
+	bool stopped;	// The sweep has met the other one.
+};
+
+struct Meeting
+{
+	std::mutex lock;
+	SweepState sweep[2];
+};
+
+/*! Computes and normalizes the family with the Schulten-Gordon recursion,
+ * the forward sweep running on the calling thread and the backward one on
+ * a second thread. Each sweep claims blocks of indices toward the other
+ * one, so that they write to disjoint parts of cof and only synchronize
+ * once per block. Past its turning point, a sweep only proceeds once the
+ * other one has reached the allowed region too, so that both stay where
+ * they are stable; the allowed region is thus split between them. Both
+ * halves of the normalization sum and of the final scaling are also
+ * computed in parallel. The family is normalized so that the sum of
+ * weight*(2l1+1)*cof^2 is one, and the sign of its last entry is that of
+ * phase. */
+template <class Recursion>
+void splitRecursion(const Recursion& r, double l1min, double l1max, int size,
+				double srhuge, double phase, double weight, std::vector<double>& cof)
+{
+	const Kernels& kernel = kernels();
+	const int block = 256;
+
+	// Both sweeps start with the two-term recursion.
+	cof[0] = 1.0;
+	cof[1] = r.alphaFirst(l1min)*cof[0];
+	cof[size-1] = 1.0;
+	cof[size-2] = r.alphaBackward(l1max)*cof[size-1];
+
+	Meeting meeting;
+	SweepState first = {1, 1, false, false}, last = {size-2, size-2, false, false};
+	meeting.sweep[0] = first;
+	meeting.sweep[1] = last;
+
+	// Sweep d (0: forward, 1: backward). Returns the last index written.
+	// The segments of the binary exponents are recorded as in the serial
+	// recursion.
+	auto sweep = [&](int d, std::vector<int>& start, std::vector<int>& expo) -> int
+	{
+		SweepState& self  = meeting.sweep[d];
+		SweepState& other = meeting.sweep[1-d];
+		int step  = (d==0 ? 1 : -1);
+		int k     = self.position;
+		int limit = k;
+		double alphaNew = (d==0 ? r.alphaFirst(l1min) : r.alphaBackward(l1max)), alphaOld, beta;
+		bool alphaVar = false, turned = false;
+
+		for (;;)
+		{
+			if (k==limit)
+			{
+				std::unique_lock<std::mutex> guard(meeting.lock);
+				self.position = k;
+
+				int room = other.claim-2*step;
+				bool wait = (turned && !other.turned && !other.stopped);
+				if (!wait && (room-k)*step > 0)
+				{
+					limit = (d==0 ? std::min(k+block,room) : std::max(k-block,room));
+					self.claim = limit;
+				}
+				else if (!wait && (other.stopped || other.position==other.claim))
+				{
+					self.stopped = true;
+					return k;
+				}
+				else
+				{
+					guard.unlock();
+					std::this_thread::yield();
+					continue;
+				}
+			}
+
+			k += step;
+			double l1 = l1min+k-step;
+			alphaOld = alphaNew;
+			alphaNew = (d==0 ? r.alphaForward(l1) : r.alphaBackward(l1));
+			beta     = (d==0 ? r.betaForward(l1)  : r.betaBackward(l1));
+			cof[k]   = alphaNew*cof[k-step]+beta*cof[k-2*step];
+
+			if (std::fabs(cof[k])>srhuge)
+			{
+				int p;
+				std::frexp(cof[k],&p);
+				cof[k]      = std::ldexp(cof[k],-p);
+				cof[k-step] = std::ldexp(cof[k-step],-p);
+				start.push_back(k-step);
+				expo.push_back(expo.back()+p);
+			}
+
+			// Same stopping criterion as the serial recursion. We give up
+			// the rest of the block, which the other sweep may need.
+			if (!turned)
+			{
+				if (alphaVar)
+				{
+					std::lock_guard<std::mutex> guard(meeting.lock);
+					turned = self.turned = true;
+					limit = self.claim = self.position = k;
+				}
+				else if (std::fabs(alphaNew)-std::fabs(alphaOld)>0.0)
+					alphaVar = true;
+			}
+		}
+	};
+
+	std::atomic<bool> backwardSummed(false), scaleReady(false);
+	double backwardSum = 0.0, backwardScale = 1.0;
+
+	std::thread worker([&]()
+	{
+		std::vector<int> start(1,size-1), expo(1,0);
+		int j = sweep(1,start,expo);
+
+		// Segment s covers ]start[s+1],start[s]].
+		for (size_t s=0;s+1<expo.size();s++)
+		{
+			double scale = std::ldexp(1.0,expo[s]-expo.back());
+			for (int k=start[s];k>start[s+1];k--)
+				cof[k] *= scale;
+		}
+		backwardSum = kernel.normalizationSum(&cof[j],size-j,l1min+j);
+		backwardSummed = true;
+
+		while (!scaleReady) std::this_thread::yield();
+		kernel.scale(&cof[j],size-j,backwardScale);
+	});
+
+	std::vector<int> start(1,0), expo(1,0);
+	int i = sweep(0,start,expo);
+
+	int j;
+	for (;;)
+	{
+		std::lock_guard<std::mutex> guard(meeting.lock);
+		if (meeting.sweep[1].stopped) { j = meeting.sweep[1].position; break; }
+	}
+
+	// We extend the forward sweep over the gap and three entries of the
+	// backward one, which we match.
+	int end = std::min(j+2,size-1);
+	double overlap[3] = {0.0, 0.0, 0.0};
+	for (int k=i+1;k<=end;k++)
+	{
+		double l1    = l1min+k-1;
+		double left2 = (k-2 >= j ? overlap[k-2-j] : cof[k-2]);
+		double left1 = (k-1 >= j ? overlap[k-1-j] : cof[k-1]);
+		double value = r.alphaForward(l1)*left1+r.betaForward(l1)*left2;
+		if (k < j) cof[k] = value;
+		else overlap[k-j] = value;
+	}
+
+	start.push_back(j);
+	applySegmentExponents(cof,start,expo);
+	double sum = kernel.normalizationSum(&cof[0],j,l1min);
+
+	while (!backwardSummed) std::this_thread::yield();
+	double fg = 0.0, ff = 0.0;
+	for (int k=j;k<=end;k++)
+	{
+		fg += overlap[k-j]*cof[k];
+		ff += overlap[k-j]*overlap[k-j];
+	}
+	double lambda = fg/ff;
+
+	double c1 = phase*sgn(cof[size-1])/sqrt(weight*(lambda*lambda*sum+backwardSum));
+	backwardScale = c1;
+	scaleReady = true;
+	kernel.scale(&cof[0],j,lambda*c1);
+	worker.join();
+}
+
+/*! Runs the recursion of the given mode on the tabulated coefficients, then
+ * normalizes the family: the sum of (2l1+1)f(l1)^2, times weight, is 1 and
+ * the sign of the last coefficient is phase. */
+template <class Recursion>
+void tabulatedFamily(const TabulatedRecursion<Recursion>& t, double l1max, int size,
+				double srhuge, double phase, double weight, RecursionMode mode,
+				std::vector<double>& cof)
+{
+	double last;
+	if (mode==LuscombeLuban)
+		last = ratioRecursion(t,t.l1min,l1max,size,cof);
+	else if (size>=splitThreshold)
+	{
+		splitRecursion(t,t.l1min,l1max,size,srhuge,phase,weight,cof);
+		return;
+	}
+	else
+	{
+		scaledExponentRecursion(t,t.l1min,l1max,size,srhuge,cof);
+		last = sgn(cof[size-1]);
+	}
+
+	// We compute the overall factor.
+	const Kernels& kernel = kernels();
+	double sum = weight*kernel.normalizationSum(&cof[0],size,t.l1min);
+	double c1 = phase*last/sqrt(sum);
+	kernel.scale(&cof[0],size,c1);
+}
+
+}
+
 std::vector<double> wigner3j(double l2, double l3,
 			     double m1, double m2, double m3)
 {
@@ -33,10 +549,22 @@ std::vector<double> wigner3j(double l2, double l3,
 	double l1min = std::max(std::fabs(l2-l3),std::fabs(m1));
 	double l1max = l2+l3;
 
+	// Dipole and quadrupole couplings have closed forms.
+	if (l2 <= closedFormMaxL2) return wigner3j_closedForm(l2,l3,m1,m2,m3);
+
 	// We compute the size of the resulting array.
 	int size = (int)std::floor(l1max-l1min+1.0+eps);
 	std::vector<double> thrcof(size,0.0);
 
+	// With all projections zero, we only compute the even-parity entries.
+	if (m1==0.0 && m2==0.0 && m3==0.0 && std::floor(l2)==l2 && std::floor(l3)==l3)
+	{
+		std::vector<double> even = wigner3j_m0(l2,l3);
+		for (size_t k=0;k<even.size();k++)
+			thrcof[2*k] = even[k];
+		return thrcof;
+	}
+
 	// If l1min=l1max, we have an analytical formula.
 	if (size==1)
 	{
@@ -183,22 +711,55 @@ std::vector<double> wigner3j(double l2, double l3,
 	}
 
 	// We compute the overall factor.
-	double sum = 0.0;
-	for (int k=0;k<size;k++)
-	{
-		sum += (2.0*(l1min+k)+1.0)*thrcof[k]*thrcof[k];
-	}
-	//std::cout << sum << std::endl;
+	const Kernels& kernel = kernels();
+	double sum = kernel.normalizationSum(&thrcof[0],size,l1min);
 
-	//std::cout << "(-1)^(l2-l3-m1): " << pow(-1.0,l2-l3-m1) << " sgn:" << sgn(thrcof[size-1]) << std::endl;
 	double c1 = pow(-1.0,l2-l3-m1)*sgn(thrcof[size-1]);
-	//std::cout << "c1: " << c1 << std::endl;
-	for (std::vector<double>::iterator it = thrcof.begin(); it != thrcof.end(); ++it)
+	kernel.scale(&thrcof[0],size,c1/sqrt(sum));
+	return thrcof;
+}
+
+std::vector<double> wigner3j(double l2, double l3,
+			     double m1, double m2, double m3,
+			     RecursionMode mode)
+{
+	if (mode==SchultenGordonRescale) return wigner3j(l2,l3,m1,m2,m3);
+
+	// We compute the numeric limits of double precision.
+	double huge = sqrt(std::numeric_limits<double>::max()/20.0);
+	double srhuge = sqrt(huge);
+	double eps = std::numeric_limits<double>::epsilon();
+
+	// We enforce the selection rules.
+	bool select = (
+		   std::fabs(m1+m2+m3)<eps
+		&& std::fabs(m2) <= l2+eps
+		&& std::fabs(m3) <= l3+eps
+		);
+
+	if (!select) return std::vector<double>(1,0.0);
+
+	// We compute the limits of l1 and the size of the resulting array.
+	double l1min = std::max(std::fabs(l2-l3),std::fabs(m1));
+	double l1max = l2+l3;
+	int size = (int)std::floor(l1max-l1min+1.0+eps);
+	std::vector<double> thrcof(size,0.0);
+
+	if (size==1)
 	{
-		//std::cout << *it << ", " << c1 << ", ";
-		*it *= c1/sqrt(sum);
-		//std::cout << *it << std::endl;
+		thrcof[0] = pow(-1.0,std::floor(std::fabs(l2+m2-l3+m3)))/sqrt(l1min+l2+l3+1.0);
+		return thrcof;
 	}
+
+	// We tabulate the auxiliary functions with the vectorized kernels.
+	const Kernels& kernel = kernels();
+	double* A = ScratchArena::local().reserve(2*size);
+	double* B = A+size;
+	kernel.wigner3jCoefficients(l1min,size,l2,l3,m1,m2,m3,A,B);
+
+	Wigner3jRecursion r = {l2,l3,m1,m2,m3};
+	TabulatedRecursion<Wigner3jRecursion> t = {r,l1min,A,B};
+	tabulatedFamily(t,l1max,size,srhuge,pow(-1.0,l2-l3-m1),1.0,mode,thrcof);
 	return thrcof;
 }
 
@@ -219,15 +780,139 @@ double wigner3j(double l1, double l2, double l3,
 
 	if (!select) return 0.0;
 
+	// Dipole and quadrupole couplings have closed forms.
+	if (l2 <= closedFormMaxL2) return wigner3j_closedForm(l1,l2,l3,m1,m2,m3);
+
 	// We compute l1min and the position of the array we will want.
 	double l1min = std::max(std::fabs(l2-l3),std::fabs(m1));
 
+	// With all projections zero, the symbol vanishes unless l1+l2+l3 is even.
+	if (m1==0.0 && m2==0.0 && m3==0.0 && std::floor(l2)==l2 && std::floor(l3)==l3)
+	{
+		if ((int)(l1+l2+l3)%2) return 0.0;
+		return wigner3j_m0(l2,l3)[(int)(l1-l1min)/2];
+	}
+
 	// We fetch the proper value in the array.
 	int index = (int)(l1-l1min);
 
 	return wigner3j(l2,l3,m1,m2,m3)[index];
 }
 
+std::vector<double> wigner3j_m0(double l2, double l3)
+{
+	if (l2<0.0 || l3<0.0 || std::floor(l2)!=l2 || std::floor(l3)!=l3)
+		return std::vector<double>();
+
+	double l1min = std::fabs(l2-l3);
+	int size = (int)std::min(l2,l3)+1;
+	std::vector<double> thrcof(size);
+
+	// We use the ratio of consecutive even-parity entries, which follows
+	// from the closed form (-1)^g sqrt[(2g-2l1)!(2g-2l2)!(2g-2l3)!/(2g+1)!]
+	// g!/[(g-l1)!(g-l2)!(g-l3)!] with 2g = l1+l2+l3. The symbols vary
+	// slowly across the family, so that the recursion cannot overflow.
+	thrcof[0] = 1.0;
+	for (int k=1;k<size;k++)
+	{
+		double l1 = l1min+2.0*(k-1);
+		double g  = 0.5*(l1+l2+l3);
+		double a  = g-l1, b = g-l2, c = g-l3;
+		thrcof[k] = -thrcof[k-1]*sqrt((2.0*b+1.0)*(2.0*c+1.0)*(g+1.0)*a
+								/((2.0*a-1.0)*(2.0*g+3.0)*(b+1.0)*(c+1.0)));
+	}
+
+	// We normalize the family. The sign of the last entry is (-1)^(l2+l3).
+	double sum = 0.0;
+	for (int k=0;k<size;k++)
+		sum += (2.0*(l1min+2.0*k)+1.0)*thrcof[k]*thrcof[k];
+
+	double c1 = ((int)(l2+l3)%2 ? -1.0 : 1.0)*sgn(thrcof[size-1])/sqrt(sum);
+	for (int k=0;k<size;k++)
+		thrcof[k] *= c1;
+	return thrcof;
+}
+
+std::vector<double> wigner3j_m(double l1, double l2, double l3, double m1)
+{
+	// We enforce the selection rules.
+	double eps = std::numeric_limits<double>::epsilon();
+	bool select = (
+		   std::floor(l1+l2+l3)==(l1+l2+l3)
+		&& std::floor(l1+m1)==(l1+m1)
+		&& l3 >= std::fabs(l1-l2)
+		&& l3 <= l1+l2
+		&& std::fabs(m1) <= l1
+		);
+
+	double m2min = std::max(-l2,-l3-m1);
+	double m2max = std::min(l2,l3-m1);
+	int size = (int)std::floor(m2max-m2min+1.0+eps);
+	if (!select || size <= 0) return std::vector<double>();
+
+	// Coefficients of the recursion C(m2)f(m2-1)+D(m2)f(m2)+C(m2+1)f(m2+1) = 0,
+	// with m3 = -m1-m2. C vanishes at m2min and m2max+1.
+	double c0 = l2*(l2+1.0)+l3*(l3+1.0)-l1*(l1+1.0);
+	auto C = [&](double m2) { double m3 = -m1-m2; return std::sqrt((l2-m2+1.0)*(l2+m2)*(l3+m3+1.0)*(l3-m3)); };
+	auto D = [&](double m2) { return c0-2.0*m2*(m1+m2); };
+
+	const double huge = 1.0e150, tiny = 1.0e-150;
+	std::vector<double> thrcof(size);
+
+	// We recurse forward from m2min as long as the symbols grow, i.e. through
+	// the classically forbidden region and into the allowed one.
+	thrcof[0] = 1.0;
+	int last = 0;
+	if (size > 1)
+	{
+		thrcof[1] = -D(m2min)/C(m2min+1.0);
+		last = 1;
+		while (last < size-1)
+		{
+			double m2 = m2min+last;
+			thrcof[last+1] = -(D(m2)*thrcof[last]+C(m2)*thrcof[last-1])/C(m2+1.0);
+			last++;
+
+			if (std::fabs(thrcof[last]) > huge)
+				for (int k=0;k<=last;k++) thrcof[k] *= tiny;
+			if (std::fabs(thrcof[last]) < std::fabs(thrcof[last-1])) break;
+		}
+	}
+
+	// We recurse backward from m2max down to the last two forward values and
+	// match both sweeps there.
+	if (last < size-1)
+	{
+		double* backward = ScratchArena::local().reserve(size);
+		backward[size-1] = 1.0;
+		backward[size-2] = -D(m2max)/C(m2max);
+		for (int k=size-2;k>=last;k--)
+		{
+			double m2 = m2min+k;
+			backward[k-1] = -(D(m2)*backward[k]+C(m2+1.0)*backward[k+1])/C(m2);
+
+			if (std::fabs(backward[k-1]) > huge)
+				for (int i=k-1;i<size;i++) backward[i] *= tiny;
+		}
+
+		double fg = thrcof[last-1]*backward[last-1]+thrcof[last]*backward[last];
+		double gg = backward[last-1]*backward[last-1]+backward[last]*backward[last];
+		double ratio = fg/gg;
+		for (int k=last+1;k<size;k++)
+			thrcof[k] = ratio*backward[k];
+	}
+
+	// We normalize the family. The sign of the last entry is (-1)^(l2-l3-m1).
+	double sum = 0.0;
+	for (int k=0;k<size;k++)
+		sum += thrcof[k]*thrcof[k];
+
+	double c1 = pow(-1.0,l2-l3-m1)*sgn(thrcof[size-1])/sqrt((2.0*l1+1.0)*sum);
+	for (int k=0;k<size;k++)
+		thrcof[k] *= c1;
+	return thrcof;
+}
+
 std::vector<double> wigner6j(double l2, double l3,
 					double l4, double l5, double l6)
 {
@@ -408,20 +1093,72 @@ std::vector<double> wigner6j(double l2, double l3,
 	}
 
 	// We compute the overall factor.
-	double sum = 0.0;
-	for (unsigned int k=0;k<size;k++)
-	{
-		sum += (2.0*(l1min+k)+1.0)*(2.0*l4+1.0)*sixcof[k]*sixcof[k];
-	}
+	const Kernels& kernel = kernels();
+	double sum = (2.0*l4+1.0)*kernel.normalizationSum(&sixcof[0],size,l1min);
 	double c1 = pow(-1.0,std::floor(l2+l3+l5+l6+eps))*sgn(sixcof[size-1])/sqrt(sum);
 
-	for (std::vector<double>::iterator it = sixcof.begin(); it != sixcof.end(); ++it)
+	kernel.scale(&sixcof[0],size,c1);
+	return sixcof;
+}
+
+std::vector<double> wigner6j(double l2, double l3,
+					double l4, double l5, double l6,
+					RecursionMode mode)
+{
+	if (mode==SchultenGordonRescale) return wigner6j(l2,l3,l4,l5,l6);
+
+	// We use the same threshold as for the 3j symbols, so that the
+	// normalization sum cannot overflow.
+	double huge = sqrt(std::numeric_limits<double>::max()/20.0);
+	double srhuge = sqrt(huge);
+	double eps = std::numeric_limits<double>::epsilon();
+
+	// Triangle relations and sum rules of the tryads that do not involve l1.
+	bool select = (
+		std::fabs(l4-l2) <= l6 && l6 <= l4+l2
+		&& std::fabs(l4-l5) <= l3 && l3 <= l4+l5
+		&& std::floor(l4+l2+l6)==(l4+l2+l6)
+		&& std::floor(l4+l5+l3)==(l4+l5+l3)
+		);
+
+	if (!select) return std::vector<double>(1,0.0);
+
+	// We compute the limits of l1 and the size of the resulting array.
+	double l1min = std::max(std::fabs(l2-l3),std::fabs(l5-l6));
+	double l1max = std::min(l2+l3,l5+l6);
+	int size = (int)std::floor(l1max-l1min+1.0+eps);
+	if (size<1) return std::vector<double>(1,0.0);
+	std::vector<double> sixcof(size,0.0);
+
+	if (size==1)
 	{
-		*it *= c1;
+		sixcof[0] = 1.0/sqrt((l1min+l1min+1.0)*(l4+l4+1.0));
+		sixcof[0] *= ((int)std::floor(l2+l3+l5+l6+eps) & 1 ? -1.0 : 1.0);
+		return sixcof;
 	}
+
+	// We tabulate the auxiliary functions with the vectorized kernels.
+	const Kernels& kernel = kernels();
+	double* A = ScratchArena::local().reserve(2*size);
+	double* B = A+size;
+	kernel.wigner6jCoefficients(l1min,size,l2,l3,l4,l5,l6,A,B);
+
+	Wigner6jRecursion r = {l2,l3,l4,l5,l6};
+	TabulatedRecursion<Wigner6jRecursion> t = {r,l1min,A,B};
+	tabulatedFamily(t,l1max,size,srhuge,pow(-1.0,std::floor(l2+l3+l5+l6+eps)),2.0*l4+1.0,mode,sixcof);
 	return sixcof;
 }
 
+void setSplitRecursionThreshold(int size)
+{
+	splitThreshold = std::max(size,16);
+}
+
+int splitRecursionThreshold()
+{
+	return splitThreshold;
+}
+
 double wigner6j(double l1, double l2, double l3,
 					double l4, double l5, double l6)
 {
@@ -453,6 +1190,219 @@ double wigner6j(double l1, double l2, double l3,
 	return wigner6j(l2,l3,l4,l5,l6)[index];
 }
 
+namespace {
+
+/*! Arguments (l2,l3,m1,m2,m3) of the family in l1 that holds the symbols
+ * along l_varying. (l1 l2 l3; m1 m2 m3) = (l2 l3 l1; m2 m3 m1)
+ * = (l3 l1 l2; m3 m1 m2). */
+bool wigner3jColumn(int varying, double l1, double l2, double l3,
+				double m1, double m2, double m3, double* p)
+{
+	switch (varying)
+	{
+	case 1: p[0] = l2; p[1] = l3; p[2] = m1; p[3] = m2; p[4] = m3; return true;
+	case 2: p[0] = l3; p[1] = l1; p[2] = m2; p[3] = m3; p[4] = m1; return true;
+	case 3: p[0] = l1; p[1] = l2; p[2] = m3; p[3] = m1; p[4] = m2; return true;
+	default: return false;
+	}
+}
+
+/*! Arguments (l2,l3,l4,l5,l6) of the family in l1 that holds the symbols
+ * along l_varying. We permute the columns and exchange the upper and lower
+ * arguments of two of them. */
+bool wigner6jColumn(int varying, double l1, double l2, double l3,
+				double l4, double l5, double l6, double* p)
+{
+	switch (varying)
+	{
+	case 1: p[0] = l2; p[1] = l3; p[2] = l4; p[3] = l5; p[4] = l6; return true; // {l1 l2 l3; l4 l5 l6}
+	case 2: p[0] = l1; p[1] = l3; p[2] = l5; p[3] = l4; p[4] = l6; return true; // {l2 l1 l3; l5 l4 l6}
+	case 3: p[0] = l2; p[1] = l1; p[2] = l6; p[3] = l5; p[4] = l4; return true; // {l3 l2 l1; l6 l5 l4}
+	case 4: p[0] = l5; p[1] = l3; p[2] = l1; p[3] = l2; p[4] = l6; return true; // {l4 l5 l3; l1 l2 l6}
+	case 5: p[0] = l4; p[1] = l3; p[2] = l2; p[3] = l1; p[4] = l6; return true; // {l5 l4 l3; l2 l1 l6}
+	case 6: p[0] = l5; p[1] = l1; p[2] = l3; p[3] = l2; p[4] = l4; return true; // {l6 l5 l1; l3 l2 l4}
+	default: return false;
+	}
+}
+
+}
+
+std::vector<double> wigner3j_family(int varying,
+					double l1, double l2, double l3,
+					double m1, double m2, double m3)
+{
+	double p[5];
+	if (!wigner3jColumn(varying,l1,l2,l3,m1,m2,m3,p)) return std::vector<double>();
+	return wigner3j(p[0],p[1],p[2],p[3],p[4]);
+}
+
+std::vector<double> wigner3j_family(int varying,
+					double l1, double l2, double l3,
+					double m1, double m2, double m3,
+					RecursionMode mode)
+{
+	double p[5];
+	if (!wigner3jColumn(varying,l1,l2,l3,m1,m2,m3,p)) return std::vector<double>();
+	return wigner3j(p[0],p[1],p[2],p[3],p[4],mode);
+}
+
+std::vector<double> wigner6j_family(int varying,
+					double l1, double l2, double l3,
+					double l4, double l5, double l6)
+{
+	double p[5];
+	if (!wigner6jColumn(varying,l1,l2,l3,l4,l5,l6,p)) return std::vector<double>();
+	return wigner6j(p[0],p[1],p[2],p[3],p[4]);
+}
+
+std::vector<double> wigner6j_family(int varying,
+					double l1, double l2, double l3,
+					double l4, double l5, double l6,
+					RecursionMode mode)
+{
+	double p[5];
+	if (!wigner6jColumn(varying,l1,l2,l3,l4,l5,l6,p)) return std::vector<double>();
+	return wigner6j(p[0],p[1],p[2],p[3],p[4],mode);
+}
+
+Wigner3jPlan wigner3jPlan(double l2, double l3)
+{
+	double eps = std::numeric_limits<double>::epsilon();
+
+	Wigner3jPlan plan;
+	plan.l2 = l2;
+	plan.l3 = l3;
+	plan.l1min = std::fabs(l2-l3);
+
+	int size = (int)std::floor(l2+l3-plan.l1min+1.0+eps);
+	double d23 = (l2-l3)*(l2-l3);
+	double s23 = (l2+l3+1.0)*(l2+l3+1.0);
+	plan.S.resize(std::max(size,0));
+	for (int k=0;k<size;k++)
+	{
+		double l1sq = (plan.l1min+k)*(plan.l1min+k);
+		plan.S[k] = sqrt((l1sq-d23)*(s23-l1sq));
+	}
+	return plan;
+}
+
+std::vector<double> wigner3j(const Wigner3jPlan& plan,
+					double m1, double m2, double m3)
+{
+	return wigner3j(plan,m1,m2,m3,SchultenGordonScaled);
+}
+
+std::vector<double> wigner3j(const Wigner3jPlan& plan,
+					double m1, double m2, double m3,
+					RecursionMode mode)
+{
+	double l2 = plan.l2, l3 = plan.l3;
+	if (mode==SchultenGordonRescale) return wigner3j(l2,l3,m1,m2,m3);
+
+	double huge = sqrt(std::numeric_limits<double>::max()/20.0);
+	double srhuge = sqrt(huge);
+	double eps = std::numeric_limits<double>::epsilon();
+
+	// We enforce the selection rules.
+	bool select = (
+		   std::fabs(m1+m2+m3)<eps
+		&& std::fabs(m2) <= l2+eps
+		&& std::fabs(m3) <= l3+eps
+		);
+
+	if (!select) return std::vector<double>(1,0.0);
+
+	// The family starts |m1|-|l2-l3| entries into the plan, if |m1| > |l2-l3|.
+	double l1min = std::max(plan.l1min,std::fabs(m1));
+	double l1max = l2+l3;
+	int size = (int)std::floor(l1max-l1min+1.0+eps);
+	int first = (int)(l1min-plan.l1min+0.5);
+	std::vector<double> thrcof(size,0.0);
+
+	if (size==1)
+	{
+		thrcof[0] = pow(-1.0,std::floor(std::fabs(l2+m2-l3+m3)))/sqrt(l1min+l2+l3+1.0);
+		return thrcof;
+	}
+
+	const Kernels& kernel = kernels();
+	double* A = ScratchArena::local().reserve(2*size);
+	double* B = A+size;
+	kernel.wigner3jPlanCoefficients(l1min,size,&plan.S[first],l2,l3,m1,m2,m3,A,B);
+
+	Wigner3jRecursion r = {l2,l3,m1,m2,m3};
+	TabulatedRecursion<Wigner3jRecursion> t = {r,l1min,A,B};
+	tabulatedFamily(t,l1max,size,srhuge,pow(-1.0,l2-l3-m1),1.0,mode,thrcof);
+	return thrcof;
+}
+
+Wigner6jPlan wigner6jPlan(double l2, double l3, double l5, double l6)
+{
+	double eps = std::numeric_limits<double>::epsilon();
+
+	Wigner6jPlan plan;
+	plan.l2 = l2;
+	plan.l3 = l3;
+	plan.l5 = l5;
+	plan.l6 = l6;
+	plan.l1min = std::max(std::fabs(l2-l3),std::fabs(l5-l6));
+
+	// With l4 = 0, the kernel leaves the l4-independent part of B in C.
+	int size = (int)std::floor(std::min(l2+l3,l5+l6)-plan.l1min+1.0+eps);
+	if (size<1) return plan;
+	plan.A.resize(size);
+	plan.C.resize(size);
+	kernels().wigner6jCoefficients(plan.l1min,size,l2,l3,0.0,l5,l6,&plan.A[0],&plan.C[0]);
+	return plan;
+}
+
+std::vector<double> wigner6j(const Wigner6jPlan& plan, double l4)
+{
+	return wigner6j(plan,l4,SchultenGordonScaled);
+}
+
+std::vector<double> wigner6j(const Wigner6jPlan& plan, double l4,
+					RecursionMode mode)
+{
+	double l2 = plan.l2, l3 = plan.l3, l5 = plan.l5, l6 = plan.l6;
+	if (mode==SchultenGordonRescale) return wigner6j(l2,l3,l4,l5,l6);
+
+	double huge = sqrt(std::numeric_limits<double>::max()/20.0);
+	double srhuge = sqrt(huge);
+	double eps = std::numeric_limits<double>::epsilon();
+
+	// Triangle relations and sum rules of the tryads that involve l4.
+	bool select = (
+		std::fabs(l4-l2) <= l6 && l6 <= l4+l2
+		&& std::fabs(l4-l5) <= l3 && l3 <= l4+l5
+		&& std::floor(l4+l2+l6)==(l4+l2+l6)
+		&& std::floor(l4+l5+l3)==(l4+l5+l3)
+		);
+
+	int size = (int)plan.A.size();
+	if (!select || size<1) return std::vector<double>(1,0.0);
+
+	double l1min = plan.l1min;
+	double l1max = l1min+size-1;
+	std::vector<double> sixcof(size,0.0);
+
+	if (size==1)
+	{
+		sixcof[0] = 1.0/sqrt((l1min+l1min+1.0)*(l4+l4+1.0));
+		sixcof[0] *= ((int)std::floor(l2+l3+l5+l6+eps) & 1 ? -1.0 : 1.0);
+		return sixcof;
+	}
+
+	// Only B depends on l4.
+	double* B = ScratchArena::local().reserve(size);
+	kernels().wigner6jPlanCoefficients(l1min,size,&plan.C[0],l4,B);
+
+	Wigner6jRecursion r = {l2,l3,l4,l5,l6};
+	TabulatedRecursion<Wigner6jRecursion> t = {r,l1min,&plan.A[0],B};
+	tabulatedFamily(t,l1max,size,srhuge,pow(-1.0,std::floor(l2+l3+l5+l6+eps)),2.0*l4+1.0,mode,sixcof);
+	return sixcof;
+}
+
 double wigner3j_auxA(double l1, double l2, double l3,
                                                double m1, double /*m2*/, double /*m3*/)
 {
@@ -56,3 +56,76 @@ subroutine drc6j_wrap(l2, l3, l4, l5, l6, l1min, l1max, sixcof, ndim, ier) bind(
 
       call DRC6J(l2, l3, l4, l5, l6, l1min, l1max, sixcof, ndim, ier)
 end subroutine drc6j_wrap
+
+! ----------------------------------------------------------------
+! - Batched versions of the wrappers above. They evaluate nset     -
+! - families in a single call to amortize the cost of crossing     -
+! - the C/Fortran boundary. The family k is stored in              -
+! - thrcof(offsets(k)+1:offsets(k+1)). Sets with an empty slot are -
+! - skipped. When compiled with OpenMP, the families are           -
+! - distributed among the threads.                                 -
+! ----------------------------------------------------------------
+
+subroutine drc3jj_batch_wrap(nset, l2, l3, m2, m3, offsets, l1min, l1max, thrcof, ndim, ier) bind(C)
+
+  use iso_c_binding
+  implicit none
+
+  integer (c_int), value, intent(in)              :: nset, ndim
+  real(c_double), dimension(nset), intent(in)     :: l2, l3, m2, m3
+  integer (c_int), dimension(nset+1), intent(in)  :: offsets
+  real(c_double), dimension(nset), intent(out)    :: l1min, l1max
+  real(c_double), dimension(ndim), intent(out)    :: thrcof
+  integer (c_int), dimension(nset), intent(out)   :: ier
+
+  integer :: k
+
+  interface
+          SUBROUTINE DRC3JJ (L2, L3, M2, M3, L1MIN, L1MAX, THRCOF, NDIM, IER)
+              INTEGER NDIM, IER
+              DOUBLE PRECISION L2, L3, M2, M3, L1MIN, L1MAX, THRCOF(NDIM)
+          end SUBROUTINE DRC3JJ
+          end interface
+
+  !$omp parallel do schedule(dynamic)
+  do k = 1, nset
+     ier(k) = 0
+     if (offsets(k+1) > offsets(k)) then
+        call DRC3JJ(l2(k), l3(k), m2(k), m3(k), l1min(k), l1max(k), &
+                    thrcof(offsets(k)+1), offsets(k+1)-offsets(k), ier(k))
+     end if
+  end do
+  !$omp end parallel do
+
+end subroutine drc3jj_batch_wrap
+
+subroutine drc6j_batch_wrap(nset, l2, l3, l4, l5, l6, offsets, l1min, l1max, sixcof, ndim, ier) bind(C)
+      use iso_c_binding
+      implicit none
+
+      integer(c_int), value, intent(in)               :: nset, ndim
+      real(c_double), dimension(nset), intent(in)     :: l2, l3, l4, l5, l6
+      integer(c_int), dimension(nset+1), intent(in)   :: offsets
+      real(c_double), dimension(nset), intent(out)    :: l1min, l1max
+      real(c_double), dimension(ndim), intent(out)    :: sixcof
+      integer(c_int), dimension(nset), intent(out)    :: ier
+
+      integer :: k
+
+      interface
+          SUBROUTINE DRC6J(L2, L3, L4, L5, L6, L1MIN, L1MAX, SIXCOF, NDIM, IER)
+              INTEGER NDIM, IER
+              DOUBLE PRECISION L2, L3, L4, L5, L6, L1MIN, L1MAX, SIXCOF(NDIM)
+          END SUBROUTINE DRC6J
+      end interface
+
+      !$omp parallel do schedule(dynamic)
+      do k = 1, nset
+         ier(k) = 0
+         if (offsets(k+1) > offsets(k)) then
+            call DRC6J(l2(k), l3(k), l4(k), l5(k), l6(k), l1min(k), l1max(k), &
+                       sixcof(offsets(k)+1), offsets(k+1)-offsets(k), ier(k))
+         end if
+      end do
+      !$omp end parallel do
+end subroutine drc6j_batch_wrap
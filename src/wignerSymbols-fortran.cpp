@@ -6,6 +6,7 @@
  ********************************************************/
 
 #include "../include/wignerSymbols/wignerSymbols-fortran.h"
+#include "../include/wignerSymbols/scratchArena.h"
 
 namespace WignerSymbols {
 
@@ -49,19 +50,38 @@ double wigner3j_f(double l1, double l2, double l3,
   // We compute the size of the resulting array.
   int size = (int)std::ceil(l2+l3-std::max(std::fabs(l2-l3),std::fabs(m1)))+1;
 
-  // We prepare the output values.
+  // We prepare the output values. The family is written in the scratch
+  // arena of this thread to avoid a heap allocation per call.
   double l1min, l1max;
-  std::vector<double> thrcof(size);
+  double* thrcof = ScratchArena::local().reserve(size);
   int ierr;
 
   // External function call.
-  drc3jj_wrap(l2,l3,m2,m3,&l1min,&l1max,thrcof.data(),size,&ierr);
+  drc3jj_wrap(l2,l3,m2,m3,&l1min,&l1max,thrcof,size,&ierr);
 
   // We fetch and return the value with the proper l1 value.
   int index = (int)(l1-l1min);
   return thrcof[index];
 }
 
+/*! Computes a string of Wigner-6j symbols for given l2, l3, l4, l5, l6. */
+std::vector<double> wigner6j_f(double l2, double l3, double l4, double l5, double l6)
+{
+  // We prepare the size of the resulting array.
+  int size = (int)std::ceil(std::min(l2+l3,l5+l6)-std::max(std::fabs(l2-l3),std::fabs(l5-l6)))+1;
+  if (size < 1) return std::vector<double>(1,0.0);
+
+  // We prepare the output values.
+  double l1min, l1max;
+  std::vector<double> sixcof(size);
+  int ierr;
+
+  // External function call.
+  drc6j_wrap(l2,l3,l4,l5,l6,&l1min,&l1max,sixcof.data(),size,&ierr);
+
+  return sixcof;
+}
+
 double wigner6j_f(double l1, double l2, double l3,
              double l4, double l5, double l6)
 {
@@ -89,16 +109,127 @@ double wigner6j_f(double l1, double l2, double l3,
   // We compute the size of the resulting array.
   int size = (int)std::ceil(std::min(l2+l3,l5+l6)-std::max(std::fabs(l2-l3),std::fabs(l5-l6)))+1;
 
-  // We prepare the output values
+  // We prepare the output values. The family is written in the scratch
+  // arena of this thread to avoid a heap allocation per call.
   double l1min, l1max;
-  std::vector<double> sixcof(size);
+  double* sixcof = ScratchArena::local().reserve(size);
   int ierr;
 
   // External function call
-  drc6j_wrap(l2,l3,l4,l5,l6,&l1min,&l1max,sixcof.data(),size,&ierr);
+  drc6j_wrap(l2,l3,l4,l5,l6,&l1min,&l1max,sixcof,size,&ierr);
 
   // We fetch and return the coefficient with the proper l1 value.
   int index = (int)(l1-l1min);
   return sixcof[index];
 }
+
+std::vector<double> wigner3j_batch_f(const std::vector<double>& l2, const std::vector<double>& l3,
+                                     const std::vector<double>& m1, const std::vector<double>& m2,
+                                     const std::vector<double>& m3, std::vector<int>& offsets,
+                                     std::vector<int>* errors)
+{
+  // Parameter vectors of different lengths are rejected.
+  std::size_t n = l2.size();
+  if (l3.size() != n || m1.size() != n || m2.size() != n || m3.size() != n)
+  {
+    offsets.clear();
+    if (errors) errors->clear();
+    return std::vector<double>();
+  }
+  int nset = (int)n;
+
+  // We compute the position of each string in the output array. Sets that
+  // violate the selection rules are given an empty slot and are skipped by
+  // the Fortran code. We check all the conditions under which DRC3JJ fails,
+  // since its error handler stops the program.
+  offsets.assign(nset+1,0);
+  for (int k=0;k<nset;k++)
+  {
+    double l1min = std::max(std::fabs(l2[k]-l3[k]),std::fabs(m1[k]));
+    double l1max = l2[k]+l3[k];
+    bool select = (
+             std::fabs(m1[k]+m2[k]+m3[k])<1.0e-10
+             && std::fabs(m2[k]) <= l2[k]
+             && std::fabs(m3[k]) <= l3[k]
+             && std::floor(l2[k]+std::fabs(m2[k]))==(l2[k]+std::fabs(m2[k]))
+             && std::floor(l3[k]+std::fabs(m3[k]))==(l3[k]+std::fabs(m3[k]))
+             && std::floor(l1max-l1min)==(l1max-l1min)
+             && l1min <= l1max
+           );
+
+    int size = 0;
+    if (select)
+      size = (int)(l1max-l1min)+1;
+
+    offsets[k+1] = offsets[k]+std::max(size,0);
+  }
+
+  // We prepare the output values.
+  std::vector<double> thrcof(offsets[nset],0.0);
+  std::vector<double> l1min(nset), l1max(nset);
+  std::vector<int> ierr(nset);
+
+  // External function call.
+  if (nset > 0)
+    drc3jj_batch_wrap(nset,l2.data(),l3.data(),m2.data(),m3.data(),offsets.data(),
+                      l1min.data(),l1max.data(),thrcof.data(),(int)thrcof.size(),ierr.data());
+  if (errors) errors->swap(ierr);
+
+  return thrcof;
+}
+
+std::vector<double> wigner6j_batch_f(const std::vector<double>& l2, const std::vector<double>& l3,
+                                     const std::vector<double>& l4, const std::vector<double>& l5,
+                                     const std::vector<double>& l6, std::vector<int>& offsets,
+                                     std::vector<int>* errors)
+{
+  // Parameter vectors of different lengths are rejected.
+  std::size_t n = l2.size();
+  if (l3.size() != n || l4.size() != n || l5.size() != n || l6.size() != n)
+  {
+    offsets.clear();
+    if (errors) errors->clear();
+    return std::vector<double>();
+  }
+  int nset = (int)n;
+
+  // We compute the position of each string in the output array. As for
+  // the 3j symbols, we check all the conditions under which DRC6J fails.
+  offsets.assign(nset+1,0);
+  for (int k=0;k<nset;k++)
+  {
+    // Triangle relations and sum rules of the tryads that do not involve l1,
+    // and the range of l1.
+    double l1min = std::max(std::fabs(l2[k]-l3[k]),std::fabs(l5[k]-l6[k]));
+    double l1max = std::min(l2[k]+l3[k],l5[k]+l6[k]);
+    bool select = (
+        std::fabs(l4[k]-l2[k]) <= l6[k] && l6[k] <= l4[k]+l2[k]
+        && std::fabs(l4[k]-l5[k]) <= l3[k] && l3[k] <= l4[k]+l5[k]
+        && std::floor(l4[k]+l2[k]+l6[k])==(l4[k]+l2[k]+l6[k])
+        && std::floor(l4[k]+l5[k]+l3[k])==(l4[k]+l5[k]+l3[k])
+        && std::floor(l2[k]+l3[k]+l5[k]+l6[k])==(l2[k]+l3[k]+l5[k]+l6[k])
+        && std::floor(l1max-l1min)==(l1max-l1min)
+        && l1min <= l1max
+        );
+
+    int size = 0;
+    if (select)
+      size = (int)(l1max-l1min)+1;
+
+    offsets[k+1] = offsets[k]+std::max(size,0);
+  }
+
+  // We prepare the output values.
+  std::vector<double> sixcof(offsets[nset],0.0);
+  std::vector<double> l1min(nset), l1max(nset);
+  std::vector<int> ierr(nset);
+
+  // External function call.
+  if (nset > 0)
+    drc6j_batch_wrap(nset,l2.data(),l3.data(),l4.data(),l5.data(),l6.data(),offsets.data(),
+                     l1min.data(),l1max.data(),sixcof.data(),(int)sixcof.size(),ierr.data());
+  if (errors) errors->swap(ierr);
+
+  return sixcof;
+}
 }
@@ -0,0 +1,155 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html.              -/
+ ********************************************************/
+
+#include "../include/wignerSymbols/workStealing.h"
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace WignerSymbols {
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+/*! Tasks waiting to be executed by a thread. The owner pops from the
+ * front, where the most expensive tasks are, and thieves take from the
+ * back. */
+struct WorkQueue
+{
+  std::mutex              lock;
+  std::deque<std::size_t> tasks;
+};
+
+double seconds(Clock::duration d)
+{
+  return std::chrono::duration<double>(d).count();
+}
+
+}
+
+double SchedulerStats::utilization() const
+{
+  if (workers.empty() || wallSeconds <= 0.0) return 0.0;
+
+  double busy = 0.0;
+  for (std::size_t i=0;i<workers.size();i++)
+    busy += workers[i].busySeconds;
+
+  return busy/(wallSeconds*workers.size());
+}
+
+void parallelFor(std::size_t n, const std::vector<double>& cost, unsigned int nthreads,
+                 const std::function<void(std::size_t)>& task, SchedulerStats* stats)
+{
+  Clock::time_point start = Clock::now();
+
+  if (nthreads == 0)
+    nthreads = std::max(1u, std::thread::hardware_concurrency());
+
+  // We sort the tasks by decreasing cost.
+  std::vector<std::size_t> order(n);
+  for (std::size_t k=0;k<n;k++) order[k] = k;
+  if (cost.size() >= n)
+  {
+    std::stable_sort(order.begin(), order.end(),
+                     [&cost](std::size_t a, std::size_t b) { return cost[a] > cost[b]; });
+  }
+
+  // We deal them in a snake order so that all the queues start with
+  // comparable amounts of work.
+  std::vector<WorkQueue> queues(nthreads);
+  for (std::size_t k=0;k<n;k++)
+  {
+    std::size_t round = k/nthreads;
+    std::size_t pos   = k%nthreads;
+    std::size_t q     = (round%2 == 0 ? pos : nthreads-1-pos);
+    queues[q].tasks.push_back(order[k]);
+  }
+
+  std::vector<WorkerStats> workers(nthreads);
+
+  auto worker = [&](unsigned int id)
+  {
+    WorkerStats& me  = workers[id];
+    WorkQueue& own   = queues[id];
+    me.tasks         = 0;
+    me.steals        = 0;
+    me.busySeconds   = 0.0;
+
+    std::vector<std::size_t> loot;
+    for (;;)
+    {
+      std::size_t k     = 0;
+      bool        found = false;
+
+      {
+        std::lock_guard<std::mutex> guard(own.lock);
+        if (!own.tasks.empty())
+        {
+          k = own.tasks.front();
+          own.tasks.pop_front();
+          found = true;
+        }
+      }
+
+      // Our queue is empty. We steal half of the remaining tasks of the
+      // first busy thread we find. As tasks are never created during the
+      // loop, we are done when all the queues are empty.
+      for (unsigned int v=1;v<nthreads && !found;v++)
+      {
+        WorkQueue& victim = queues[(id+v)%nthreads];
+        {
+          std::lock_guard<std::mutex> guard(victim.lock);
+          std::size_t half = (victim.tasks.size()+1)/2;
+          for (std::size_t i=0;i<half;i++)
+          {
+            loot.push_back(victim.tasks.back());
+            victim.tasks.pop_back();
+          }
+        }
+
+        if (!loot.empty())
+        {
+          k     = loot.back();
+          found = true;
+          loot.pop_back();
+          me.steals++;
+
+          std::lock_guard<std::mutex> guard(own.lock);
+          own.tasks.insert(own.tasks.end(), loot.rbegin(), loot.rend());
+          loot.clear();
+        }
+      }
+
+      if (!found) break;
+
+      Clock::time_point begin = Clock::now();
+      task(k);
+      me.busySeconds += seconds(Clock::now()-begin);
+      me.tasks++;
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (unsigned int id=1;id<nthreads;id++)
+    threads.push_back(std::thread(worker, id));
+  worker(0);
+  for (std::size_t i=0;i<threads.size();i++)
+    threads[i].join();
+
+  if (stats)
+  {
+    stats->wallSeconds = seconds(Clock::now()-start);
+    stats->workers     = workers;
+  }
+}
+
+} // namespace WignerSymbols
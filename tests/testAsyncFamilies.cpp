@@ -0,0 +1,178 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html               -/
+ ********************************************************/
+
+/*! \file testAsyncFamilies.cpp
+ *  \author Joey Dumont <joey.dumont@gmail.com>
+ *  \since 2026-10-18
+ *  \brief Tests the asynchronous computation of families.
+ *  \copyright LGPL
+ * The families written by the jobs must match the synchronous calls, and
+ * each callback must run exactly once. Cancelled jobs and jobs with a
+ * buffer too small must leave their buffer untouched, also when the
+ * cancellation races with the end of the job. A callback that throws must
+ * fail its job, not the pool.
+ */
+
+#include <wignerSymbols.h>
+
+#include <atomic>
+#include <stdexcept>
+
+using namespace WignerSymbols;
+
+static const double sentinel = 12345.0;
+
+static bool untouched(const std::vector<double>& buffer)
+{
+  for (std::size_t i=0;i<buffer.size();i++)
+    if (buffer[i] != sentinel) return false;
+  return true;
+}
+
+int main()
+{
+  int failures = 0;
+
+  // Many small families through a short queue, with callbacks.
+  {
+    FamilyJobPool pool(4,8);
+    std::atomic<int> callbacks(0);
+    std::vector<std::vector<double> > buffers;
+    std::vector<FamilyJob> jobs;
+    std::vector<std::vector<double> > expected;
+    for (int l2=0;l2<=12;l2++)
+      for (int l3=0;l3<=l2;l3++)
+      {
+        double m2 = l2/2, m3 = -l3;
+        expected.push_back(wigner3j(l2,l3,-m2-m3,m2,m3,SchultenGordonScaled));
+        expected.push_back(wigner6j(l2,l3,l3,l3,l2,SchultenGordonScaled));
+      }
+    buffers.resize(expected.size());
+    int k = 0;
+    for (int l2=0;l2<=12;l2++)
+      for (int l3=0;l3<=l2;l3++)
+      {
+        double m2 = l2/2, m3 = -l3;
+        buffers[k].assign(expected[k].size(),sentinel);
+        jobs.push_back(pool.wigner3j(l2,l3,-m2-m3,m2,m3,buffers[k].data(),buffers[k].size(),SchultenGordonScaled,
+                                     [&callbacks](FamilyJobStatus, std::size_t) { callbacks++; }));
+        k++;
+        buffers[k].assign(expected[k].size(),sentinel);
+        jobs.push_back(pool.wigner6j(l2,l3,l3,l3,l2,buffers[k].data(),buffers[k].size(),SchultenGordonScaled,
+                                     [&callbacks](FamilyJobStatus, std::size_t) { callbacks++; }));
+        k++;
+      }
+    for (std::size_t j=0;j<jobs.size();j++)
+    {
+      if (jobs[j].wait() != FamilyJobDone || jobs[j].size() != expected[j].size()) failures++;
+      if (buffers[j] != expected[j]) failures++;
+    }
+    if (callbacks != (int)jobs.size()) failures++;
+  }
+
+  // A large family computed while the calling thread computes another.
+  {
+    const double l = 10000.0;
+    std::vector<double> buffer(2*(std::size_t)l+1,sentinel);
+    std::size_t reported = 0;
+    FamilyJob job = wigner3j_async(l,l,0.0,5.0,-5.0,buffer.data(),buffer.size(),
+                                   [&reported](FamilyJobStatus, std::size_t n) { reported = n; });
+    std::vector<double> other = wigner6j(200,210,190,205,195,SchultenGordonScaled);
+    if (job.wait() != FamilyJobDone || reported != buffer.size()) failures++;
+    if (buffer != wigner3j(l,l,0.0,5.0,-5.0,SchultenGordonScaled) || other.empty()) failures++;
+  }
+
+  // A buffer too small is rejected at once.
+  {
+    std::vector<double> buffer(10,sentinel);
+    FamilyJobStatus reported = FamilyJobPending;
+    FamilyJob job = wigner6j_async(20,20,20,20,20,buffer.data(),buffer.size(),
+                                   [&reported](FamilyJobStatus s, std::size_t) { reported = s; });
+    if (job.status() != FamilyJobTooSmall || reported != FamilyJobTooSmall || job.size() != 41) failures++;
+    if (job.cancel() || !untouched(buffer)) failures++;
+  }
+
+  // The families that violate a selection rule are a single zero, which
+  // fits in a buffer of one symbol.
+  {
+    double zero3j = sentinel, zero6j = sentinel;
+    FamilyJob job3j = wigner3j_async(2,3,0,5,-5,&zero3j,1);
+    FamilyJob job6j = wigner6j_async(1,1,5,1,1,&zero6j,1);
+    if (job3j.wait() != FamilyJobDone || job3j.size() != 1 || zero3j != 0.0) failures++;
+    if (job6j.wait() != FamilyJobDone || job6j.size() != 1 || zero6j != 0.0) failures++;
+  }
+
+  // Cancellation, on a single thread kept busy by a large family.
+  {
+    FamilyJobPool pool(1);
+    const double l = 20000.0;
+    std::vector<double> large(2*(std::size_t)l+1,sentinel);
+    FamilyJob busy = pool.wigner3j(l,l,0.0,1.0,-1.0,large.data(),large.size());
+    std::vector<std::vector<double> > buffers(4,std::vector<double>(41,sentinel));
+    std::vector<FamilyJob> jobs;
+    std::atomic<int> cancelled(0);
+    for (int j=0;j<4;j++)
+      jobs.push_back(pool.wigner3j(20,20,0,0,0,buffers[j].data(),41,SchultenGordonScaled,
+                                   [&cancelled](FamilyJobStatus s, std::size_t) { if (s == FamilyJobCancelled) cancelled++; }));
+    for (int j=0;j<2;j++)
+      if (!jobs[j].cancel() || jobs[j].status() != FamilyJobCancelled) failures++;
+    if (cancelled != 2) failures++;
+
+    // The running job either finishes, or is cancelled before its copy.
+    while (busy.status() == FamilyJobPending) busy.waitFor(1.0e-4);
+    bool stopped = busy.cancel();
+    FamilyJobStatus status = busy.wait();
+    if (stopped ? (status != FamilyJobCancelled || !untouched(large)) : status != FamilyJobDone) failures++;
+
+    for (int j=0;j<4;j++)
+    {
+      FamilyJobStatus s = jobs[j].wait();
+      if (j < 2 ? (s != FamilyJobCancelled || !untouched(buffers[j])) : s != FamilyJobDone) failures++;
+    }
+  }
+
+  // The pending jobs of a pool being destroyed are cancelled.
+  {
+    std::vector<double> large(40001), buffer(41,sentinel);
+    FamilyJob pending;
+    {
+      FamilyJobPool pool(1);
+      pool.wigner3j(20000,20000,0,0,0,large.data(),large.size());
+      pending = pool.wigner3j(20,20,0,0,0,buffer.data(),buffer.size());
+    }
+    FamilyJobStatus s = pending.wait();
+    if ((s == FamilyJobCancelled && !untouched(buffer)) || (s != FamilyJobCancelled && s != FamilyJobDone)) failures++;
+  }
+
+  // Short jobs cancelled as they finish are either cancelled, with their
+  // buffer untouched, or done.
+  {
+    FamilyJobPool pool(2);
+    for (int r=0;r<2000;r++)
+    {
+      std::vector<double> buffer(41,sentinel);
+      FamilyJob job = pool.wigner3j(20,20,0,0,0,buffer.data(),buffer.size());
+      while (job.status() == FamilyJobPending) {}
+      bool cancelled = job.cancel();
+      FamilyJobStatus s = job.wait();
+      if (cancelled ? (s != FamilyJobCancelled || !untouched(buffer)) : s != FamilyJobDone) failures++;
+    }
+  }
+
+  // A callback that throws fails its job, and the worker goes on.
+  {
+    FamilyJobPool pool(1);
+    std::vector<double> buffer(41,sentinel), other(41,sentinel);
+    FamilyJob job = pool.wigner3j(20,20,0,0,0,buffer.data(),buffer.size(),SchultenGordonScaled,
+                                  [](FamilyJobStatus, std::size_t) { throw std::runtime_error("callback"); });
+    FamilyJob next = pool.wigner3j(20,20,0,0,0,other.data(),other.size());
+    if (job.wait() != FamilyJobFailed || next.wait() != FamilyJobDone) failures++;
+  }
+
+  std::cout << "Asynchronous families: " << failures << " failures." << std::endl;
+  return failures == 0 ? 0 : 1;
+}
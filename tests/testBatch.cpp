@@ -0,0 +1,99 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html               -/
+ ********************************************************/
+
+/*! \file testBatch.cpp
+ *  \author Joey Dumont <joey.dumont@gmail.com>
+ *  \since 2026-10-18
+ *  \brief Tests the batched Fortran wrappers.
+ *  \copyright LGPL
+ * We evaluate a batch of short and long families in a single call and
+ * compare each slot with the corresponding call to the unbatched wrappers.
+ * The error flags of the Fortran code must be reported, and parameter
+ * vectors of different lengths rejected.
+ */
+
+#include <wignerSymbols.h>
+
+int main()
+{
+  int failures = 0;
+
+  // A mix of families, one of which violates the selection rules.
+  std::vector<double> l2, l3, m1, m2, m3;
+  for (int k=0;k<40;k++)
+  {
+    l2.push_back(1.0+k%5);
+    l3.push_back(0.5*k);
+    m2.push_back(k%2 ? 0.0 : 1.0);
+    m3.push_back(0.5*((k%3)-1)*(k%2));
+    m1.push_back(-m2[k]-m3[k]);
+  }
+  m2[7] = 10.0;
+  m1[7] = -m2[7]-m3[7];
+
+  std::vector<int> offsets, errors;
+  std::vector<double> thrcof = WignerSymbols::wigner3j_batch_f(l2,l3,m1,m2,m3,offsets,&errors);
+  if (errors != std::vector<int>(l2.size(),0)) failures++;
+
+  for (size_t k=0;k<l2.size();k++)
+  {
+    bool valid = (std::fabs(m2[k])<=l2[k] && std::fabs(m3[k])<=l3[k]
+               && std::floor(l2[k]+m2[k])==l2[k]+m2[k] && std::floor(l3[k]+m3[k])==l3[k]+m3[k]);
+    if (!valid)
+    {
+      if (offsets[k+1]!=offsets[k]) failures++;
+      continue;
+    }
+
+    std::vector<double> ref = WignerSymbols::wigner3j_f(l2[k],l3[k],m1[k],m2[k],m3[k]);
+    if ((int)ref.size() != offsets[k+1]-offsets[k]) { failures++; continue; }
+    for (size_t i=0;i<ref.size();i++)
+      if (ref[i] != thrcof[offsets[k]+i]) failures++;
+  }
+
+  // Same for the 6j symbols.
+  std::vector<double> s2, s3, s4, s5, s6;
+  for (int k=0;k<30;k++)
+  {
+    s2.push_back(3.0+k%4);
+    s3.push_back(2.0+k%7);
+    s4.push_back(4.0);
+    s5.push_back(1.0+k%6);
+    s6.push_back(2.0+k%3);
+  }
+
+  std::vector<double> sixcof = WignerSymbols::wigner6j_batch_f(s2,s3,s4,s5,s6,offsets);
+  for (size_t k=0;k<s2.size();k++)
+  {
+    double l1min = std::max(std::fabs(s2[k]-s3[k]),std::fabs(s5[k]-s6[k]));
+    for (int i=offsets[k];i<offsets[k+1];i++)
+    {
+      double ref = WignerSymbols::wigner6j_f(l1min+i-offsets[k],s2[k],s3[k],s4[k],s5[k],s6[k]);
+      if (std::fabs(ref-sixcof[i]) > 1.0e-14) failures++;
+    }
+  }
+
+  // Sets that DRC3JJ and DRC6J would reject, which would stop the program:
+  // l2+|m2| = 0.6 is not an integer, and neither is l2+l3+l5+l6 = 1.4.
+  std::vector<double> b2(1,0.3), b3(1,0.7), b1(1,0.0), bm2(1,-0.3), bm3(1,0.3);
+  thrcof = WignerSymbols::wigner3j_batch_f(b2,b3,b1,bm2,bm3,offsets,&errors);
+  if (!thrcof.empty() || offsets.size() != 2 || errors != std::vector<int>(1,0)) failures++;
+  std::vector<double> c2(1,0.3), c3(1,0.4), c4(1,0.3), c5(1,0.3), c6(1,0.4);
+  sixcof = WignerSymbols::wigner6j_batch_f(c2,c3,c4,c5,c6,offsets,&errors);
+  if (!sixcof.empty() || offsets.size() != 2 || errors != std::vector<int>(1,0)) failures++;
+
+  // Parameter vectors of different lengths are rejected.
+  s6.pop_back();
+  sixcof = WignerSymbols::wigner6j_batch_f(s2,s3,s4,s5,s6,offsets,&errors);
+  if (!sixcof.empty() || !offsets.empty() || !errors.empty()) failures++;
+  m3.pop_back();
+  thrcof = WignerSymbols::wigner3j_batch_f(l2,l3,m1,m2,m3,offsets);
+  if (!thrcof.empty() || !offsets.empty()) failures++;
+
+  std::cout << "Batched evaluation: " << failures << " mismatches." << std::endl;
+  return (failures == 0 ? 0 : 1);
+}
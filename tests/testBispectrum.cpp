@@ -0,0 +1,67 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html               -/
+ ********************************************************/
+
+/*! \file testBispectrum.cpp
+ *  \author Joey Dumont <joey.dumont@gmail.com>
+ *  \since 2026-10-18
+ *  \brief Tests the batched bispectrum against scalar Clebsch-Gordan sums.
+ *  \copyright LGPL
+ * The number of environments is not a multiple of the width of the kernel,
+ * so that the padding of the last group is exercised. The result must not
+ * depend on the number of threads.
+ */
+
+#include <wignerSymbols.h>
+
+#include <random>
+
+int main()
+{
+  int failures = 0;
+  const int lmax = 5;
+  const std::size_t count = 2*WignerSymbols::bispectrumWidth+5;
+
+  WignerSymbols::BispectrumPlan plan = WignerSymbols::bispectrumPlan(lmax);
+  std::size_t ncoef = plan.coefficients();
+
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<double> uniform(-1.0,1.0);
+  std::vector<std::complex<double> > c(count*ncoef);
+  for (std::size_t i=0;i<c.size();i++)
+    c[i] = std::complex<double>(uniform(rng),uniform(rng));
+
+  std::vector<double> b = WignerSymbols::bispectrum(plan,c,1);
+  if (b.size() != count*plan.size()) failures++;
+
+  for (std::size_t e=0;e<count && !failures;e++)
+  {
+    const std::complex<double>* ce = &c[e*ncoef];
+    for (std::size_t t=0;t<plan.size();t++)
+    {
+      int l1 = plan.l1[t], l2 = plan.l2[t], l = plan.l[t];
+      std::complex<double> sum = 0.0;
+      for (int m1=-l1;m1<=l1;m1++)
+        for (int m2=-l2;m2<=l2;m2++)
+        {
+          int m = m1+m2;
+          if (std::abs(m) > l) continue;
+          sum += WignerSymbols::clebschGordan(l1,l2,l,m1,m2,m)
+                 *ce[l1*l1+l1+m1]*ce[l2*l2+l2+m2]*std::conj(ce[l*l+l+m]);
+        }
+      if (std::fabs(b[e*plan.size()+t]-sum.real()) > 1.0e-12) failures++;
+    }
+  }
+
+  std::vector<double> threaded = WignerSymbols::bispectrum(plan,c,3);
+  if (threaded != b) failures++;
+
+  std::vector<std::complex<double> > truncated(c.begin(),c.end()-1);
+  if (!WignerSymbols::bispectrum(plan,truncated).empty()) failures++;
+
+  std::cout << "Bispectrum: " << plan.size() << " descriptors, " << failures << " mismatches." << std::endl;
+  return (failures == 0 ? 0 : 1);
+}
@@ -0,0 +1,73 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html               -/
+ ********************************************************/
+
+/*! \file testClosedForms.cpp
+ *  \author Joey Dumont <joey.dumont@gmail.com>
+ *  \since 2026-10-18
+ *  \brief Tests the closed forms for small l2 against the recursion.
+ *  \copyright LGPL
+ * We compare the families and the single symbols with l2 <= 2 with the
+ * general recursion and the Fortran implementation, for small and large
+ * l3, integer and half-integer.
+ */
+
+#include <wignerSymbols.h>
+
+int main()
+{
+  int failures = 0, checked = 0;
+  WignerSymbols::RecursionMode scaled = WignerSymbols::SchultenGordonScaled;
+
+  for (double l2=0.0;l2<=WignerSymbols::closedFormMaxL2;l2+=0.5)
+    for (double l3=0.0;l3<=20.5;l3+=0.5)
+      for (double m2=-l2;m2<=l2;m2+=1.0)
+        for (double m3=-l3;m3<=l3;m3+=1.0)
+        {
+          double m1 = -m2-m3;
+          double l1min = std::max(std::fabs(l2-l3),std::fabs(m1));
+          if (l1min > l2+l3 || std::floor(l1min+l2+l3) != l1min+l2+l3) continue;
+
+          std::vector<double> closed    = WignerSymbols::wigner3j(l2,l3,m1,m2,m3);
+          std::vector<double> recursion = WignerSymbols::wigner3j(l2,l3,m1,m2,m3,scaled);
+          std::vector<double> fortran   = WignerSymbols::wigner3j_f(l2,l3,m1,m2,m3);
+          if (closed.size() != fortran.size()) { failures++; continue; }
+
+          for (size_t i=0;i<closed.size();i++)
+          {
+            double l1 = l1min+i;
+            if (std::fabs(closed[i]-fortran[i]) > 1.0e-14) failures++;
+            if (i < recursion.size() && std::fabs(closed[i]-recursion[i]) > 1.0e-14) failures++;
+            if (std::fabs(WignerSymbols::wigner3j(l1,l2,l3,m1,m2,m3)-closed[i]) > 0.0) failures++;
+            if (std::fabs(WignerSymbols::clebschGordan(l1,l2,l3,m1,m2,-m3)
+                         -WignerSymbols::clebschGordan_f(l1,l2,l3,m1,m2,-m3)) > 1.0e-13) failures++;
+            checked++;
+          }
+        }
+
+  // Large l3, where the factorials must not be formed explicitly.
+  double large[] = {1000.0, 12345.5, 99999.0};
+  for (size_t n=0;n<sizeof(large)/sizeof(large[0]);n++)
+    for (double l2=0.0;l2<=WignerSymbols::closedFormMaxL2;l2+=0.5)
+      for (double m2=-l2;m2<=l2;m2+=1.0)
+      {
+        double l3 = large[n];
+        double m3 = std::floor(0.6*l3)+(l3-std::floor(l3));
+        double m1 = -m2-m3;
+        if (std::fabs(m1) > l2+l3) continue;
+
+        std::vector<double> closed  = WignerSymbols::wigner3j_closedForm(l2,l3,m1,m2,m3);
+        std::vector<double> fortran = WignerSymbols::wigner3j_f(l2,l3,m1,m2,m3);
+        for (size_t i=0;i<closed.size() && i<fortran.size();i++)
+        {
+          if (std::fabs(closed[i]-fortran[i]) > 1.0e-14) failures++;
+          checked++;
+        }
+      }
+
+  std::cout << "Closed forms: " << failures << " mismatches out of " << checked << " symbols." << std::endl;
+  return (failures == 0 ? 0 : 1);
+}
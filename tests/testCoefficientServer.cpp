@@ -0,0 +1,179 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html               -/
+ ********************************************************/
+
+/*! \file testCoefficientServer.cpp
+ *  \author Joey Dumont <joey.dumont@gmail.com>
+ *  \since 2026-10-18
+ *  \brief Tests the coefficient server and its client.
+ *  \copyright LGPL
+ * A server is started in the process, on a socket of the temporary
+ * directory. The symbols it returns, with integer and half-integer
+ * arguments and outside the selection rules, must match the direct
+ * evaluations, for several clients at once. A malformed request, or one
+ * above the lmax of the server, must be rejected without stopping it.
+ */
+
+#include <wignerSymbols.h>
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace WignerSymbols;
+
+/*! Arguments of the symbols with 0 <= l <= lmax in steps of 1/2, and
+ * projections in steps of 1/2, six per symbol. Most of them violate a
+ * selection rule. */
+static std::vector<double> arguments(uint32_t kind, int lmax, unsigned int seed)
+{
+  std::vector<double> args;
+  unsigned int state = seed;
+  auto next = [&state](int n) { state = state*1103515245u + 12345u; return (int)((state >> 8) % (unsigned int)n); };
+  for (int i=0;i<2000;i++)
+  {
+    double l[3] = {0.5*next(2*lmax+1), 0.5*next(2*lmax+1), 0.5*next(2*lmax+1)};
+    if (kind == Wigner6jKind)
+    {
+      for (int k=0;k<3;k++) args.push_back(l[k]);
+      for (int k=0;k<3;k++) args.push_back(0.5*next(2*lmax+1));
+      continue;
+    }
+    // Bring the third momentum into the triangle most of the time.
+    if (i%4 != 0) l[2] = std::fabs(l[0]-l[1]) + next((int)(std::min(l[0],l[1])*2.0)+1);
+    double m1 = -l[0] + next((int)(2.0*l[0])+1), m2 = -l[1] + next((int)(2.0*l[1])+1);
+    double m3 = (kind == ClebschGordanKind) ? m1+m2 : -m1-m2;
+    if (i%8 == 1) m3 += 1.0;
+    args.push_back(l[0]); args.push_back(l[1]); args.push_back(l[2]);
+    args.push_back(m1); args.push_back(m2); args.push_back(m3);
+  }
+  return args;
+}
+
+static double direct(uint32_t kind, const double* a)
+{
+  // The scalar functions do not check that l+m is an integer.
+  if (kind != Wigner6jKind)
+    for (int k=0;k<3;k++)
+      if (std::floor(a[k]+a[k+3]) != a[k]+a[k+3]) return 0.0;
+  if (kind == Wigner3jKind) return wigner3j(a[0],a[1],a[2],a[3],a[4],a[5]);
+  if (kind == Wigner6jKind) return wigner6j(a[0],a[1],a[2],a[3],a[4],a[5]);
+  if (std::fabs(a[3]+a[4]-a[5]) > 0.0) return 0.0;
+  return clebschGordan(a[0],a[1],a[2],a[3],a[4],a[5]);
+}
+
+static int check(CoefficientClient& client, uint32_t kind, int lmax, unsigned int seed)
+{
+  std::vector<double> args = arguments(kind,lmax,seed), values;
+  if (!client.evaluate(kind,args,values) || values.size() != args.size()/6) return 1;
+
+  int failures = 0;
+  for (std::size_t i=0;i<values.size();i++)
+  {
+    double expected = direct(kind,&args[6*i]);
+    if (std::fabs(values[i]-expected) > 1.0e-12*std::max(1.0,std::fabs(expected))) failures++;
+  }
+  return failures;
+}
+
+int main()
+{
+  int failures = 0;
+
+  CoefficientServerOptions options;
+  options.socketPath    = "/tmp/testCoefficientServer." + std::to_string(getpid()) + ".sock";
+  options.lmax          = 100;
+  options.cacheFamilies = 256;
+  options.precompute3j  = 4;
+  options.precompute6j  = 3;
+
+  CoefficientServer server(options);
+  std::string error;
+  if (!server.start(&error))
+  {
+    std::cout << error << std::endl;
+    return 1;
+  }
+
+  // One client, then several at once.
+  {
+    CoefficientClient client;
+    if (!client.connect(options.socketPath,&error)) { std::cout << error << std::endl; return 1; }
+    failures += check(client,Wigner3jKind,12,1);
+    failures += check(client,Wigner6jKind,8,2);
+    failures += check(client,ClebschGordanKind,12,3);
+
+    // An empty request is answered.
+    std::vector<double> none, values;
+    if (!client.evaluate(Wigner3jKind,none,values) || !values.empty()) failures++;
+  }
+
+  std::atomic<int> threadFailures(0);
+  std::vector<std::thread> threads;
+  for (int t=0;t<8;t++)
+    threads.push_back(std::thread([&,t]()
+    {
+      CoefficientClient client;
+      if (!client.connect(options.socketPath)) { threadFailures++; return; }
+      for (int r=0;r<4;r++)
+        threadFailures += check(client,(uint32_t)(1+(t+r)%3),10,100*t+r);
+    }));
+  for (auto& thread : threads) thread.join();
+  failures += threadFailures;
+
+  // A request with a wrong kind is rejected and the connection closed.
+  {
+    int fd = socket(AF_UNIX,SOCK_STREAM,0);
+    sockaddr_un address;
+    std::memset(&address,0,sizeof(address));
+    address.sun_family = AF_UNIX;
+    std::strcpy(address.sun_path,options.socketPath.c_str());
+    if (connect(fd,reinterpret_cast<sockaddr*>(&address),sizeof(address)) != 0) failures++;
+    CoefficientRequestHeader request = {coefficientRequestMagic,7,1};
+    if (send(fd,&request,sizeof(request),MSG_NOSIGNAL) != (ssize_t)sizeof(request)) failures++;
+    CoefficientReplyHeader reply;
+    if (recv(fd,&reply,sizeof(reply),MSG_WAITALL) != (ssize_t)sizeof(reply)) failures++;
+    if (reply.magic != coefficientReplyMagic || reply.status != CoefficientBadRequest) failures++;
+    char byte;
+    if (recv(fd,&byte,1,0) != 0) failures++;
+    close(fd);
+  }
+
+  // Arguments above lmax are rejected, also when their sums overflow 32
+  // bits, and the server keeps answering the other connections.
+  {
+    int32_t large[6]    = {400000000,200000000,200000000,0,0,0};
+    int32_t overflow[6] = {2147483647,2147483647,2147483647,1,1,-2};
+    double value;
+    CoefficientClient first, second, third;
+    if (!first.connect(options.socketPath) || first.evaluate(Wigner3jKind,large,1,&value)) failures++;
+    if (!second.connect(options.socketPath) || second.evaluate(Wigner6jKind,overflow,1,&value)) failures++;
+    if (!third.connect(options.socketPath)) failures++;
+    failures += check(third,Wigner3jKind,12,4);
+  }
+
+  CoefficientServerStats stats = server.stats();
+  if (stats.connections != 13 || stats.pinned == 0 || stats.hits == 0 || stats.misses == 0) failures++;
+  if (stats.families > stats.pinned + 256) failures++;
+
+  server.stop();
+  if (access(options.socketPath.c_str(),F_OK) == 0) failures++;
+
+  // The server cannot listen on a path that does not fit in a socket address.
+  CoefficientServerOptions invalid;
+  invalid.socketPath = std::string(200,'x');
+  CoefficientServer other(invalid);
+  if (other.start(&error) || error.empty()) failures++;
+
+  std::cout << "Coefficient server: " << stats.symbols << " symbols, " << stats.hits << " hits, "
+            << stats.misses << " misses, " << stats.pinned << " precomputed families; "
+            << failures << " mismatches." << std::endl;
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,111 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html               -/
+ ********************************************************/
+
+/*! \file testFamilyColumns.cpp
+ *  \author Joey Dumont <joey.dumont@gmail.com>
+ *  \since 2026-10-18
+ *  \brief Tests the families along each column of the 3j and 6j symbols.
+ *  \copyright LGPL
+ * Each entry of wigner3j_family() and wigner6j_family() must match the
+ * symbol computed by the Fortran implementation with the same arguments,
+ * in the caller's ordering.
+ */
+
+#include <wignerSymbols.h>
+
+int main()
+{
+  int failures = 0;
+  WignerSymbols::RecursionMode modes[] = {
+    WignerSymbols::SchultenGordonScaled,
+    WignerSymbols::LuscombeLuban,
+  };
+
+  // 3j families along l1, l2 and l3.
+  for (int l1=0;l1<=8;l1++)
+    for (int l2=0;l2<=8;l2++)
+      for (int l3=std::abs(l1-l2);l3<=l1+l2;l3++)
+        for (int m1=-l1;m1<=l1;m1++)
+          for (int m2=-l2;m2<=l2;m2++)
+          {
+            int m3 = -m1-m2;
+            if (std::abs(m3) > l3) continue;
+            double l[3] = {(double)l1,(double)l2,(double)l3};
+            double m[3] = {(double)m1,(double)m2,(double)m3};
+
+            for (int v=0;v<3;v++)
+            {
+              double la = l[(v+1)%3], lb = l[(v+2)%3];
+              double lmin = std::max(std::fabs(la-lb),std::fabs(m[v]));
+              std::vector<double> family = WignerSymbols::wigner3j_family(v+1,l1,l2,l3,m1,m2,m3);
+              if ((int)family.size() != (int)(la+lb-lmin)+1) { failures++; continue; }
+
+              for (size_t i=0;i<family.size();i++)
+              {
+                double a[3] = {l[0],l[1],l[2]};
+                a[v] = lmin+i;
+                double ref = WignerSymbols::wigner3j_f(a[0],a[1],a[2],m1,m2,m3);
+                if (std::fabs(family[i]-ref) > 1.0e-13) failures++;
+              }
+
+              for (size_t k=0;k<sizeof(modes)/sizeof(modes[0]);k++)
+              {
+                std::vector<double> other = WignerSymbols::wigner3j_family(v+1,l1,l2,l3,m1,m2,m3,modes[k]);
+                if (other.size() != family.size()) { failures++; continue; }
+                for (size_t i=0;i<family.size();i++)
+                  if (std::fabs(other[i]-family[i]) > 1.0e-13) failures++;
+              }
+            }
+          }
+
+  // 6j families along each of the six entries. The triads of each entry are
+  // {l1 l2 l3}, {l1 l5 l6}, {l4 l2 l6} and {l4 l5 l3}.
+  int triads[6][2][2] = {
+    {{1,2},{4,5}}, {{0,2},{3,5}}, {{0,1},{3,4}},
+    {{1,5},{4,2}}, {{0,5},{3,2}}, {{0,4},{3,1}},
+  };
+  for (int l1=0;l1<=5;l1++)
+    for (int l2=0;l2<=5;l2++)
+      for (int l3=std::abs(l1-l2);l3<=l1+l2;l3++)
+        for (int l4=0;l4<=5;l4++)
+          for (int l5=std::abs(l4-l3);l5<=l4+l3;l5++)
+            for (int l6=std::max(std::abs(l1-l5),std::abs(l4-l2));l6<=std::min(l1+l5,l4+l2);l6++)
+            {
+              double l[6] = {(double)l1,(double)l2,(double)l3,(double)l4,(double)l5,(double)l6};
+              for (int v=0;v<6;v++)
+              {
+                double a0 = l[triads[v][0][0]], a1 = l[triads[v][0][1]];
+                double b0 = l[triads[v][1][0]], b1 = l[triads[v][1][1]];
+                double lmin = std::max(std::fabs(a0-a1),std::fabs(b0-b1));
+                double lmax = std::min(a0+a1,b0+b1);
+                std::vector<double> family = WignerSymbols::wigner6j_family(v+1,l1,l2,l3,l4,l5,l6);
+                if ((int)family.size() != (int)(lmax-lmin)+1) { failures++; continue; }
+
+                for (size_t i=0;i<family.size();i++)
+                {
+                  double a[6] = {l[0],l[1],l[2],l[3],l[4],l[5]};
+                  a[v] = lmin+i;
+                  double ref = WignerSymbols::wigner6j_f(a[0],a[1],a[2],a[3],a[4],a[5]);
+                  if (std::fabs(family[i]-ref) > 1.0e-13) failures++;
+                }
+
+                for (size_t k=0;k<sizeof(modes)/sizeof(modes[0]);k++)
+                {
+                  std::vector<double> other = WignerSymbols::wigner6j_family(v+1,l1,l2,l3,l4,l5,l6,modes[k]);
+                  if (other.size() != family.size()) { failures++; continue; }
+                  for (size_t i=0;i<family.size();i++)
+                    if (std::fabs(other[i]-family[i]) > 1.0e-13) failures++;
+                }
+              }
+            }
+
+  if (!WignerSymbols::wigner3j_family(0,1,1,1,0,0,0).empty()) failures++;
+  if (!WignerSymbols::wigner6j_family(7,1,1,1,1,1,1).empty()) failures++;
+
+  std::cout << "Family columns: " << failures << " mismatches." << std::endl;
+  return (failures == 0 ? 0 : 1);
+}
@@ -0,0 +1,77 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html               -/
+ ********************************************************/
+
+/*! \file testFamilyWalker.cpp
+ *  \author Joey Dumont <joey.dumont@gmail.com>
+ *  \since 2026-10-18
+ *  \brief Tests the walk of 3j families along diagonals of projections.
+ *  \copyright LGPL
+ * At every step of full diagonals, with integer and half-integer momenta,
+ * the family of the walker must match wigner3j(). The walk must stop at
+ * the end of the diagonal.
+ */
+
+#include <wignerSymbols.h>
+
+using namespace WignerSymbols;
+
+/*! Walks the whole diagonal of m1 from m2 = l2, and returns the largest
+ * error relative to the largest symbol of each family. */
+static double walk(double l2, double l3, double m1, std::size_t& steps, std::size_t& reseeds)
+{
+  double m2 = l2, m3 = -m1-m2;
+  while (m3 < -l3) { m2 -= 1.0; m3 += 1.0; }
+  Wigner3jWalker w = wigner3jWalker(l2,l3,m2,m3);
+
+  double worst = 0.0;
+  for (;;)
+  {
+    std::vector<double> expected = wigner3j(l2,l3,w.m1,w.m2,w.m3,SchultenGordonScaled);
+    if (expected.size() != w.values.size()) return 1.0;
+    double scale = 0.0, error = 0.0;
+    for (std::size_t i=0;i<expected.size();i++)
+    {
+      scale = std::max(scale,std::fabs(expected[i]));
+      error = std::max(error,std::fabs(w.values[i]-expected[i]));
+    }
+    worst = std::max(worst,error/scale);
+    if (!step(w)) break;
+  }
+  // The walk ends where one of the projections would leave its range.
+  if (w.m2-1.0 >= -l2 && w.m3+1.0 <= l3) return 1.0;
+  steps   += w.steps;
+  reseeds += w.reseeds;
+  return worst;
+}
+
+int main()
+{
+  int failures = 0;
+  std::size_t steps = 0, reseeds = 0;
+  double worst = 0.0;
+
+  for (int l2=0;l2<=12;l2++)
+    for (int l3=0;l3<=12;l3++)
+      for (int m1=-(l2+l3);m1<=l2+l3;m1++)
+        worst = std::max(worst,walk(l2,l3,m1,steps,reseeds));
+
+  double half[][3] = {{2.5,3.5,1.0}, {7.5,4,-0.5}, {5.5,5.5,0.0}};
+  for (int k=0;k<3;k++) worst = std::max(worst,walk(half[k][0],half[k][1],half[k][2],steps,reseeds));
+
+  double large[][3] = {{100,80,0}, {150,150,3}, {200,120,-40}};
+  for (int k=0;k<3;k++) worst = std::max(worst,walk(large[k][0],large[k][1],large[k][2],steps,reseeds));
+
+  if (worst > 1.0e-8) failures++;
+
+  // Projections outside their range give an empty walker.
+  Wigner3jWalker empty = wigner3jWalker(2,3,3,0);
+  if (!empty.values.empty() || step(empty)) failures++;
+
+  std::cout << "Family walker: " << steps << " steps, " << reseeds << " reseeds, largest error "
+            << worst << "; " << failures << " failures." << std::endl;
+  return failures == 0 ? 0 : 1;
+}
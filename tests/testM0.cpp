@@ -0,0 +1,58 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html               -/
+ ********************************************************/
+
+/*! \file testM0.cpp
+ *  \author Joey Dumont <joey.dumont@gmail.com>
+ *  \since 2026-10-18
+ *  \brief Tests the family of 3j symbols with vanishing projections.
+ *  \copyright LGPL
+ * The compact family must match the even-parity entries of the Fortran
+ * family, the odd-parity entries must vanish exactly, and the default entry
+ * points must route to it.
+ */
+
+#include <wignerSymbols.h>
+
+int main()
+{
+  int failures = 0;
+
+  for (int l2=0;l2<=40;l2++)
+    for (int l3=0;l3<=40;l3++)
+    {
+      std::vector<double> compact = WignerSymbols::wigner3j_m0(l2,l3);
+      std::vector<double> full    = WignerSymbols::wigner3j(l2,l3,0,0,0);
+      std::vector<double> fortran = WignerSymbols::wigner3j_f(l2,l3,0,0,0);
+
+      if (compact.size() != (size_t)std::min(l2,l3)+1 || full.size() != fortran.size()) { failures++; continue; }
+
+      for (size_t i=0;i<fortran.size();i++)
+      {
+        double l1 = std::abs(l2-l3)+i;
+        if (i%2 == 0 && std::fabs(compact[i/2]-fortran[i]) > 1.0e-14) failures++;
+        if (i%2 == 1 && full[i] != 0.0) failures++;
+        if (std::fabs(full[i]-fortran[i]) > 1.0e-14) failures++;
+        if (std::fabs(WignerSymbols::wigner3j(l1,l2,l3,0,0,0)-fortran[i]) > 1.0e-14) failures++;
+      }
+    }
+
+  // Large families, against the general recursion.
+  double large[][2] = {{5000, 3000}, {20000, 20000}};
+  for (size_t n=0;n<sizeof(large)/sizeof(large[0]);n++)
+  {
+    double l2 = large[n][0], l3 = large[n][1];
+    std::vector<double> compact = WignerSymbols::wigner3j_m0(l2,l3);
+    std::vector<double> scaled  = WignerSymbols::wigner3j(l2,l3,0,0,0,WignerSymbols::SchultenGordonScaled);
+    for (size_t k=0;k<compact.size();k++)
+      if (std::fabs(compact[k]-scaled[2*k]) > 1.0e-13) failures++;
+  }
+
+  if (!WignerSymbols::wigner3j_m0(1.5,2.5).empty()) failures++;
+
+  std::cout << "m=0 family: " << failures << " mismatches." << std::endl;
+  return (failures == 0 ? 0 : 1);
+}
@@ -0,0 +1,62 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html               -/
+ ********************************************************/
+
+/*! \file testMEnumerators.cpp
+ *  \author Joey Dumont <joey.dumont@gmail.com>
+ *  \since 2026-10-18
+ *  \brief Tests the enumeration of the allowed projections of 3j symbols.
+ *  \copyright LGPL
+ * Each allowed (m1,m2) must be visited once, with the symbol computed by
+ * the Fortran implementation. The enumerated terms must satisfy the
+ * orthogonality relation and the sum rule over m2 of Brink and Satchler.
+ */
+
+#include <wignerSymbols.h>
+
+int main()
+{
+  int failures = 0;
+
+  for (int l1=0;l1<=8;l1++)
+    for (int l2=0;l2<=8;l2++)
+      for (int l3=std::abs(l1-l2);l3<=l1+l2;l3++)
+        for (int m3=-l3;m3<=l3;m3++)
+        {
+          int expected = 0;
+          for (int m1=-l1;m1<=l1;m1++)
+            if (std::abs(m1+m3) <= l2) expected++;
+
+          int visited = 0;
+          double norm = 0.0, sumM2 = 0.0;
+          WignerSymbols::forEachWigner3jM(l1,l2,l3,m3,[&](double m1, double m2, double value)
+          {
+            visited++;
+            if (std::fabs(m1+m2+m3) > 0.0 || std::fabs(m1) > l1 || std::fabs(m2) > l2) failures++;
+            if (std::fabs(value-WignerSymbols::wigner3j_f(l1,l2,l3,m1,m2,m3)) > 1.0e-13) failures++;
+            norm  += (2.0*l3+1.0)*value*value;
+            sumM2 += m2*(2.0*l3+1.0)*value*value;
+          });
+          if (visited != expected) failures++;
+
+          // sum_{m1,m2} (2l3+1)(l1 l2 l3; m1 m2 m3)^2 = 1, and
+          // sum_{m1,m2} m2 (2l3+1)(l1 l2 l3; m1 m2 m3)^2 = -m3(l3(l3+1)+l2(l2+1)-l1(l1+1))/(2l3(l3+1)).
+          if (std::fabs(norm-1.0) > 1.0e-12) failures++;
+          if (l3 > 0 && std::fabs(sumM2+m3*(l3*(l3+1.0)+l2*(l2+1.0)-l1*(l1+1.0))/(2.0*l3*(l3+1.0))) > 1.0e-12) failures++;
+        }
+
+  // Forbidden triads have no terms.
+  if (WignerSymbols::wigner3jMTerms(1,1,3,0).size() != 0) failures++;
+  if (WignerSymbols::wigner3jMTerms(1,1,1,2).size() != 0) failures++;
+
+  // All the projections of (2 3 4).
+  int count = 0;
+  WignerSymbols::forEachWigner3jM(2,3,4,[&](double, double, double, double) { count++; });
+  if (count != 5*7-2) failures++;
+
+  std::cout << "M enumerators: " << failures << " mismatches." << std::endl;
+  return (failures == 0 ? 0 : 1);
+}
@@ -0,0 +1,76 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html               -/
+ ********************************************************/
+
+/*! \file testPlans.cpp
+ *  \author Joey Dumont <joey.dumont@gmail.com>
+ *  \since 2026-10-18
+ *  \brief Tests the families computed with coefficient plans.
+ *  \copyright LGPL
+ * The families of all the projections of a 3j plan, and of all the l4 of a
+ * 6j plan, must match the family functions, in every tabulated mode. One
+ * large 3j plan takes the split path.
+ */
+
+#include <wignerSymbols.h>
+
+double maxDiff(const std::vector<double>& a, const std::vector<double>& b)
+{
+  if (a.size() != b.size()) return 1.0;
+
+  double diff = 0.0;
+  for (size_t i=0;i<a.size();i++)
+    diff = std::max(diff, std::fabs(a[i]-b[i]));
+  return diff;
+}
+
+int main()
+{
+  int failures = 0;
+  WignerSymbols::RecursionMode modes[] = {
+    WignerSymbols::SchultenGordonScaled,
+    WignerSymbols::LuscombeLuban,
+  };
+
+  for (int l2=0;l2<=12;l2++)
+    for (int l3=0;l3<=12;l3++)
+    {
+      WignerSymbols::Wigner3jPlan plan = WignerSymbols::wigner3jPlan(l2,l3);
+      for (int m2=-l2;m2<=l2;m2++)
+        for (int m3=-l3;m3<=l3;m3++)
+          for (size_t k=0;k<2;k++)
+          {
+            std::vector<double> ref = WignerSymbols::wigner3j(l2,l3,-m2-m3,m2,m3,modes[k]);
+            if (maxDiff(WignerSymbols::wigner3j(plan,-m2-m3,m2,m3,modes[k]),ref) > 1.0e-13) failures++;
+          }
+      if (WignerSymbols::wigner3j(plan,1.0,0.0,0.0) != std::vector<double>(1,0.0)) failures++;
+    }
+
+  for (int l2=0;l2<=6;l2++)
+    for (int l3=0;l3<=6;l3++)
+      for (int l5=0;l5<=6;l5++)
+        for (int l6=0;l6<=6;l6++)
+        {
+          WignerSymbols::Wigner6jPlan plan = WignerSymbols::wigner6jPlan(l2,l3,l5,l6);
+          for (int l4=0;l4<=8;l4++)
+            for (size_t k=0;k<2;k++)
+            {
+              std::vector<double> ref = WignerSymbols::wigner6j(l2,l3,l4,l5,l6,modes[k]);
+              if (maxDiff(WignerSymbols::wigner6j(plan,l4,modes[k]),ref) > 1.0e-13) failures++;
+            }
+        }
+
+  // A long family, split between two threads.
+  int threshold = WignerSymbols::splitRecursionThreshold();
+  WignerSymbols::setSplitRecursionThreshold(256);
+  WignerSymbols::Wigner3jPlan large = WignerSymbols::wigner3jPlan(700,650);
+  std::vector<double> ref = WignerSymbols::wigner3j_f(700,650,-40,25,15);
+  if (maxDiff(WignerSymbols::wigner3j(large,-40,25,15),ref) > 1.0e-13) failures++;
+  WignerSymbols::setSplitRecursionThreshold(threshold);
+
+  std::cout << "Plans: " << failures << " mismatches." << std::endl;
+  return (failures == 0 ? 0 : 1);
+}
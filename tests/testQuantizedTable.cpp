@@ -0,0 +1,87 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html               -/
+ ********************************************************/
+
+/*! \file testQuantizedTable.cpp
+ *  \author Joey Dumont <joey.dumont@gmail.com>
+ *  \since 2026-10-18
+ *  \brief Tests the tables stored in reduced precision.
+ *  \copyright LGPL
+ * In every storage mode, each symbol of a 3j and a 6j table must lie within
+ * the error bound of the mode, and the recorded error must not exceed it.
+ * The lookups, the dequantized families and the gathers must agree, and a
+ * table stored as it is computed must match the quantized double table.
+ */
+
+#include <wignerSymbols.h>
+
+#include <random>
+
+static int check(const std::vector<double>& table, const std::vector<std::size_t>& offsets,
+                 const WignerSymbols::QuantizedTable& q, const WignerSymbols::QuantizedTable& built)
+{
+  int failures = 0;
+  double bound = WignerSymbols::storageErrorBound(q.storage);
+  if (q.maxError > bound || built.maxError != q.maxError || built.bytes() != q.bytes()) failures++;
+  if (q.storage != WignerSymbols::DoubleStorage && q.maxError == 0.0) failures++;
+
+  std::vector<double> f;
+  for (std::size_t k=0;k<q.families();k++)
+  {
+    std::size_t n = offsets[k+1]-offsets[k];
+    double largest = 0.0;
+    for (std::size_t i=0;i<n;i++) largest = std::max(largest,std::fabs(table[offsets[k]+i]));
+
+    f.resize(n);
+    q.family(k,f.data());
+    for (std::size_t i=0;i<n;i++)
+    {
+      if (std::fabs(f[i]-table[offsets[k]+i]) > bound*largest) failures++;
+      if (f[i] != q(k,i) || f[i] != built(k,i)) failures++;
+    }
+  }
+
+  std::mt19937 rng(3);
+  std::size_t count = 10000;
+  std::vector<std::size_t> family(count);
+  std::vector<int> index(count);
+  std::vector<double> out(count);
+  for (std::size_t j=0;j<count;j++)
+  {
+    family[j] = rng() % q.families();
+    index[j]  = rng() % (offsets[family[j]+1]-offsets[family[j]]);
+  }
+  q.gather(family.data(),index.data(),count,out.data());
+  for (std::size_t j=0;j<count;j++)
+    if (out[j] != q(family[j],index[j])) failures++;
+
+  return failures;
+}
+
+int main()
+{
+  int failures = 0;
+  WignerSymbols::TableStorage modes[] = {
+    WignerSymbols::DoubleStorage, WignerSymbols::Float32Storage, WignerSymbols::Fixed16Storage,
+  };
+
+  std::vector<WignerSymbols::Wigner3jFamily> families3j = WignerSymbols::wigner3jFamilies(12);
+  std::vector<WignerSymbols::Wigner6jFamily> families6j = WignerSymbols::wigner6jFamilies(6);
+  std::vector<std::size_t> offsets3j, offsets6j;
+  std::vector<double> table3j = WignerSymbols::wigner3jTable(families3j,offsets3j,1);
+  std::vector<double> table6j = WignerSymbols::wigner6jTable(families6j,offsets6j,1);
+
+  for (int s=0;s<3;s++)
+  {
+    failures += check(table3j,offsets3j,WignerSymbols::quantizeTable(table3j,offsets3j,modes[s]),
+                      WignerSymbols::wigner3jQuantizedTable(families3j,modes[s],2));
+    failures += check(table6j,offsets6j,WignerSymbols::quantizeTable(table6j,offsets6j,modes[s]),
+                      WignerSymbols::wigner6jQuantizedTable(families6j,modes[s],2));
+  }
+
+  std::cout << "Quantized tables: " << failures << " mismatches." << std::endl;
+  return (failures == 0 ? 0 : 1);
+}
@@ -0,0 +1,66 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html               -/
+ ********************************************************/
+
+/*! \file testRecoupling.cpp
+ *  \author Joey Dumont <joey.dumont@gmail.com>
+ *  \since 2026-10-18
+ *  \brief Tests the recoupling matrices of three angular momenta.
+ *  \copyright LGPL
+ * The elements must match the scalar 6j symbols, the matrices must be
+ * orthogonal, and the parallel builder must reproduce the serial one.
+ */
+
+#include <wignerSymbols.h>
+
+int main()
+{
+  int failures = 0;
+
+  double triples[][3] = {{0.5, 0.5, 0.5}, {1.0, 2.0, 3.0}, {3.5, 2.5, 4.5}, {6.0, 5.0, 7.0}, {12.5, 9.0, 10.5}};
+  for (size_t n=0;n<sizeof(triples)/sizeof(triples[0]);n++)
+  {
+    double j1 = triples[n][0], j2 = triples[n][1], j3 = triples[n][2];
+    std::vector<WignerSymbols::RecouplingMatrix> blocks = WignerSymbols::recouplingMatrices(j1,j2,j3,4);
+    std::vector<WignerSymbols::RecouplingMatrix> serial = WignerSymbols::recouplingMatrices(j1,j2,j3,1);
+    if (blocks.empty() || blocks.size() != serial.size()) { failures++; continue; }
+
+    // The dimensions of the blocks add up to (2j1+1)(2j2+1)(2j3+1).
+    double dimension = 0.0;
+    for (size_t b=0;b<blocks.size();b++)
+    {
+      const WignerSymbols::RecouplingMatrix& m = blocks[b];
+      if (m.rows != m.cols || m.data != serial[b].data) failures++;
+      dimension += m.rows*(2.0*m.J+1.0);
+
+      double phase = ((long)(j1+j2+j3+m.J)%2 ? -1.0 : 1.0);
+      for (int r=0;r<m.rows;r++)
+        for (int c=0;c<m.cols;c++)
+        {
+          double j12 = m.j12min+r, j23 = m.j23min+c;
+          double ref = phase*std::sqrt((2.0*j12+1.0)*(2.0*j23+1.0))*WignerSymbols::wigner6j(j1,j2,j12,j3,m.J,j23);
+          if (std::fabs(m(r,c)-ref) > 1.0e-13) failures++;
+
+          // Orthogonality of the rows.
+          for (int s=0;s<m.rows;s++)
+          {
+            double dot = 0.0;
+            for (int k=0;k<m.cols;k++)
+              dot += m(r,k)*m(s,k);
+            if (c == 0 && std::fabs(dot-(r == s ? 1.0 : 0.0)) > 1.0e-13) failures++;
+          }
+        }
+    }
+    if (dimension != (2.0*j1+1.0)*(2.0*j2+1.0)*(2.0*j3+1.0)) failures++;
+  }
+
+  // Unreachable J.
+  if (WignerSymbols::recouplingMatrix(1.0,1.0,1.0,4.0).rows != 0) failures++;
+  if (WignerSymbols::recouplingMatrix(1.0,1.0,1.0,1.5).rows != 0) failures++;
+
+  std::cout << "Recoupling matrices: " << failures << " failures." << std::endl;
+  return (failures == 0 ? 0 : 1);
+}
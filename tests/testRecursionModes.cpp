@@ -0,0 +1,135 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html               -/
+ ********************************************************/
+
+/*! \file testRecursionModes.cpp
+ *  \author Joey Dumont <joey.dumont@gmail.com>
+ *  \since 2026-10-18
+ *  \brief Tests the recursion modes of the family functions.
+ *  \copyright LGPL
+ * The Scaled and Luscombe-Luban modes must reproduce the Fortran
+ * implementation, both for small families and for the large families of
+ * issues #1 and #2, where the coefficients span hundreds of orders of
+ * magnitude or underflow at the end of the family. The Luscombe-Luban
+ * families must also satisfy the orthogonality relations of the 3j and 6j
+ * symbols.
+ */
+
+#include <wignerSymbols.h>
+
+double maxDiff(const std::vector<double>& a, const std::vector<double>& b)
+{
+  if (a.size() != b.size()) return 1.0;
+
+  double diff = 0.0;
+  for (size_t i=0;i<a.size();i++)
+    diff = std::max(diff, std::fabs(a[i]-b[i]));
+  return diff;
+}
+
+int main()
+{
+  int failures = 0;
+  WignerSymbols::RecursionMode scaled = WignerSymbols::SchultenGordonScaled;
+  WignerSymbols::RecursionMode ratios = WignerSymbols::LuscombeLuban;
+
+  for (int l2=0;l2<=20;l2++)
+    for (int l3=0;l3<=20;l3++)
+      for (int m2=-l2;m2<=l2;m2+=2)
+        for (int m3=-l3;m3<=l3;m3+=3)
+        {
+          std::vector<double> ref = WignerSymbols::wigner3j_f(l2,l3,-m2-m3,m2,m3);
+          if (maxDiff(WignerSymbols::wigner3j(l2,l3,-m2-m3,m2,m3,scaled),ref) > 1.0e-13) failures++;
+          if (maxDiff(WignerSymbols::wigner3j(l2,l3,-m2-m3,m2,m3,ratios),ref) > 1.0e-13) failures++;
+        }
+
+  double large[][5] = {
+    { 999, 1221, -1179,  280,  899},
+    { 992, 1243,   196, -901,  705},
+    { 727, 1202,   533, -663,  130},
+    {1003,  978,   -32,  993, -961},
+    // The tail of the forbidden region underflows: the sign of the family
+    // must not be taken from the last coefficient.
+    {1476, 1443,   -67, 1371,-1304},
+    {1000, 1000,     0,  857, -857},
+  };
+  for (size_t n=0;n<sizeof(large)/sizeof(large[0]);n++)
+  {
+    double* p = large[n];
+    std::vector<double> ref = WignerSymbols::wigner3j_f(p[0],p[1],p[2],p[3],p[4]);
+    if (maxDiff(WignerSymbols::wigner3j(p[0],p[1],p[2],p[3],p[4],scaled),ref) > 1.0e-13) failures++;
+    if (maxDiff(WignerSymbols::wigner3j(p[0],p[1],p[2],p[3],p[4],ratios),ref) > 1.0e-13) failures++;
+  }
+
+  for (int l2=0;l2<=12;l2++)
+    for (int l3=0;l3<=12;l3++)
+      for (int l5=0;l5<=12;l5+=3)
+        for (int l6=0;l6<=12;l6+=2)
+        {
+          double l4 = 6.0;
+          if (l6 < std::fabs(l4-l2) || l6 > l4+l2 || l3 < std::fabs(l4-l5) || l3 > l4+l5) continue;
+          if (std::max(std::abs(l2-l3),std::abs(l5-l6)) > std::min(l2+l3,l5+l6)) continue;
+
+          std::vector<double> ref = WignerSymbols::wigner6j(l2,l3,l4,l5,l6);
+          if (maxDiff(WignerSymbols::wigner6j(l2,l3,l4,l5,l6,scaled),ref) > 1.0e-13) failures++;
+          if (maxDiff(WignerSymbols::wigner6j(l2,l3,l4,l5,l6,ratios),ref) > 1.0e-13) failures++;
+        }
+
+  // sum_{m2} (2l1+1) (l1 l2 l3; m1 m2 m3)(l1' l2 l3; m1 m2 m3) = delta(l1,l1').
+  double orthogonality3j[][3] = {{30, 25, 4}, {300, 250, -120}, {1000, 40, 17}};
+  for (int n=0;n<3;n++)
+  {
+    double l2 = orthogonality3j[n][0], l3 = orthogonality3j[n][1], m1 = orthogonality3j[n][2];
+    double l1min = std::max(std::fabs(l2-l3),std::fabs(m1));
+    int size = (int)(l2+l3-l1min+1.5);
+    std::vector<double> gram(size*size,0.0);
+
+    for (double m2=std::max(-l2,-l3-m1);m2<=std::min(l2,l3-m1);m2+=1.0)
+    {
+      std::vector<double> f = WignerSymbols::wigner3j(l2,l3,m1,m2,-m1-m2,ratios);
+      for (int i=0;i<size;i++)
+        for (int k=0;k<size;k++)
+          gram[i*size+k] += (2.0*(l1min+i)+1.0)*f[i]*f[k];
+    }
+
+    double err = 0.0;
+    for (int i=0;i<size;i++)
+      for (int k=0;k<size;k++)
+        err = std::max(err,std::fabs(gram[i*size+k]-(i==k ? 1.0 : 0.0)));
+    if (err > 1.0e-12) failures++;
+  }
+
+  // sum_{l1} (2l1+1)(2l4+1) {l1 l2 l3; l4 l5 l6}{l1 l2 l3; l4' l5 l6} = delta(l4,l4').
+  double orthogonality6j[][4] = {{20, 18, 15, 17}, {200, 180, 150, 170}};
+  for (int n=0;n<2;n++)
+  {
+    double l2 = orthogonality6j[n][0], l3 = orthogonality6j[n][1];
+    double l5 = orthogonality6j[n][2], l6 = orthogonality6j[n][3];
+    double l1min = std::max(std::fabs(l2-l3),std::fabs(l5-l6));
+    double l4min = std::max(std::fabs(l2-l6),std::fabs(l3-l5));
+    double l4max = std::min(l2+l6,l3+l5);
+    int size = (int)(std::min(l2+l3,l5+l6)-l1min+1.5);
+
+    std::vector<std::vector<double> > families;
+    for (double l4=l4min;l4<=l4max;l4+=1.0)
+      families.push_back(WignerSymbols::wigner6j(l2,l3,l4,l5,l6,ratios));
+
+    double err = 0.0;
+    for (size_t a=0;a<families.size();a++)
+      for (size_t b=0;b<families.size();b++)
+      {
+        double sum = 0.0;
+        for (int i=0;i<size;i++)
+          sum += (2.0*(l1min+i)+1.0)*families[a][i]*families[b][i];
+        sum *= std::sqrt((2.0*(l4min+a)+1.0)*(2.0*(l4min+b)+1.0));
+        err = std::max(err,std::fabs(sum-(a==b ? 1.0 : 0.0)));
+      }
+    if (err > 1.0e-12) failures++;
+  }
+
+  std::cout << "Recursion modes: " << failures << " mismatches." << std::endl;
+  return (failures == 0 ? 0 : 1);
+}
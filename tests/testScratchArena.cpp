@@ -0,0 +1,101 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html               -/
+ ********************************************************/
+
+/*! \file testScratchArena.cpp
+ *  \author Joey Dumont <joey.dumont@gmail.com>
+ *  \since 2026-10-18
+ *  \brief Tests that the scalar Fortran wrappers reuse the scratch arena.
+ *  \copyright LGPL
+ * We replace the global allocation functions by counting versions, warm the
+ * arena up with the largest family of the run, and verify that subsequent
+ * scalar calls do not allocate on the heap.
+ */
+
+#include <wignerSymbols.h>
+
+#include <cstdlib>
+#include <new>
+
+static unsigned long allocationCount = 0;
+
+void* operator new(std::size_t n)
+{
+  allocationCount++;
+  void* p = std::malloc(n > 0 ? n : 1);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+
+void* operator new[](std::size_t n)
+{
+  allocationCount++;
+  void* p = std::malloc(n > 0 ? n : 1);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+
+void operator delete(void* p) noexcept            { std::free(p); }
+void operator delete[](void* p) noexcept          { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept   { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+int main()
+{
+  int failures = 0;
+  WignerSymbols::ScratchArena& arena = WignerSymbols::ScratchArena::local();
+
+  // The arena values must agree with the vector-returning functions.
+  std::vector<double> ref3j = WignerSymbols::wigner3j_f(120.0, 80.0, 3.0, -10.0, 7.0);
+  double val3j = WignerSymbols::wigner3j_f(100.0, 120.0, 80.0, 3.0, -10.0, 7.0);
+  if (val3j != ref3j[100-40])
+  {
+    std::cout << "Scalar 3j differs from the family: " << val3j << " vs " << ref3j[60] << std::endl;
+    failures++;
+  }
+
+  // Warm-up with the largest families of the run.
+  WignerSymbols::wigner3j_f(200.0, 100.0, 100.0, 0.0, 0.0, 0.0);
+  WignerSymbols::wigner6j_f(100.0, 120.0, 80.0, 110.0, 90.0, 70.0);
+  std::size_t capacity = arena.capacity();
+
+  unsigned long before = allocationCount;
+  double sum = 0.0;
+  for (int l=0; l<80; l++)
+  {
+    for (int m=-l; m<=l; m+=7)
+    {
+      sum += WignerSymbols::wigner3j_f(120.0+l, 100.0, 20.0+l, m, -m, 0.0);
+      sum += WignerSymbols::clebschGordan_f(100.0, 20.0+l, 120.0+l, -m, m, 0.0);
+    }
+    sum += WignerSymbols::wigner6j_f(100.0, 120.0, 40.0+l, 110.0, 90.0, 70.0);
+  }
+  unsigned long steadyState = allocationCount-before;
+
+  std::cout << "Heap allocations in steady state: " << steadyState
+            << " (checksum " << sum << ")" << std::endl;
+  std::cout << "Arena high-water mark: " << arena.highWaterMark()
+            << " doubles, capacity: " << arena.capacity() << " doubles" << std::endl;
+
+  if (steadyState != 0)  failures++;
+  if (arena.capacity() != capacity) failures++;
+  if (arena.highWaterMark() > arena.capacity()) failures++;
+
+  // Trimming releases the storage, and the arena grows back on demand.
+  arena.trim();
+  arena.resetHighWaterMark();
+  if (arena.capacity() != 0 || arena.highWaterMark() != 0) failures++;
+
+  before = allocationCount;
+  WignerSymbols::wigner3j_f(100.0, 120.0, 80.0, 3.0, -10.0, 7.0);
+  if (allocationCount-before != 1) failures++;
+  if (arena.highWaterMark() != ref3j.size()) failures++;
+
+  arena.trim(10);
+  if (arena.capacity() != 10) failures++;
+
+  return (failures == 0 ? 0 : 1);
+}
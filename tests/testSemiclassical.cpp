@@ -0,0 +1,131 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html               -/
+ ********************************************************/
+
+/*! \file testSemiclassical.cpp
+ *  \author Joey Dumont <joey.dumont@gmail.com>
+ *  \since 2026-10-18
+ *  \brief Tests the semiclassical approximation against the recursion.
+ *  \copyright LGPL
+ * The error estimate must bound the actual error over whole families, also
+ * with projections at their bounds or nearly stretched triads, and a
+ * tolerance below the estimate must fall back to the exact recursion.
+ */
+
+#include <wignerSymbols.h>
+
+int main()
+{
+  int failures = 0;
+  WignerSymbols::RecursionMode scaled = WignerSymbols::SchultenGordonScaled;
+
+  // l2, l3, m2, m3 of 3j families with two soft turning points.
+  double families3j[][4] = {
+    {2000, 2000, 1000, -800},
+    {2000, 2000,    0, -800},
+    {2000, 1600,  400, -800},
+  };
+  for (size_t n=0;n<sizeof(families3j)/sizeof(families3j[0]);n++)
+  {
+    double l2 = families3j[n][0], l3 = families3j[n][1];
+    double m2 = families3j[n][2], m3 = families3j[n][3], m1 = -m2-m3;
+    std::vector<double> exact = WignerSymbols::wigner3j(l2,l3,m1,m2,m3,scaled);
+    double l1min = std::max(std::fabs(l2-l3),std::fabs(m1));
+
+    double maxError = 0.0;
+    for (size_t i=0;i<exact.size();i+=7)
+    {
+      double error;
+      double value = WignerSymbols::wigner3j_semiclassical(l1min+i,l2,l3,m1,m2,m3,1.0e-4,&error);
+      if (std::fabs(value-exact[i]) > std::max(error,1.0e-14)) failures++;
+      maxError = std::max(maxError,error);
+    }
+    if (maxError == 0.0 || maxError > 1.0e-4) failures++;
+
+    // A tolerance below the estimate must give the exact value.
+    size_t i = exact.size()/2;
+    double error;
+    double value = WignerSymbols::wigner3j_semiclassical(l1min+i,l2,l3,m1,m2,m3,1.0e-12,&error);
+    if (error != 0.0 || std::fabs(value-exact[i]) > 1.0e-14) failures++;
+  }
+
+  // l2, l3, m2, m3 of 3j families with a projection at or near its bound,
+  // where the approximation degrades faster than the error estimate. The
+  // accepted values must still lie within the tolerance.
+  double stretched3j[][4] = {
+    {1599,  661, -878, -661},
+    {2000, 1600, 2000, -800},
+    {2000, 1600, 1990, -1597},
+    {1670, 1676, -1654, 1628},
+    {2989,   70, -2954,  34},
+  };
+  for (size_t n=0;n<sizeof(stretched3j)/sizeof(stretched3j[0]);n++)
+  {
+    double l2 = stretched3j[n][0], l3 = stretched3j[n][1];
+    double m2 = stretched3j[n][2], m3 = stretched3j[n][3], m1 = -m2-m3;
+    std::vector<double> exact = WignerSymbols::wigner3j(l2,l3,m1,m2,m3,scaled);
+    double l1min = std::max(std::fabs(l2-l3),std::fabs(m1));
+
+    for (size_t i=0;i<exact.size();i+=3)
+    {
+      double error;
+      double value = WignerSymbols::wigner3j_semiclassical(l1min+i,l2,l3,m1,m2,m3,1.0e-6,&error);
+      if (std::fabs(value-exact[i]) > 1.0e-6 || std::fabs(value-exact[i]) > std::max(error,1.0e-14)) failures++;
+    }
+  }
+
+  // l2, l3, l4, l5, l6 of 6j families.
+  double families6j[][5] = {
+    {1000, 1200, 900, 800, 1100},
+    { 500, 1000, 700, 600,  900},
+  };
+  for (size_t n=0;n<sizeof(families6j)/sizeof(families6j[0]);n++)
+  {
+    double* p = families6j[n];
+    std::vector<double> exact = WignerSymbols::wigner6j(p[0],p[1],p[2],p[3],p[4],scaled);
+    double l1min = std::max(std::fabs(p[0]-p[1]),std::fabs(p[3]-p[4]));
+
+    double maxError = 0.0;
+    for (size_t i=0;i<exact.size();i+=5)
+    {
+      double error;
+      double value = WignerSymbols::wigner6j_semiclassical(l1min+i,p[0],p[1],p[2],p[3],p[4],1.0e-4,&error);
+      if (std::fabs(value-exact[i]) > std::max(error,1.0e-14)) failures++;
+      maxError = std::max(maxError,error);
+    }
+    if (maxError == 0.0) failures++;
+  }
+
+  // l1, l2, l3, l4, l5, l6 of 6j symbols whose error exceeded the estimate,
+  // most with a small l4 and hence nearly stretched triads.
+  double stretched6j[][6] = {
+    { 710,  884, 1006,   4, 1005,  886},
+    { 769,  884, 1006,   4, 1005,  886},
+    {1310, 1474, 1133,  16, 1119, 1466},
+    {1515, 1661,  784,   8,  787, 1669},
+    {1422, 1435,  231,   1,  231, 1434},
+    { 803, 1515, 1484,  62, 1464, 1518},
+    {1042, 1902, 1873, 488, 2208, 2282},
+  };
+  for (size_t n=0;n<sizeof(stretched6j)/sizeof(stretched6j[0]);n++)
+  {
+    double* p = stretched6j[n];
+    std::vector<double> exact = WignerSymbols::wigner6j(p[1],p[2],p[3],p[4],p[5],scaled);
+    double l1min = std::max(std::fabs(p[1]-p[2]),std::fabs(p[4]-p[5]));
+
+    double error;
+    double value = WignerSymbols::wigner6j_semiclassical(p[0],p[1],p[2],p[3],p[4],p[5],1.0e-3,&error);
+    double actual = std::fabs(value-exact[(size_t)(p[0]-l1min)]);
+    if (actual > 1.0e-3 || actual > std::max(error,1.0e-14)) failures++;
+  }
+
+  // Selection rules.
+  if (WignerSymbols::wigner3j_semiclassical(10,20,40,0,0,0) != 0.0) failures++;
+  if (WignerSymbols::wigner6j_semiclassical(10,20,40,10,20,30) != 0.0) failures++;
+
+  std::cout << "Semiclassical approximation: " << failures << " failures." << std::endl;
+  return (failures == 0 ? 0 : 1);
+}
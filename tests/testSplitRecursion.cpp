@@ -0,0 +1,79 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html               -/
+ ********************************************************/
+
+/*! \file testSplitRecursion.cpp
+ *  \author Joey Dumont <joey.dumont@gmail.com>
+ *  \since 2026-10-18
+ *  \brief Tests the two-thread split of the recursion.
+ *  \copyright LGPL
+ * With the smallest threshold, every family of at least 16 symbols is
+ * split between two threads. The families must match the Fortran ones,
+ * whether the classically allowed region is in the middle, at one end, or
+ * absent, and for lengths up to 10^5.
+ */
+
+#include <wignerSymbols.h>
+
+double maxDiff(const std::vector<double>& a, const std::vector<double>& b)
+{
+  if (a.size() != b.size()) return 1.0;
+
+  double diff = 0.0;
+  for (size_t i=0;i<a.size();i++)
+    diff = std::max(diff, std::fabs(a[i]-b[i]));
+  return diff;
+}
+
+int main()
+{
+  int failures = 0;
+  WignerSymbols::RecursionMode scaled = WignerSymbols::SchultenGordonScaled;
+  WignerSymbols::setSplitRecursionThreshold(0);
+  if (WignerSymbols::splitRecursionThreshold() != 16) failures++;
+
+  for (int l2=8;l2<=40;l2+=3)
+    for (int l3=8;l3<=40;l3+=4)
+      for (int m2=-l2;m2<=l2;m2+=3)
+        for (int m3=-l3;m3<=l3;m3+=5)
+        {
+          std::vector<double> ref = WignerSymbols::wigner3j_f(l2,l3,-m2-m3,m2,m3);
+          if (maxDiff(WignerSymbols::wigner3j(l2,l3,-m2-m3,m2,m3,scaled),ref) > 1.0e-13) failures++;
+        }
+
+  for (int l2=10;l2<=30;l2+=4)
+    for (int l3=10;l3<=30;l3+=5)
+      for (int l5=10;l5<=30;l5+=6)
+        for (int l6=10;l6<=30;l6+=3)
+        {
+          double l4 = 12.0;
+          if (l6 < std::fabs(l4-l2) || l6 > l4+l2 || l3 < std::fabs(l4-l5) || l3 > l4+l5) continue;
+
+          std::vector<double> ref = WignerSymbols::wigner6j_f(l2,l3,l4,l5,l6);
+          if (maxDiff(WignerSymbols::wigner6j(l2,l3,l4,l5,l6,scaled),ref) > 1.0e-13) failures++;
+        }
+
+  // Long families, with the default threshold.
+  WignerSymbols::setSplitRecursionThreshold(8192);
+  double large[][5] = {
+    {1.0e4, 1.2e4,  -1800,  9000, -7200},
+    {3.0e4, 2.0e4, -39000, 21000, 18000},
+    {5.0e4, 5.0e4, -52500, 47500,  5000},
+    {1.0e5, 0.8e5,      0,  1000, -1000},
+  };
+  for (size_t n=0;n<sizeof(large)/sizeof(large[0]);n++)
+  {
+    double* p = large[n];
+    std::vector<double> ref = WignerSymbols::wigner3j_f(p[0],p[1],p[2],p[3],p[4]);
+    if (maxDiff(WignerSymbols::wigner3j(p[0],p[1],p[2],p[3],p[4],scaled),ref) > 1.0e-13) failures++;
+  }
+
+  std::vector<double> ref = WignerSymbols::wigner6j_f(2.0e4,1.8e4,1.5e4,1.9e4,2.1e4);
+  if (maxDiff(WignerSymbols::wigner6j(2.0e4,1.8e4,1.5e4,1.9e4,2.1e4,scaled),ref) > 1.0e-13) failures++;
+
+  std::cout << "Split recursion: " << failures << " mismatches." << std::endl;
+  return (failures == 0 ? 0 : 1);
+}
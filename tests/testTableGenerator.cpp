@@ -0,0 +1,58 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html               -/
+ ********************************************************/
+
+/*! \file testTableGenerator.cpp
+ *  \author Joey Dumont <joey.dumont@gmail.com>
+ *  \since 2026-10-18
+ *  \brief Tests the parallel table generator.
+ *  \copyright LGPL
+ * The tables computed with several threads must be identical to the
+ * families computed one by one, and every task must be executed once.
+ */
+
+#include <wignerSymbols.h>
+
+int main()
+{
+  int failures = 0;
+
+  std::vector<WignerSymbols::Wigner3jFamily> families3j = WignerSymbols::wigner3jFamilies(8);
+  std::vector<WignerSymbols::Wigner6jFamily> families6j = WignerSymbols::wigner6jFamilies(5);
+
+  for (unsigned int nthreads=1;nthreads<=8;nthreads*=2)
+  {
+    std::vector<std::size_t> offsets;
+    WignerSymbols::SchedulerStats stats;
+    std::vector<double> table = WignerSymbols::wigner3jTable(families3j, offsets, nthreads, &stats);
+
+    std::size_t tasks = 0;
+    for (std::size_t i=0;i<stats.workers.size();i++) tasks += stats.workers[i].tasks;
+    if (tasks != families3j.size() || stats.workers.size() != nthreads) failures++;
+
+    for (std::size_t k=0;k<families3j.size();k++)
+    {
+      const WignerSymbols::Wigner3jFamily& f = families3j[k];
+      std::vector<double> ref = WignerSymbols::wigner3j(f.l2,f.l3,f.m1,f.m2,f.m3);
+      if (ref.size() != offsets[k+1]-offsets[k]) { failures++; continue; }
+      for (std::size_t i=0;i<ref.size();i++)
+        if (ref[i] != table[offsets[k]+i]) failures++;
+    }
+
+    table = WignerSymbols::wigner6jTable(families6j, offsets, nthreads);
+    for (std::size_t k=0;k<families6j.size();k++)
+    {
+      const WignerSymbols::Wigner6jFamily& f = families6j[k];
+      std::vector<double> ref = WignerSymbols::wigner6j(f.l2,f.l3,f.l4,f.l5,f.l6);
+      if (ref.size() != offsets[k+1]-offsets[k]) { failures++; continue; }
+      for (std::size_t i=0;i<ref.size();i++)
+        if (ref[i] != table[offsets[k]+i]) failures++;
+    }
+  }
+
+  std::cout << "Table generation: " << failures << " mismatches." << std::endl;
+  return (failures == 0 ? 0 : 1);
+}
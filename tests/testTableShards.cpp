@@ -0,0 +1,101 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html               -/
+ ********************************************************/
+
+/*! \file testTableShards.cpp
+ *  \author Joey Dumont <joey.dumont@gmail.com>
+ *  \since 2026-10-18
+ *  \brief Tests the generation of tables in shards and their merging.
+ *  \copyright LGPL
+ * The shards of a partition, merged in any order, must hold the table
+ * computed in one piece. A missing or corrupted shard, or a shard of
+ * another partition, must be rejected.
+ */
+
+#include <wignerSymbols.h>
+
+#include <cstdio>
+
+static int compare(const WignerSymbols::TableShard& merged,
+                   const std::vector<double>& table, const std::vector<std::size_t>& offsets)
+{
+  int failures = 0;
+  if (merged.families()+1 != offsets.size() || merged.values != table) failures++;
+  for (std::size_t k=0;k<offsets.size() && k<merged.offsets.size();k++)
+    if (merged.offsets[k] != offsets[k]) failures++;
+  return failures;
+}
+
+int main()
+{
+  int failures = 0;
+  const int parts = 3;
+
+  // The ranges cover the tasks and have nearly equal costs.
+  std::vector<double> cost(100);
+  for (std::size_t k=0;k<cost.size();k++) cost[k] = k;
+  std::vector<std::size_t> bounds = WignerSymbols::partitionFamilies(cost,4);
+  if (bounds.size() != 5 || bounds[0] != 0 || bounds[4] != cost.size()) failures++;
+  for (int p=0;p<4 && !failures;p++)
+  {
+    double sum = 0.0;
+    for (std::size_t k=bounds[p];k<bounds[p+1];k++) sum += cost[k];
+    if (std::fabs(sum-4950.0/4) > 100.0) failures++;
+  }
+
+  for (int symbol=3;symbol<=6;symbol+=3)
+  {
+    int lmax = (symbol == 3 ? 10 : 5);
+    std::vector<std::string> paths;
+    for (int p=parts-1;p>=0;p--)
+    {
+      WignerSymbols::TableShard shard = (symbol == 3 ? WignerSymbols::wigner3jShard(lmax,p,parts,1)
+                                                     : WignerSymbols::wigner6jShard(lmax,p,parts,1));
+      if (shard.families() == 0) failures++;
+      paths.push_back("testTableShards.part"+std::to_string(p));
+      if (!WignerSymbols::writeTableShard(paths.back(),shard)) failures++;
+    }
+
+    std::vector<std::size_t> offsets;
+    std::vector<double> table = (symbol == 3 ? WignerSymbols::wigner3jTable(WignerSymbols::wigner3jFamilies(lmax),offsets,1)
+                                             : WignerSymbols::wigner6jTable(WignerSymbols::wigner6jFamilies(lmax),offsets,1));
+
+    WignerSymbols::ShardMergeStats stats = WignerSymbols::mergeTableShards(paths,"testTableShards.bin",1);
+    if (!stats.ok || stats.families != offsets.size()-1 || stats.verified != stats.families) failures++;
+
+    WignerSymbols::TableShard merged;
+    if (!WignerSymbols::readTableShard("testTableShards.bin",merged)) failures++;
+    failures += compare(merged,table,offsets);
+
+    // A missing shard.
+    std::vector<std::string> missing(paths.begin(),paths.end()-1);
+    if (WignerSymbols::mergeTableShards(missing,"testTableShards.bin").ok) failures++;
+
+    // A shard that covers the same families, but claims another partition.
+    WignerSymbols::TableShard other = (symbol == 3 ? WignerSymbols::wigner3jShard(lmax,0,parts,1)
+                                                   : WignerSymbols::wigner6jShard(lmax,0,parts,1));
+    other.parts = parts+1;
+    if (!WignerSymbols::writeTableShard("testTableShards.other",other)) failures++;
+    std::vector<std::string> mixed(paths.begin(),paths.end()-1);
+    mixed.push_back("testTableShards.other");
+    if (WignerSymbols::mergeTableShards(mixed,"testTableShards.bin").ok) failures++;
+    std::remove("testTableShards.other");
+
+    // A corrupted shard.
+    FILE* file = std::fopen(paths[1].c_str(),"r+b");
+    std::fseek(file,-8,SEEK_END);
+    double garbage = 0.5;
+    std::fwrite(&garbage,sizeof(double),1,file);
+    std::fclose(file);
+    if (WignerSymbols::mergeTableShards(paths,"testTableShards.bin").ok) failures++;
+
+    for (std::size_t p=0;p<paths.size();p++) std::remove(paths[p].c_str());
+    std::remove("testTableShards.bin");
+  }
+
+  if (failures > 0) std::cout << failures << " failures" << std::endl;
+  return failures > 0;
+}
@@ -0,0 +1,96 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html               -/
+ ********************************************************/
+
+/*! \file testTableWriter.cpp
+ *  \author Joey Dumont <joey.dumont@gmail.com>
+ *  \since 2026-10-18
+ *  \brief Tests the streaming writer of 3j tables.
+ *  \copyright LGPL
+ * A table written in small chunks must hold the families of
+ * wigner3jFamilies(), in order, with the symbols of the recursion. A run
+ * interrupted after a few families and resumed must hold the same
+ * families. A write error must stop the run.
+ */
+
+#include <wignerSymbols.h>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+static int check(const std::string& path, int lmax)
+{
+  std::vector<WignerSymbols::Wigner3jFamily> families = WignerSymbols::wigner3jFamilies(lmax);
+  std::size_t index = 0;
+  int failures = 0;
+
+  bool ok = WignerSymbols::readWigner3jTable(path,
+    [&](const WignerSymbols::Wigner3jFamily& f, const double* values, std::size_t size)
+    {
+      const WignerSymbols::Wigner3jFamily& g = families[index++];
+      if (f.l2 != g.l2 || f.l3 != g.l3 || f.m1 != g.m1 || f.m2 != g.m2 || f.m3 != g.m3) { failures++; return false; }
+
+      std::vector<double> thrcof = WignerSymbols::wigner3j_f(f.l2,f.l3,f.m1,f.m2,f.m3);
+      if (size != WignerSymbols::familySize(f)) failures++;
+      for (std::size_t k=0;k<size && k<thrcof.size();k++)
+        if (std::fabs(values[k]-thrcof[k]) > 1.0e-12) failures++;
+      return index < families.size();
+    });
+
+  if (!ok || index != families.size()) failures++;
+  return failures;
+}
+
+int main()
+{
+  int failures = 0, lmax = 12;
+  std::string path = "testTableWriter.bin", resumed = "testTableWriterResumed.bin";
+
+  WignerSymbols::TableWriterOptions options;
+  options.chunkBytes     = 1 << 12;
+  options.bufferedChunks = 2;
+
+  WignerSymbols::TableWriterStats stats = WignerSymbols::writeWigner3jTable(lmax,path,options);
+  if (!stats.ok || !stats.complete || stats.families != WignerSymbols::wigner3jFamilies(lmax).size()) failures++;
+  if (stats.chunks < 2) failures++;
+  failures += check(path,lmax);
+
+  // We interrupt the run twice, then resume it until the end.
+  options.maxFamilies = 500;
+  stats = WignerSymbols::writeWigner3jTable(lmax,resumed,options);
+  if (!stats.ok || stats.complete || stats.families != 500) failures++;
+
+  options.resume = true;
+  stats = WignerSymbols::writeWigner3jTable(lmax,resumed,options);
+  if (!stats.ok || stats.complete || stats.families != 500) failures++;
+
+  options.maxFamilies = 0;
+  stats = WignerSymbols::writeWigner3jTable(lmax,resumed,options);
+  if (!stats.ok || !stats.complete) failures++;
+  failures += check(resumed,lmax);
+
+  // Resuming a complete table does nothing.
+  stats = WignerSymbols::writeWigner3jTable(lmax,resumed,options);
+  if (!stats.ok || !stats.complete || stats.families != 0) failures++;
+
+  // A checkpoint that cannot be written stops the run at the first chunk,
+  // instead of after the whole table, which takes minutes at this lmax.
+  std::string blocked = "testTableWriterBlocked.bin";
+  mkdir((blocked+".checkpoint").c_str(),0700);
+  options.resume = false;
+  stats = WignerSymbols::writeWigner3jTable(150,blocked,options);
+  if (stats.ok || stats.error.empty() || stats.seconds > 5.0) failures++;
+  rmdir((blocked+".checkpoint").c_str());
+  std::remove(blocked.c_str());
+
+  std::remove(path.c_str());
+  std::remove((path+".checkpoint").c_str());
+  std::remove(resumed.c_str());
+  std::remove((resumed+".checkpoint").c_str());
+
+  if (failures > 0) std::cout << failures << " failures" << std::endl;
+  return failures > 0;
+}
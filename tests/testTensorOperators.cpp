@@ -0,0 +1,103 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html               -/
+ ********************************************************/
+
+/*! \file testTensorOperators.cpp
+ *  \author Joey Dumont <joey.dumont@gmail.com>
+ *  \since 2026-10-18
+ *  \brief Tests the recursion in m and the application of tensor operators.
+ *  \copyright LGPL
+ * The families in m2 must match the scalar 3j symbols, including large and
+ * half-integer momenta. A tensor operator applied to a random state must
+ * match the product with the dense matrix given by the Wigner-Eckart
+ * theorem, for any number of threads.
+ */
+
+#include <wignerSymbols.h>
+
+#include <complex>
+#include <random>
+
+int main()
+{
+  int failures = 0;
+
+  // Families in m2 against the scalar symbols.
+  double cases[][4] = {{3,5,4,1}, {2.5,3,1.5,-0.5}, {10,12,7,-3}, {1,0.5,0.5,0},
+                       {40,35,60,12}, {150,120,200,-70}, {0,7,7,0}};
+  for (int c=0;c<7;c++)
+  {
+    double l1 = cases[c][0], l2 = cases[c][1], l3 = cases[c][2], m1 = cases[c][3];
+    std::vector<double> thrcof = WignerSymbols::wigner3j_m(l1,l2,l3,m1);
+    double m2min = std::max(-l2,-l3-m1), m2max = std::min(l2,l3-m1);
+    if (thrcof.size() != (std::size_t)(m2max-m2min+1.5)) { failures++; continue; }
+
+    for (std::size_t i=0;i<thrcof.size();i++)
+    {
+      double m2 = m2min+i;
+      if (std::fabs(thrcof[i]-WignerSymbols::wigner3j(l1,l2,l3,m1,m2,-m1-m2)) > 1.0e-12) failures++;
+    }
+  }
+  if (!WignerSymbols::wigner3j_m(1,1,3,0).empty()) failures++;
+
+  // Operator of rank 2 on a basis with integer j, and of rank 1 on a basis
+  // with half-integer j.
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<double> uniform(-1.0,1.0);
+
+  double ranks[][2] = {{2,1}, {1,-1}};
+  std::vector<double> bases[] = {{0,1,2,3,4,2,7}, {0.5,1.5,2.5,1.5,5.5}};
+  for (int t=0;t<2;t++)
+  {
+    double k = ranks[t][0], q = ranks[t][1];
+    const std::vector<double>& j = bases[t];
+    std::size_t n = j.size();
+    std::vector<std::size_t> offsets = WignerSymbols::tensorBasisOffsets(j);
+    std::size_t dim = offsets[n];
+
+    std::vector<std::complex<double> > reduced(n*n), state(dim);
+    for (std::size_t i=0;i<n*n;i++) reduced[i] = std::complex<double>(uniform(gen),uniform(gen));
+    for (std::size_t i=0;i<dim;i++) state[i] = std::complex<double>(uniform(gen),uniform(gen));
+
+    // Dense product.
+    std::vector<std::complex<double> > expected(dim,0.0);
+    for (std::size_t r=0;r<n;r++)
+      for (std::size_t c=0;c<n;c++)
+        for (std::size_t a=0;a<offsets[r+1]-offsets[r];a++)
+          for (std::size_t b=0;b<offsets[c+1]-offsets[c];b++)
+          {
+            double mp = a-j[r], m = b-j[c];
+            double phase = ((long)(j[r]-mp+0.5)%2 ? -1.0 : 1.0);
+            double w = phase*WignerSymbols::wigner3j(j[r],k,j[c],-mp,q,m);
+            expected[offsets[r]+a] += w*reduced[r*n+c]*state[offsets[c]+b];
+          }
+
+    for (unsigned int nthreads=1;nthreads<=4;nthreads++)
+    {
+      std::vector<std::complex<double> > result = WignerSymbols::applyTensorOperator(k,q,j,reduced,state,nthreads);
+      if (result.size() != dim) { failures++; continue; }
+      for (std::size_t i=0;i<dim;i++)
+        if (std::abs(result[i]-expected[i]) > 1.0e-12) failures++;
+    }
+
+    // Real overload.
+    std::vector<double> realReduced(n*n), realState(dim);
+    for (std::size_t i=0;i<n*n;i++) realReduced[i] = reduced[i].real();
+    for (std::size_t i=0;i<dim;i++) realState[i] = state[i].real();
+    std::vector<double> realResult = WignerSymbols::applyTensorOperator(k,q,j,realReduced,realState);
+    std::vector<std::complex<double> > check = WignerSymbols::applyTensorOperator(k,q,j,
+        std::vector<std::complex<double> >(realReduced.begin(),realReduced.end()),
+        std::vector<std::complex<double> >(realState.begin(),realState.end()));
+    for (std::size_t i=0;i<dim;i++)
+      if (std::fabs(realResult[i]-check[i].real()) > 1.0e-14) failures++;
+  }
+
+  // Mismatched sizes.
+  if (!WignerSymbols::applyTensorOperator(1,0,std::vector<double>(2,1.0),std::vector<double>(3),std::vector<double>(6)).empty()) failures++;
+
+  if (failures > 0) std::cout << failures << " failures" << std::endl;
+  return failures > 0;
+}
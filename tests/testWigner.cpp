@@ -131,19 +131,12 @@ int main(int argc, char* argv[])
 // Sum_{m1,m2} (2*l3+1)*Wigner3j(l1,l2,l3,m1,m2,m3)*3j(l1,l2,l3',m1,m2,m3') = delta(l3,l3')*delta(m3,m3')
 double firstOrthoRelation3j(double l1, double l2, double l3, double m3)
 {
-	// We determine all possible values of m1 and m2.
-	int m1Size = ((int)(2.0*l1+1.0));
-	int m2Size = ((int)(2.0*l2+1.0)); 
-
+	// We visit the allowed values of m1 and m2 only.
 	double sum = 0.0;
-	for (int i=0;i<m1Size;i++)
+	WignerSymbols::forEachWigner3jM(l1,l2,l3,m3,[&](double, double, double value)
 	{
-		for (int j=0;j<m2Size;j++)
-		{
-			sum += (2.0*l3+1.0)*WignerSymbols::wigner3j_f(l1,l2,l3,((double)(-l1+i)),((double)(-l2+j)),m3)
-				*WignerSymbols::wigner3j_f(l1,l2,l3,((double)(-l1+i)),((double)(-l2+j)),m3);
-		}
-	}
+		sum += (2.0*l3+1.0)*value*value;
+	});
 
 	double diff = std::fabs(1.0-sum);
 
@@ -153,20 +146,12 @@ double firstOrthoRelation3j(double l1, double l2, double l3, double m3)
 // sum_{m1,m2} m2*(2*l3+1)c_wigner3j(l1,l2,l3,m1,m2,-m3)^2 = m3*(l3*(l3+1)+l2*(l2+1)-l1*(l1+1))/(2*l3*(l3+1))
 double sumOverM23j(double l1, double l2, double l3, double m3)
 {
+	// We visit the values of m1+m2 = m3, i.e. the projections of (l1 l2 l3; m1 m2 -m3).
 	double sum = 0.0;
-	// We sum over all allowable values of m1+m2+m3=0.
-	for (int i=0;i<(2*l1+1);i++)
+	WignerSymbols::forEachWigner3jM(l1,l2,l3,-m3,[&](double, double m2, double value)
 	{
-		double m1 = -l1+i;
-
-		for (int j=0;j<(2*l2+1);j++)
-		{
-			double m2 = -l2+j;
-
-			if (std::fabs(m1+m2-m3)<1.0e-6)
-				sum += m2*(2.0*l3+1.0)*pow(WignerSymbols::wigner3j(l1,l2,l3,m1,m2,-m3),2.0);
-		}
-	}
+		sum += m2*(2.0*l3+1.0)*value*value;
+	});
 
 	double value = m3*(l3*(l3+1.)+l2*(l2+1.)-l1*(l1+1.))/(2.*l3*(l3+1.));
 
@@ -0,0 +1,122 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html               -/
+ ********************************************************/
+
+/*! \file testWigner6jCache.cpp
+ *  \author Joey Dumont <joey.dumont@gmail.com>
+ *  \since 2026-10-18
+ *  \brief Tests the cache of 6j families.
+ *  \copyright LGPL
+ * The cached symbols must match wigner6j() in all 24 orientations, and all
+ * the orientations of a symbol must share one family. A small budget must
+ * be respected, and several threads must get the same values.
+ */
+
+#include <wignerSymbols.h>
+
+#include <thread>
+
+using namespace WignerSymbols;
+
+/*! The 24 orientations of {l[0] l[1] l[2]; l[3] l[4] l[5]}. */
+static std::vector<std::vector<double> > orientations(const double* l)
+{
+  static const int permutations[6][3] = {{0,1,2},{0,2,1},{1,0,2},{1,2,0},{2,0,1},{2,1,0}};
+  static const bool flips[4][3] = {{false,false,false},{true,true,false},{true,false,true},{false,true,true}};
+  std::vector<std::vector<double> > all;
+  for (int p=0;p<6;p++)
+    for (int f=0;f<4;f++)
+    {
+      std::vector<double> c(6);
+      for (int k=0;k<3;k++)
+      {
+        int column = permutations[p][k];
+        c[k]   = flips[f][k] ? l[column+3] : l[column];
+        c[k+3] = flips[f][k] ? l[column]   : l[column+3];
+      }
+      all.push_back(c);
+    }
+  return all;
+}
+
+int main()
+{
+  int failures = 0;
+
+  // Every orientation of a symbol, with integer and half-integer arguments,
+  // hits the family computed for the first one.
+  double symbols[][6] = {{3,4,5,6,5,4}, {2.5,3,1.5,2,3.5,2}, {10,7,8,9,11,6}, {0.5,0.5,1,0.5,0.5,0}};
+  for (int s=0;s<4;s++)
+  {
+    Wigner6jCache cache;
+    double expected = wigner6j(symbols[s][0],symbols[s][1],symbols[s][2],
+                               symbols[s][3],symbols[s][4],symbols[s][5]);
+    if (expected == 0.0) failures++;
+    std::vector<std::vector<double> > all = orientations(symbols[s]);
+    for (std::size_t o=0;o<all.size();o++)
+    {
+      const std::vector<double>& c = all[o];
+      double value = cache(c[0],c[1],c[2],c[3],c[4],c[5]);
+      if (std::fabs(value-expected) > 1.0e-13*std::max(1.0,std::fabs(expected))) failures++;
+    }
+    Wigner6jCacheStats stats = cache.stats();
+    if (stats.misses != 1 || stats.hits != 23 || stats.families != 1) failures++;
+  }
+
+  // All the symbols up to lmax, including those that vanish by the
+  // selection rules, with a budget that forces evictions.
+  Wigner6jCache small(1 << 16);
+  const int lmax = 6;
+  for (int l1=0;l1<=2*lmax;l1++)
+    for (int l2=0;l2<=2*lmax;l2++)
+      for (int l3=0;l3<=2*lmax;l3++)
+        for (int l4=0;l4<=lmax;l4++)
+          for (int l5=0;l5<=lmax;l5++)
+            for (int l6=0;l6<=lmax;l6++)
+            {
+              double expected = wigner6j(0.5*l1,0.5*l2,0.5*l3,l4,l5,l6);
+              double value = small(0.5*l1,0.5*l2,0.5*l3,l4,l5,l6);
+              if (std::fabs(value-expected) > 1.0e-13*std::max(1.0,std::fabs(expected))) failures++;
+            }
+  Wigner6jCacheStats stats = small.stats();
+  if (stats.bytes > stats.byteBudget || stats.evictions == 0 || stats.hits == 0) failures++;
+
+  // Values outside the selection rules vanish.
+  if (small(1,1,3,1,1,1) != 0.0 || small(1,1,1,1,1,0.5) != 0.0 || small(-1,1,1,1,1,1) != 0.0) failures++;
+
+  // Arguments whose doubled values would overflow the key are rejected
+  // before any lookup.
+  unsigned long long lookups = small.stats().hits + small.stats().misses;
+  double huge = 1.5*(1 << 30);
+  if (small(huge,huge,huge,huge,huge,huge) != 0.0 || small(1,1,1,1,1,familyLmaxLimit+1.0) != 0.0) failures++;
+  if (small.stats().hits + small.stats().misses != lookups) failures++;
+
+  small.clear();
+  stats = small.stats();
+  if (stats.families != 0 || stats.bytes != 0 || stats.hits != 0) failures++;
+
+  // Several threads sharing the process-wide cache.
+  std::vector<int> threadFailures(8,0);
+  std::vector<std::thread> threads;
+  for (int t=0;t<8;t++)
+    threads.push_back(std::thread([&,t]()
+    {
+      for (int l1=0;l1<=8;l1++)
+        for (int l4=0;l4<=8;l4++)
+          for (int l5=(t%4);l5<=8;l5++)
+          {
+            double expected = wigner6j(l1,5,6,l4,l5,7);
+            double value = wigner6j_cached(l4,l5,6,l1,5,7);
+            if (std::fabs(value-expected) > 1.0e-13*std::max(1.0,std::fabs(expected))) threadFailures[t]++;
+          }
+    }));
+  for (int t=0;t<8;t++) { threads[t].join(); failures += threadFailures[t]; }
+
+  stats = sharedWigner6jCache().stats();
+  std::cout << "6j cache: " << stats.families << " families, hit rate " << stats.hitRate() << ", "
+            << stats.contended << " contended lookups; " << failures << " mismatches." << std::endl;
+  return failures == 0 ? 0 : 1;
+}
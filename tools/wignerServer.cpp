@@ -0,0 +1,97 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html               -/
+ ********************************************************/
+
+/*! \file wignerServer.cpp
+ *  \author Joey Dumont <joey.dumont@gmail.com>
+ *  \since 2026-10-18
+ *  \brief Serves Wigner symbols to the local processes over a Unix socket.
+ *  \copyright LGPL
+ * Usage: wignerServer socket [--lmax lmax] [--cache families]
+ *        [--precompute-3j lmax] [--precompute-6j lmax]
+ *
+ * The server runs until it receives SIGINT or SIGTERM, and then reports
+ * its activity. SIGUSR1 reports it without stopping.
+ */
+
+#include <wignerSymbols.h>
+
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+
+#include <unistd.h>
+
+static volatile std::sig_atomic_t stopRequested = 0;
+static volatile std::sig_atomic_t reportRequested = 0;
+
+extern "C" void onSignal(int signal)
+{
+  if (signal == SIGUSR1) reportRequested = 1;
+  else stopRequested = 1;
+}
+
+static int usage(const char* name)
+{
+  std::cerr << "Usage: " << name << " socket [--lmax lmax] [--cache families]"
+            << " [--precompute-3j lmax] [--precompute-6j lmax]" << std::endl;
+  return 1;
+}
+
+static void report(const WignerSymbols::CoefficientServer& server)
+{
+  WignerSymbols::CoefficientServerStats stats = server.stats();
+  std::cout << "connections  " << stats.connections << std::endl
+            << "requests     " << stats.requests << std::endl
+            << "symbols      " << stats.symbols << std::endl
+            << "hits         " << stats.hits << std::endl
+            << "misses       " << stats.misses << std::endl
+            << "families     " << stats.families << " (" << stats.pinned << " precomputed)" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2) return usage(argv[0]);
+
+  WignerSymbols::CoefficientServerOptions options;
+  options.socketPath = argv[1];
+  for (int k=2;k<argc;k++)
+  {
+    if (k+1 >= argc) return usage(argv[0]);
+    if (std::strcmp(argv[k],"--lmax") == 0)               options.lmax = std::atoi(argv[++k]);
+    else if (std::strcmp(argv[k],"--cache") == 0)         options.cacheFamilies = std::strtoul(argv[++k],0,10);
+    else if (std::strcmp(argv[k],"--precompute-3j") == 0) options.precompute3j = std::atoi(argv[++k]);
+    else if (std::strcmp(argv[k],"--precompute-6j") == 0) options.precompute6j = std::atoi(argv[++k]);
+    else return usage(argv[0]);
+  }
+
+  std::signal(SIGINT,onSignal);
+  std::signal(SIGTERM,onSignal);
+  std::signal(SIGUSR1,onSignal);
+
+  WignerSymbols::CoefficientServer server(options);
+  std::string error;
+  if (!server.start(&error))
+  {
+    std::cerr << error << std::endl;
+    return 1;
+  }
+  std::cout << "listening on " << options.socketPath << std::endl;
+
+  while (!stopRequested)
+  {
+    usleep(100000);
+    if (reportRequested)
+    {
+      reportRequested = 0;
+      report(server);
+    }
+  }
+
+  server.stop();
+  report(server);
+  return 0;
+}
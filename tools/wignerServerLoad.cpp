@@ -0,0 +1,192 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html               -/
+ ********************************************************/
+
+/*! \file wignerServerLoad.cpp
+ *  \author Joey Dumont <joey.dumont@gmail.com>
+ *  \since 2026-10-18
+ *  \brief Measures the latency and throughput of a coefficient server.
+ *  \copyright LGPL
+ * Usage: wignerServerLoad socket [--clients n] [--requests n] [--batch n]
+ *        [--lmax n] [--kind 3j|6j|cg] [--spawn] [--verify]
+ *
+ * Each client thread opens its own connection and sends its requests one
+ * after the other, each with batch random symbols allowed by the selection
+ * rules. We report the percentiles of the latency of the requests, and the
+ * requests and symbols served per second. With --spawn, the server is
+ * started in this process; with --verify, every returned symbol is compared
+ * to its direct evaluation.
+ */
+
+#include <wignerSymbols.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <random>
+#include <thread>
+
+using namespace WignerSymbols;
+
+typedef std::chrono::steady_clock Clock;
+
+static int usage(const char* name)
+{
+  std::cerr << "Usage: " << name << " socket [--clients n] [--requests n] [--batch n]"
+            << " [--lmax n] [--kind 3j|6j|cg] [--spawn] [--verify]" << std::endl;
+  return 1;
+}
+
+/*! Appends the doubled arguments of a random symbol with integer momenta
+ * up to lmax that satisfies the selection rules. */
+static void randomSymbol(uint32_t kind, int lmax, std::mt19937& rng, std::vector<int32_t>& args)
+{
+  std::uniform_int_distribution<int> momentum(0,lmax);
+  for (;;)
+  {
+    int l2 = momentum(rng), l3 = momentum(rng);
+    if (kind == Wigner6jKind)
+    {
+      int l5 = momentum(rng), l6 = momentum(rng);
+      int lo1 = std::max(std::abs(l2-l3),std::abs(l5-l6)), hi1 = std::min(l2+l3,l5+l6);
+      int lo4 = std::max(std::abs(l2-l6),std::abs(l5-l3)), hi4 = std::min(l2+l6,l5+l3);
+      if (lo1 > hi1 || lo4 > hi4) continue;
+      int l1 = std::uniform_int_distribution<int>(lo1,hi1)(rng);
+      int l4 = std::uniform_int_distribution<int>(lo4,hi4)(rng);
+      int l[6] = {l1,l2,l3,l4,l5,l6};
+      for (int k=0;k<6;k++) args.push_back(2*l[k]);
+      return;
+    }
+
+    int m2 = std::uniform_int_distribution<int>(-l2,l2)(rng);
+    int m3 = std::uniform_int_distribution<int>(-l3,l3)(rng);
+    int lo = std::max(std::abs(l2-l3),std::abs(m2+m3));
+    int l1 = std::uniform_int_distribution<int>(lo,l2+l3)(rng);
+    // (l1 l2 l3; m1 m2 m3), or <l2 m2 l3 m3|l1 m2+m3>.
+    int a[6] = {l1,l2,l3,-m2-m3,m2,m3};
+    if (kind == ClebschGordanKind)
+    {
+      int b[6] = {l2,l3,l1,m2,m3,m2+m3};
+      std::copy(b,b+6,a);
+    }
+    for (int k=0;k<6;k++) args.push_back(2*a[k]);
+    return;
+  }
+}
+
+static double direct(uint32_t kind, const int32_t* j)
+{
+  double a[6];
+  for (int k=0;k<6;k++) a[k] = 0.5*j[k];
+  if (kind == Wigner3jKind) return wigner3j(a[0],a[1],a[2],a[3],a[4],a[5]);
+  if (kind == Wigner6jKind) return wigner6j(a[0],a[1],a[2],a[3],a[4],a[5]);
+  return clebschGordan(a[0],a[1],a[2],a[3],a[4],a[5]);
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2) return usage(argv[0]);
+
+  std::string path = argv[1];
+  int clients = 16, requests = 1000, batch = 64, lmax = 20;
+  uint32_t kind = Wigner3jKind;
+  bool spawn = false, verify = false;
+  for (int k=2;k<argc;k++)
+  {
+    if (std::strcmp(argv[k],"--spawn") == 0)  { spawn = true; continue; }
+    if (std::strcmp(argv[k],"--verify") == 0) { verify = true; continue; }
+    if (k+1 >= argc) return usage(argv[0]);
+    if (std::strcmp(argv[k],"--clients") == 0)       clients = std::atoi(argv[++k]);
+    else if (std::strcmp(argv[k],"--requests") == 0) requests = std::atoi(argv[++k]);
+    else if (std::strcmp(argv[k],"--batch") == 0)    batch = std::atoi(argv[++k]);
+    else if (std::strcmp(argv[k],"--lmax") == 0)     lmax = std::atoi(argv[++k]);
+    else if (std::strcmp(argv[k],"--kind") == 0)
+    {
+      std::string name = argv[++k];
+      if (name == "3j")      kind = Wigner3jKind;
+      else if (name == "6j") kind = Wigner6jKind;
+      else if (name == "cg") kind = ClebschGordanKind;
+      else return usage(argv[0]);
+    }
+    else return usage(argv[0]);
+  }
+  if (clients < 1 || requests < 1 || batch < 1 || lmax < 0) return usage(argv[0]);
+
+  CoefficientServerOptions options;
+  options.socketPath = path;
+  CoefficientServer server(options);
+  std::string error;
+  if (spawn && !server.start(&error))
+  {
+    std::cerr << error << std::endl;
+    return 1;
+  }
+
+  std::vector<std::vector<double> > latencies(clients);
+  std::atomic<int> failedClients(0);
+  std::atomic<unsigned long long> mismatches(0);
+
+  Clock::time_point start = Clock::now();
+  std::vector<std::thread> threads;
+  for (int c=0;c<clients;c++)
+    threads.push_back(std::thread([&,c]()
+    {
+      CoefficientClient client;
+      if (!client.connect(path)) { failedClients++; return; }
+
+      std::mt19937 rng(1234u+c);
+      std::vector<int32_t> args;
+      std::vector<double> values(batch);
+      latencies[c].reserve(requests);
+      for (int r=0;r<requests;r++)
+      {
+        args.clear();
+        for (int i=0;i<batch;i++) randomSymbol(kind,lmax,rng,args);
+
+        Clock::time_point t0 = Clock::now();
+        if (!client.evaluate(kind,args.data(),batch,values.data())) { failedClients++; return; }
+        latencies[c].push_back(std::chrono::duration<double,std::micro>(Clock::now()-t0).count());
+
+        if (verify)
+          for (int i=0;i<batch;i++)
+          {
+            double expected = direct(kind,&args[6*i]);
+            if (std::fabs(values[i]-expected) > 1.0e-12*std::max(1.0,std::fabs(expected))) mismatches++;
+          }
+      }
+    }));
+  for (auto& thread : threads) thread.join();
+  double seconds = std::chrono::duration<double>(Clock::now()-start).count();
+
+  std::vector<double> all;
+  for (int c=0;c<clients;c++) all.insert(all.end(),latencies[c].begin(),latencies[c].end());
+  std::sort(all.begin(),all.end());
+  auto percentile = [&all](double p) { return all.empty() ? 0.0 : all[std::min(all.size()-1,(std::size_t)(p*all.size()))]; };
+
+  std::cout << std::setprecision(4)
+            << "clients      " << clients << std::endl
+            << "requests     " << all.size() << " of " << batch << " symbols" << std::endl
+            << "latency p50  " << percentile(0.50) << " us" << std::endl
+            << "latency p90  " << percentile(0.90) << " us" << std::endl
+            << "latency p99  " << percentile(0.99) << " us" << std::endl
+            << "latency p999 " << percentile(0.999) << " us" << std::endl
+            << "latency max  " << (all.empty() ? 0.0 : all.back()) << " us" << std::endl
+            << "requests/s   " << all.size()/seconds << std::endl
+            << "symbols/s    " << all.size()*(double)batch/seconds << std::endl;
+  if (spawn)
+  {
+    CoefficientServerStats stats = server.stats();
+    std::cout << "cache        " << stats.hits << " hits, " << stats.misses << " misses, "
+              << stats.families << " families" << std::endl;
+  }
+  if (verify) std::cout << "mismatches   " << mismatches << std::endl;
+
+  if (failedClients > 0) std::cerr << failedClients << " clients failed" << std::endl;
+  return (failedClients == 0 && mismatches == 0) ? 0 : 1;
+}
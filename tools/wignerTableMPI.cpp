@@ -0,0 +1,117 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html               -/
+ ********************************************************/
+
+/*! \file wignerTableMPI.cpp
+ *  \author Joey Dumont <joey.dumont@gmail.com>
+ *  \since 2026-10-18
+ *  \brief Computes a table of 3j or 6j symbols with one shard per MPI rank.
+ *  \copyright LGPL
+ * Usage: mpirun -np n wignerTableMPI 3j|6j lmax output [--threads n]
+ *        [--merge] [--verify stride]
+ *
+ * Rank r writes the shard output.r. With --merge, rank 0 then merges the
+ * shards into output, and removes them. We report the time spent by the
+ * slowest rank and the imbalance between the ranks.
+ */
+
+#include <wignerSymbols.h>
+
+// Only the C interface is used. The deprecated C++ bindings do not build
+// with the warnings of the library.
+#define OMPI_SKIP_MPICXX
+#define MPICH_SKIP_MPICXX
+#include <mpi.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+
+typedef std::chrono::steady_clock Clock;
+
+static int usage(const char* name, int rank)
+{
+  if (rank == 0)
+    std::cerr << "Usage: " << name << " 3j|6j lmax output [--threads n] [--merge] [--verify stride]" << std::endl;
+  MPI_Finalize();
+  return 1;
+}
+
+int main(int argc, char* argv[])
+{
+  MPI_Init(&argc,&argv);
+  int rank, ranks;
+  MPI_Comm_rank(MPI_COMM_WORLD,&rank);
+  MPI_Comm_size(MPI_COMM_WORLD,&ranks);
+
+  if (argc < 4 || (std::strcmp(argv[1],"3j") != 0 && std::strcmp(argv[1],"6j") != 0)) return usage(argv[0],rank);
+
+  bool sixj = (std::strcmp(argv[1],"6j") == 0);
+  int lmax = std::atoi(argv[2]);
+  std::string output = argv[3];
+  unsigned int threads = 1;
+  bool merge = false;
+  unsigned long long stride = 0;
+  for (int k=4;k<argc;k++)
+  {
+    bool hasValue = (k+1 < argc);
+    if      (std::strcmp(argv[k],"--merge") == 0)              merge = true;
+    else if (std::strcmp(argv[k],"--threads") == 0 && hasValue) threads = std::atoi(argv[++k]);
+    else if (std::strcmp(argv[k],"--verify") == 0 && hasValue)  stride = std::strtoull(argv[++k],0,10);
+    else return usage(argv[0],rank);
+  }
+
+  // Each rank computes and writes its own shard.
+  Clock::time_point t0 = Clock::now();
+  WignerSymbols::TableShard shard = (sixj ? WignerSymbols::wigner6jShard(lmax,rank,ranks,threads)
+                                          : WignerSymbols::wigner3jShard(lmax,rank,ranks,threads));
+  double compute = std::chrono::duration<double>(Clock::now()-t0).count();
+
+  std::string path = output+"."+std::to_string(rank), error;
+  int ok = WignerSymbols::writeTableShard(path,shard,&error);
+  if (!ok) std::cerr << "rank " << rank << ": " << error << std::endl;
+
+  double times[2] = {compute, std::chrono::duration<double>(Clock::now()-t0).count()};
+  double slowest[2], total[2];
+  int allOk;
+  MPI_Reduce(times,slowest,2,MPI_DOUBLE,MPI_MAX,0,MPI_COMM_WORLD);
+  MPI_Reduce(times,total,2,MPI_DOUBLE,MPI_SUM,0,MPI_COMM_WORLD);
+  MPI_Allreduce(&ok,&allOk,1,MPI_INT,MPI_LAND,MPI_COMM_WORLD);
+
+  int status = (allOk ? 0 : 1);
+  if (rank == 0 && allOk)
+  {
+    std::cout << std::setprecision(4)
+              << "ranks        " << ranks << std::endl
+              << "families     " << shard.totalFamilies << std::endl
+              << "compute      " << slowest[0] << " s (imbalance " << slowest[0]/(total[0]/ranks) << ")" << std::endl
+              << "write        " << slowest[1]-slowest[0] << " s" << std::endl;
+
+    if (merge)
+    {
+      std::vector<std::string> shards;
+      for (int r=0;r<ranks;r++) shards.push_back(output+"."+std::to_string(r));
+
+      WignerSymbols::ShardMergeStats stats = WignerSymbols::mergeTableShards(shards,output,stride);
+      if (stats.ok)
+      {
+        std::cout << "merge        " << stats.seconds << " s" << std::endl
+                  << "verified     " << stats.verified << std::endl;
+        for (int r=0;r<ranks;r++) std::remove(shards[r].c_str());
+      }
+      else
+      {
+        std::cerr << stats.error << std::endl;
+        status = 1;
+      }
+    }
+  }
+
+  MPI_Finalize();
+  return status;
+}
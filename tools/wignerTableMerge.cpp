@@ -0,0 +1,61 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html               -/
+ ********************************************************/
+
+/*! \file wignerTableMerge.cpp
+ *  \author Joey Dumont <joey.dumont@gmail.com>
+ *  \since 2026-10-18
+ *  \brief Merges the shards of a table into a single file.
+ *  \copyright LGPL
+ * Usage: wignerTableMerge output shard... [--verify stride]
+ *
+ * The shards may be given in any order. With --verify, every stride-th
+ * family is recomputed and compared to the merged one.
+ */
+
+#include <wignerSymbols.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+
+static int usage(const char* name)
+{
+  std::cerr << "Usage: " << name << " output shard... [--verify stride]" << std::endl;
+  return 1;
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc < 3) return usage(argv[0]);
+
+  std::string output = argv[1];
+  std::vector<std::string> shards;
+  unsigned long long stride = 0;
+  for (int k=2;k<argc;k++)
+  {
+    if (std::strcmp(argv[k],"--verify") == 0)
+    {
+      if (k+1 >= argc) return usage(argv[0]);
+      stride = std::strtoull(argv[++k],0,10);
+    }
+    else shards.push_back(argv[k]);
+  }
+
+  WignerSymbols::ShardMergeStats stats = WignerSymbols::mergeTableShards(shards,output,stride);
+  if (!stats.ok)
+  {
+    std::cerr << stats.error << std::endl;
+    return 1;
+  }
+
+  std::cout << std::setprecision(4)
+            << "families     " << stats.families << std::endl
+            << "symbols      " << stats.values << std::endl
+            << "verified     " << stats.verified << std::endl
+            << "time         " << stats.seconds << " s" << std::endl;
+  return 0;
+}
@@ -0,0 +1,70 @@
+/*******************************************************-/
+ * This source code is subject to the terms of the GNU  -/
+ * Lesser Public License. If a copy of the LGPL was not -/
+ * distributed with this file, you can obtain one at    -/
+ * https://www.gnu.org/licenses/lgpl.html               -/
+ ********************************************************/
+
+/*! \file wignerTableWriter.cpp
+ *  \author Joey Dumont <joey.dumont@gmail.com>
+ *  \since 2026-10-18
+ *  \brief Writes the table of 3j symbols up to lmax to a file.
+ *  \copyright LGPL
+ * Usage: wignerTableWriter lmax output [--chunk-mb n] [--buffers n]
+ *        [--level n] [--max-families n] [--resume]
+ *
+ * We report the families written per second, the uncompressed and stored
+ * throughput, and the memory held by the chunk buffers.
+ */
+
+#include <wignerSymbols.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+
+static int usage(const char* name)
+{
+  std::cerr << "Usage: " << name << " lmax output [--chunk-mb n] [--buffers n]"
+            << " [--level n] [--max-families n] [--resume]" << std::endl;
+  return 1;
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc < 3) return usage(argv[0]);
+
+  int lmax = std::atoi(argv[1]);
+  std::string path = argv[2];
+  WignerSymbols::TableWriterOptions options;
+
+  for (int k=3;k<argc;k++)
+  {
+    bool hasValue = (k+1 < argc);
+    if      (std::strcmp(argv[k],"--resume") == 0)                   options.resume = true;
+    else if (std::strcmp(argv[k],"--chunk-mb") == 0 && hasValue)     options.chunkBytes = (std::size_t)(std::atof(argv[++k])*(1 << 20));
+    else if (std::strcmp(argv[k],"--buffers") == 0 && hasValue)      options.bufferedChunks = std::atoi(argv[++k]);
+    else if (std::strcmp(argv[k],"--level") == 0 && hasValue)        options.compressionLevel = std::atoi(argv[++k]);
+    else if (std::strcmp(argv[k],"--max-families") == 0 && hasValue) options.maxFamilies = std::strtoull(argv[++k],0,10);
+    else return usage(argv[0]);
+  }
+
+  WignerSymbols::TableWriterStats stats = WignerSymbols::writeWigner3jTable(lmax,path,options);
+  if (!stats.ok)
+  {
+    std::cerr << stats.error << std::endl;
+    return 1;
+  }
+
+  double mb = 1.0/(1 << 20);
+  std::cout << std::setprecision(4)
+            << "families     " << stats.families << " (" << stats.families/stats.seconds << " /s)" << std::endl
+            << "chunks       " << stats.chunks << std::endl
+            << "raw          " << stats.rawBytes*mb << " MB (" << stats.rawBytes*mb/stats.seconds << " MB/s)" << std::endl
+            << "stored       " << stats.storedBytes*mb << " MB (" << stats.storedBytes*mb/stats.seconds << " MB/s)" << std::endl
+            << "buffers      " << stats.bufferBytes*mb << " MB" << std::endl
+            << "time         " << stats.seconds << " s" << std::endl
+            << (stats.complete ? "complete" : "incomplete, resume with --resume") << std::endl;
+
+  return 0;
+}